@@ -3,6 +3,7 @@
 
 #include "Achilles/Achilles.hh"
 #include "Achilles/Histogram.hh"
+#include <algorithm>
 #include <set>
 #include <memory>
 
@@ -132,6 +133,15 @@ class Beam {
         std::shared_ptr<FluxType> at(const PID pid) const { return m_beams.at(pid); }
         std::shared_ptr<FluxType> operator[](const PID pid) const { return m_beams.at(pid); }
 
+        /// Replace the flux of an existing beam, e.g. to include initial state radiation
+        ///@param pid: The PID of the beam to replace
+        ///@param flux: The new flux for the beam
+        void SetFlux(const PID pid, std::shared_ptr<FluxType> flux) {
+            m_beams.at(pid) = std::move(flux);
+            n_vars = 0;
+            for(const auto &beam : m_beams) n_vars = std::max(n_vars, beam.second -> NVariables());
+        }
+
         friend YAML::convert<Beam>;
 
     private:
@@ -2,15 +2,23 @@
 #define CASCADE_HH
 
 #include <array>
+#include <map>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include "Achilles/Coalescence.hh"
+#include "Achilles/FormationZone.hh"
 #include "Achilles/SymplecticIntegrator.hh"
 #include "Achilles/ThreeVector.hh"
+#include "Achilles/Transport.hh"
 #include "Achilles/FourVector.hh"
 #include "Achilles/Random.hh"
 #include "Achilles/Interpolation.hh"
 #include "Achilles/Interactions.hh"
+#include "Achilles/ParticleInfo.hh"
 
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
@@ -26,6 +34,119 @@ class Event;
 using Particles = std::vector<Particle>;
 using InteractionDistances = std::vector<std::pair<std::size_t, double>>;
 
+/// Variance reduction settings for the cascade. The interaction probabilities can be scaled
+/// globally or per channel, and raised before the first interaction of the event to force
+/// it to happen more often. Each biased decision multiplies the weight of the event by the
+/// ratio of the analog to the biased probability, so that weighted distributions are unbiased.
+/// Histories with a small weight are terminated with Russian roulette.
+struct CascadeBiasing {
+    using Channel = std::pair<PID, PID>;
+
+    double scale{1};
+    std::map<Channel, double> channel_scales{};
+    double force_first{0};
+    double roulette{0};
+
+    // Largest biased probability allowed, unless the analog probability is larger
+    static constexpr double max_prob = 0.99;
+
+    bool Enabled() const {
+        return scale != 1 || !channel_scales.empty() || force_first > 0 || roulette > 0;
+    }
+
+    /// Get the scale factor for the interaction probability of a given pair of particles
+    double Scale(PID, PID) const;
+
+    /// Calculate the biased interaction probability
+    ///@param prob: The analog interaction probability
+    ///@param pid1, pid2: The particles of the interaction channel
+    ///@param first: If no interaction has occurred in the event yet
+    ///@return double: The probability to sample the interaction with
+    double Probability(double prob, PID, PID, bool first) const;
+
+    /// Decide whether a biased interaction occurs, updating the weight of the history
+    ///@return bool: True if the interaction occurs
+    bool Accept(double prob, PID, PID, bool first, double &weight) const;
+
+    /// Play Russian roulette on a history with a weight below the threshold
+    ///@param weight: The weight of the history, set to zero if it is terminated
+    ///@return bool: True if the history survives
+    bool Roulette(double &weight) const;
+};
+
+/// Limits on the evolution of a single event in the cascade, and the bookkeeping of the events
+/// that exceed them. An event is aborted if it takes too many steps, exceeds the wall time
+/// budget, produces a non-finite position or momentum, or violates energy conservation by more
+/// than the tolerance. The policy decides if aborted events are dropped (written with zero
+/// weight), retried with a new realization of the cascade, or flagged and kept without the
+/// final state interactions.
+struct CascadeWatchdog {
+    enum class Reason : int {
+        None = 0,
+        MaxSteps,
+        WallTime,
+        NaN,
+        EnergyViolation,
+    };
+    static constexpr size_t nreasons = 5;
+
+    enum class Policy {
+        Drop,
+        Retry,
+        Flag,
+    };
+
+    size_t max_steps{100000};
+    // Wall time budget in seconds and energy tolerance in MeV, where zero disables the check
+    double max_time{0}, energy_tolerance{0};
+    Policy policy{Policy::Drop};
+    size_t max_retries{3};
+    static constexpr size_t max_examples{5};
+
+    /// Record an aborted event
+    ///@param reason: The reason the event was aborted
+    ///@param event: The number of the event in the run
+    void Record(Reason, size_t);
+    size_t Count(Reason reason) const { return m_counts[static_cast<size_t>(reason)]; }
+    size_t Total() const;
+    const std::vector<size_t>& Examples(Reason reason) const { return m_examples[static_cast<size_t>(reason)]; }
+
+    static std::string Name(Reason);
+    static std::string Name(Policy);
+
+    private:
+        std::array<size_t, nreasons> m_counts{};
+        std::array<std::vector<size_t>, nreasons> m_examples{};
+};
+
+/// Exception thrown when the watchdog aborts the evolution of an event
+class CascadeAbort : public std::runtime_error {
+    public:
+        CascadeAbort(CascadeWatchdog::Reason reason, const std::string &msg)
+            : std::runtime_error(msg), m_reason{reason} {}
+        CascadeWatchdog::Reason Reason() const { return m_reason; }
+
+    private:
+        CascadeWatchdog::Reason m_reason;
+};
+
+/// Closest approach of two particles moving on straight lines with their momenta
+struct ClosestApproach {
+    /// Squared impact parameter in the center of mass frame of the pair in fm^2
+    double b2{};
+    /// Lab frame time until the first particle reaches the point of closest approach in fm
+    double time{};
+};
+
+/// Calculate the closest approach of two particles in the center of mass frame of the pair
+/// (see e.g. Kodama et al., Phys. Rev. C 29, 2146 (1984)). The impact parameter is Lorentz
+/// invariant, and the time of the collision is transformed back to the lab frame, so that
+/// collisions can be ordered in time independent of the time step of the cascade.
+///@param particle1: The first particle, to which the collision time refers
+///@param particle2: The second particle, at the same lab frame time
+///@return ClosestApproach: The impact parameter and the collision time
+ClosestApproach CovariantClosestApproach(const Particle&, const Particle&);
+
 /// The Cascade class performs a cascade of the nucleons inside the nucleus. The nucleons that
 /// are struck in the hard interaction propagate through the nuclear medium. To determine if an
 /// interaction occurs, we calculate the interaction cross-section of Np and Nn, where N is the
@@ -40,6 +161,12 @@ class Cascade {
             Cylinder
         };
 
+        // Collision Criterion Enums
+        enum CollisionCriterion {
+            Lab,
+            Covariant
+        };
+
         // In-Medium Effects Enums
         enum InMedium {
             None,
@@ -76,6 +203,12 @@ class Cascade {
         ///@return std::string: Name of the probability model
         std::string ProbabilityModel() const { return m_probability_name; }
 
+        /// Get the collision criterion used
+        ///@return std::string: Name of the collision criterion
+        std::string Criterion() const {
+            return m_criterion == CollisionCriterion::Covariant ? "Covariant" : "Lab";
+        }
+
         /// Get InMedium setting used
         ///@return std::string: InMedium setting
         std::string InMediumSetting() const {
@@ -102,6 +235,44 @@ class Cascade {
         ///@return double: default step size
         double StepSize() const { return distance; }
 
+        /// Get the symplectic integration scheme used for the propagation in the potential
+        ///@return SymplecticIntegrator::Scheme: The integration scheme
+        SymplecticIntegrator::Scheme IntegratorScheme() const { return m_integrator_scheme; }
+
+        /// Get the biasing settings
+        ///@return CascadeBiasing: The variance reduction settings
+        const CascadeBiasing& Biasing() const { return m_biasing; }
+
+        /// Get the watchdog limits and the record of the aborted events
+        ///@return CascadeWatchdog: The watchdog of the cascade
+        const CascadeWatchdog& Watchdog() const { return m_watchdog; }
+        CascadeWatchdog& Watchdog() { return m_watchdog; }
+
+        /// Get the formation zone model used
+        ///@return std::string: Name of the formation zone model
+        std::string FormationZoneModel() const { return m_formation -> GetName(); }
+
+        /// Get the settings of the parallel ensemble transport
+        ///@return TransportParams: The transport settings
+        const TransportParams& Transport() const { return m_transport; }
+
+        /// Get the coalescence of light clusters after the cascade
+        ///@return Coalescence*: The coalescence, or nullptr if it is disabled
+        const Coalescence* ClusterCoalescence() const { return m_coalescence.get(); }
+
+        /// Get the number of light clusters formed after the last cascade
+        ///@return size_t: The number of clusters
+        size_t NClusters() const { return m_nclusters; }
+
+        /// Get the number of interactions in the last cascade
+        ///@return size_t: The number of interactions that were not Pauli blocked. In the transport
+        ///                mode only the collisions of the particles of the event are counted
+        size_t NHits() const { return m_nhits; }
+
+        /// Get the weight correction from the biasing of the last cascade
+        ///@return double: The ratio of the analog to the biased probability of the history
+        double BiasWeight() const { return m_bias_weight; }
+
         /// @name Functions
         ///@{
 
@@ -120,10 +291,68 @@ class Cascade {
         ///@param idx: The index of the particle that has been kicked
         void SetKicked(const std::size_t& idx) { kickedIdxs.push_back(idx); }
 
+        /// Enable variance reduction in the cascade. The weight correction is applied to the
+        /// event weight when evolving an event
+        ///@param biasing: The variance reduction settings
+        void SetBiasing(CascadeBiasing biasing) { m_biasing = std::move(biasing); }
+
+        /// Set the limits on the evolution of a single event
+        ///@param watchdog: The watchdog settings
+        void SetWatchdog(CascadeWatchdog watchdog) { m_watchdog = std::move(watchdog); }
+
+        /// Set the criterion used to decide if two particles can collide. The Lab criterion
+        /// uses the transverse distance in the lab frame for the nucleons passed within a time
+        /// step. The Covariant criterion uses the impact parameter in the center of mass frame
+        /// of the pair, and treats the collisions in the order of their lab frame time, with the
+        /// particles propagated to the collision point
+        ///@param criterion: The collision criterion
+        void SetCriterion(CollisionCriterion criterion) { m_criterion = criterion; }
+
+        /// Set the model for the formation of the hadrons leaving a collision. Hadrons in their
+        /// formation zone interact with the fraction of the cross section given by the model,
+        /// and are not tested for interactions at all if the fraction vanishes
+        ///@param formation: The formation zone model
+        void SetFormationZone(std::unique_ptr<FormationZone> formation) { m_formation = std::move(formation); }
+
+        /// Start the formation of a hadron kicked to test the cascade with the formation zone model
+        ///@param particle: The hadron, with its momentum after the interaction
+        ///@param initial: The momentum of the hadron before the interaction
+        void FormHadron(Particle &particle, const FourVector &initial) const { m_formation -> Form(particle, initial); }
+
+        /// Start the formation of a hadron leaving the hard scattering with the formation zone model
+        ///@param particle: The hadron, with its momentum after the hard scattering
+        ///@param initial: The momentum of the initial state hadron
+        void FormPrimary(Particle &particle, const FourVector &initial) const {
+            m_formation -> FormPrimary(particle, initial);
+        }
+
+        /// Enable the parallel ensemble transport. The event is evolved together with copies
+        /// that share the propagating particles, but each have a new configuration of the
+        /// spectator nucleons. All test particles move in the mean field of the density
+        /// averaged over the copies, and only collide with the particles of their own copy, so
+        /// that the collisions conserve momentum within each copy. The particles of the
+        /// original copy form the final state
+        ///@param transport: The transport settings
+        void SetTransport(TransportParams transport);
+
+        /// Enable the coalescence of light clusters at the end of the cascade. Nucleons close
+        /// in phase space leaving the nucleus, and optionally spectators near the surface,
+        /// are replaced by deuterons, tritons, helium-3 and alpha particles
+        ///@param params: The coalescence settings
+        void SetCoalescence(CoalescenceParams params) {
+            m_coalescence = std::make_unique<Coalescence>(std::move(params));
+        }
+
+        /// Set the symplectic integration scheme used for the propagation in the potential.
+        /// Higher order schemes allow for a larger step size at the same energy conservation
+        ///@param scheme: The integration scheme
+        void SetIntegratorScheme(SymplecticIntegrator::Scheme scheme) { m_integrator_scheme = scheme; }
+
         /// Simulate the cascade until all particles either escape, are recaptured, or are in
-        /// the background.
+        /// the background. The nucleus is left untouched if the watchdog aborts the evolution
         ///@param nucleus: The nucleus to evolve
-        ///@param maxSteps: The maximum steps to take in the cascade
+        ///@param maxSteps: The maximum steps to take in the cascade, limited by the watchdog
+        ///@throws CascadeAbort: If any of the watchdog limits is exceeded
         void Evolve(std::shared_ptr<Nucleus>, const std::size_t& maxSteps = cMaxSteps);
 
         /// Simulate the cascade on an event until all particles either escape,
@@ -159,15 +388,26 @@ class Cascade {
         bool BetweenPlanes(const ThreeVector&, const ThreeVector&, const ThreeVector&) const noexcept;
         const ThreeVector Project(const ThreeVector&, const ThreeVector&, const ThreeVector&) const noexcept;
         const InteractionDistances AllowedInteractions(Particles&, const std::size_t&) const noexcept;
+        std::vector<std::pair<std::size_t, ClosestApproach>> CovariantInteractions(const Particles&,
+                const std::size_t&, double, double, std::size_t) const;
+        void CovariantStep(Particles&, std::size_t, std::vector<std::size_t>&);
         double GetXSec(const Particle&, const Particle&) const;
+        double FormationSuppression(const Particle&) const;
+        bool FormationBlocked(const Particle&) const;
         std::size_t Interacted(const Particles&, const Particle&,
                 const InteractionDistances&) noexcept;
         void Escaped(Particles&);
+        void RussianRoulette(Particles&);
         bool FinalizeMomentum(Particle&, Particle&) noexcept;
         bool PauliBlocking(const Particle&) const noexcept;
         void AddIntegrator(size_t, const Particle&);
         void Propagate(size_t, Particle*, double);
         void UpdateIntegrator(size_t, Particle*);
+        void AddEnsembles(Particles&);
+        void MeanFieldStep(Particles&);
+        bool SameEnsemble(std::size_t i, std::size_t j) const {
+            return m_nensembles == 1 || i/m_ensemble_size == j/m_ensemble_size;
+        }
 
         // Variables
         std::vector<std::size_t> kickedIdxs;
@@ -176,9 +416,21 @@ class Cascade {
         std::function<double(double, double)> probability;
         std::shared_ptr<Nucleus> localNucleus;
         InMedium m_medium;
+        CollisionCriterion m_criterion{CollisionCriterion::Lab};
         bool m_potential_prop;
         std::map<size_t, SymplecticIntegrator> integrators;
+        SymplecticIntegrator::Scheme m_integrator_scheme{SymplecticIntegrator::Scheme::Order2};
         std::string m_probability_name;
+        CascadeBiasing m_biasing{};
+        CascadeWatchdog m_watchdog{};
+        double m_bias_weight{1};
+        std::size_t m_nhits{};
+        std::unique_ptr<FormationZone> m_formation{std::make_unique<DefaultFormationZone>(YAML::Node())};
+        TransportParams m_transport{};
+        DensityLattice m_lattice{};
+        std::size_t m_nensembles{1}, m_ensemble_size{};
+        std::unique_ptr<Coalescence> m_coalescence{};
+        std::size_t m_nclusters{};
 };
 
 }
@@ -193,10 +445,73 @@ struct convert<achilles::Cascade> {
         auto potentialProp = node["PotentialProp"].as<bool>();
         auto distance = node["Step"].as<double>();
         cascade = achilles::Cascade(std::move(interaction), probType, mediumType, potentialProp, distance);
+        if(node["Biasing"])
+            cascade.SetBiasing(node["Biasing"].as<achilles::CascadeBiasing>());
+        if(node["Integrator"])
+            cascade.SetIntegratorScheme(node["Integrator"].as<achilles::SymplecticIntegrator::Scheme>());
+        if(node["Watchdog"])
+            cascade.SetWatchdog(node["Watchdog"].as<achilles::CascadeWatchdog>());
+        if(node["Criterion"])
+            cascade.SetCriterion(node["Criterion"].as<achilles::Cascade::CollisionCriterion>());
+        if(node["Transport"])
+            cascade.SetTransport(node["Transport"].as<achilles::TransportParams>());
+        if(node["Coalescence"])
+            cascade.SetCoalescence(node["Coalescence"].as<achilles::CoalescenceParams>());
+        if(node["FormationZone"]) {
+            const auto name = node["FormationZone"]["Name"].as<std::string>();
+            if(!achilles::FormationZoneFactory::IsRegistered(name))
+                throw std::runtime_error(fmt::format("Cascade: Unknown formation zone model {}", name));
+            cascade.SetFormationZone(achilles::FormationZoneFactory::Initialize(name, node["FormationZone"]));
+        }
+        return true;
+    }
+};
+
+template<>
+struct convert<achilles::CascadeWatchdog> {
+    static bool decode(const Node &node, achilles::CascadeWatchdog &watchdog) {
+        if(node["MaxSteps"]) watchdog.max_steps = node["MaxSteps"].as<size_t>();
+        if(node["MaxTime"]) watchdog.max_time = node["MaxTime"].as<double>();
+        if(node["EnergyTolerance"]) watchdog.energy_tolerance = node["EnergyTolerance"].as<double>();
+        if(node["MaxRetries"]) watchdog.max_retries = node["MaxRetries"].as<size_t>();
+        if(node["Policy"]) {
+            const auto policy = node["Policy"].as<std::string>();
+            if(policy == "Drop")
+                watchdog.policy = achilles::CascadeWatchdog::Policy::Drop;
+            else if(policy == "Retry")
+                watchdog.policy = achilles::CascadeWatchdog::Policy::Retry;
+            else if(policy == "Flag")
+                watchdog.policy = achilles::CascadeWatchdog::Policy::Flag;
+            else
+                return false;
+        }
         return true;
     }
 };
 
+template<>
+struct convert<achilles::CascadeBiasing> {
+    static bool decode(const Node &node, achilles::CascadeBiasing &biasing) {
+        if(node["Scale"]) biasing.scale = node["Scale"].as<double>();
+        if(node["Channels"]) {
+            for(const auto &channel : node["Channels"]) {
+                auto pids = channel["Particles"].as<std::vector<achilles::PID>>();
+                if(pids.size() != 2) return false;
+                if(pids[1] < pids[0]) std::swap(pids[0], pids[1]);
+                biasing.channel_scales[{pids[0], pids[1]}] = channel["Scale"].as<double>();
+            }
+        }
+        if(node["ForceFirst"]) biasing.force_first = node["ForceFirst"].as<double>();
+        if(node["RouletteThreshold"]) biasing.roulette = node["RouletteThreshold"].as<double>();
+
+        if(biasing.scale <= 0) return false;
+        for(const auto &channel : biasing.channel_scales)
+            if(channel.second <= 0) return false;
+        return biasing.force_first >= 0 && biasing.force_first < 1
+            && biasing.roulette >= 0 && biasing.roulette < 1;
+    }
+};
+
 template<>
 struct convert<achilles::Cascade::ProbabilityType> {
     static bool decode(const Node &node, achilles::Cascade::ProbabilityType &type) {
@@ -212,6 +527,19 @@ struct convert<achilles::Cascade::ProbabilityType> {
     }
 };
 
+template<>
+struct convert<achilles::Cascade::CollisionCriterion> {
+    static bool decode(const Node &node, achilles::Cascade::CollisionCriterion &type) {
+        if(node.as<std::string>() == "Lab")
+            type = achilles::Cascade::CollisionCriterion::Lab;
+        else if(node.as<std::string>() == "Covariant")
+            type = achilles::Cascade::CollisionCriterion::Covariant;
+        else
+            return false;
+        return true;
+    }
+};
+
 template<>
 struct convert<achilles::Cascade::InMedium> {
     static bool decode(const Node &node, achilles::Cascade::InMedium &type) {
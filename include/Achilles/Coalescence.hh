@@ -0,0 +1,95 @@
+#ifndef COALESCENCE_HH
+#define COALESCENCE_HH
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Achilles/ParticleInfo.hh"
+#include "Achilles/ThreeVector.hh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "yaml-cpp/yaml.h"
+#pragma GCC diagnostic pop
+
+namespace achilles {
+
+class Particle;
+using Particles = std::vector<Particle>;
+
+/// Settings of the coalescence of light clusters at the end of the cascade. Nucleons join a
+/// cluster if they are within Radius fm of its centroid, and their momentum in the rest frame
+/// of the cluster they form is below Momentum MeV. The clusters are formed from the nucleons leaving the
+/// nucleus, and from the spectator nucleons within Surface fm of the nuclear radius. Every cluster
+/// contains at least one nucleon leaving the nucleus
+struct CoalescenceParams {
+    double radius{radius_default}, momentum{momentum_default}, surface{};
+    std::size_t max_size{max_size_default};
+
+    static constexpr double radius_default{3.5}, momentum_default{300};
+    static constexpr std::size_t max_size_default{4};
+};
+
+/// Phase space coalescence of deuterons, tritons, helium-3 and alpha particles. The clusters are
+/// grown nucleon by nucleon from a seed, through the bound species only (a proton-neutron pair,
+/// then tritons or helium-3, then alphas), adding the closest nucleon in phase space at each
+/// stage. The neighbours are looked up in a spatial hash with cells of the coalescence radius,
+/// so only the 27 cells around the cluster are searched
+class Coalescence {
+    public:
+        Coalescence() = default;
+        Coalescence(CoalescenceParams);
+
+        const CoalescenceParams& Params() const { return m_params; }
+
+        /// Replace the nucleons that coalesce by the clusters. The momentum of a cluster is the
+        /// sum of the momenta of its nucleons, and it is put on its mass shell. The difference
+        /// of the energies, the binding and the internal kinetic energy of the cluster, is left
+        /// to the nuclear remnant. Spectator nucleons that join a cluster leave the remnant
+        ///@param particles: The particles of the nucleus after the cascade
+        ///@param radius: The radius of the nucleus in fm
+        ///@return size_t: The number of clusters formed
+        std::size_t Form(Particles&, double) const;
+
+        /// The cluster with the given number of protons and neutrons
+        ///@return PID: The cluster, or undefined if it is not a bound light nucleus
+        static PID Cluster(std::size_t, std::size_t);
+
+    private:
+        using Cell = std::array<int64_t, 3>;
+        struct CellHash {
+            std::size_t operator()(const Cell &cell) const noexcept {
+                return static_cast<std::size_t>((cell[0]*73856093) ^ (cell[1]*19349663) ^ (cell[2]*83492791));
+            }
+        };
+        using Grid = std::unordered_map<Cell, std::vector<std::size_t>, CellHash>;
+
+        Cell Locate(const ThreeVector&) const;
+        std::vector<std::size_t> Grow(const Particles&, const Grid&, std::size_t,
+                                      const std::vector<bool>&) const;
+
+        CoalescenceParams m_params{};
+};
+
+}
+
+namespace YAML {
+
+template<>
+struct convert<achilles::CoalescenceParams> {
+    static bool decode(const Node &node, achilles::CoalescenceParams &rhs) {
+        if(node["Radius"]) rhs.radius = node["Radius"].as<double>();
+        if(node["Momentum"]) rhs.momentum = node["Momentum"].as<double>();
+        if(node["Surface"]) rhs.surface = node["Surface"].as<double>();
+        if(node["MaxSize"]) rhs.max_size = node["MaxSize"].as<std::size_t>();
+
+        return rhs.radius > 0 && rhs.momentum > 0 && rhs.surface >= 0
+            && rhs.max_size >= 2 && rhs.max_size <= 4;
+    }
+};
+
+}
+
+#endif
@@ -13,10 +13,12 @@ namespace Constant {
     constexpr double HBARC = HBAR*C;
     constexpr double HBARC2 = HBARC*HBARC*10; // mb MeV^2
     constexpr double NAVOGADRO = 6.02214076e23; // mol^-1 
+    constexpr double ALPHA0 = 1.0/137.035999084; // Fine structure constant at Q^2 = 0
     // constexpr double HBARC = 197.3269804_fm * 1_MeV;
     // constexpr double HBARC2 = 0.3893793721_mb * 1_GeV * 1_GeV;
 
     // Masses
+    constexpr double me = 0.51099895_MeV;
     constexpr double mp = 938.27208816_MeV;
     constexpr double mn = 939.56542054_MeV;
     constexpr double mN = (mp + mn) / 2.0;
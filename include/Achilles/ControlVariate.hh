@@ -0,0 +1,67 @@
+#ifndef CONTROLVARIATE_HH
+#define CONTROLVARIATE_HH
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace achilles {
+
+/// Function with a known integral that approximates the integrand, used to reduce the variance
+/// of the integration. The function is evaluated with the same point and phase space weight as
+/// the integrand, i.e. it returns the approximate integrand multiplied by the weight
+template<typename T>
+struct ControlVariate {
+    std::string name;
+    std::function<double(const std::vector<T>&, const double&)> function;
+    double integral{};
+};
+
+/// Regression estimator of an integral using control variates. The means and co-moments of the
+/// integrand values f and the control variate values g are accumulated as the points are added,
+/// and the coefficients c minimizing the variance of f - c.(g - G) are obtained from them. The
+/// estimate of the integral is the mean of these residuals, which is unbiased up to corrections
+/// of order 1/N. The points can be split into blocks, such as the replicas of a quasi-random
+/// point set, to estimate the error from the spread of the block means
+class ControlVariateEstimator {
+    public:
+        ControlVariateEstimator() = default;
+        ControlVariateEstimator(std::vector<double>);
+
+        size_t NVariates() const { return m_integrals.size(); }
+        size_t NPoints() const { return m_npoints; }
+        size_t NBlocks() const { return m_block_npoints.size(); }
+
+        /// Add a point of the integration to the current block
+        ///@param value: The value of the integrand
+        ///@param controls: The values of the control variates at the same point
+        void Add(double, const std::vector<double>&);
+
+        /// Start a new block of points
+        void NewBlock();
+
+        /// Determine the optimal coefficients from the points added so far
+        void Solve();
+        const std::vector<double>& Coefficients() const { return m_coefficients; }
+
+        /// The mean of the residuals f - c.(g - G)
+        double Mean() const;
+        /// The error of the mean from the variance of the residuals of independent points
+        double Error() const;
+        /// The error of the mean from the spread of the mean residuals of the blocks
+        double BlockError() const;
+
+    private:
+        double Residual(double, const double*) const;
+
+        std::vector<double> m_integrals, m_coefficients;
+        size_t m_npoints{};
+        double m_fmean{}, m_ff{};
+        std::vector<double> m_gmean, m_gg, m_gf;
+        std::vector<size_t> m_block_npoints;
+        std::vector<double> m_block_f, m_block_g;
+};
+
+}
+
+#endif
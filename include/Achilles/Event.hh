@@ -49,6 +49,7 @@ class Event {
         void Finalize();
 
         MOCK const NuclearRemnant &Remnant() const { return m_remnant; }
+        void SetRemnant(const NuclearRemnant &remnant) { m_remnant = remnant; }
 
         MOCK const vMomentum &Momentum() const { return m_mom; }
         MOCK vMomentum &Momentum() { return m_mom; }
@@ -77,6 +78,28 @@ class Event {
         MOCK const double& Weight() const { return m_wgt; }
         MOCK double& Weight() { return m_wgt; }
         void SetMEWeight(double wgt) { m_meWgt = wgt; }
+
+        /// Weight correction from biasing the event generation, already included in the event weight
+        const double& BiasWeight() const { return m_biasWgt; }
+        double& BiasWeight() { return m_biasWgt; }
+
+        /// Reason the cascade of the event was aborted, if the event is kept and flagged by
+        /// the cascade watchdog. Zero for events with a complete cascade
+        int CascadeFlag() const { return m_cascadeFlag; }
+        int& CascadeFlag() { return m_cascadeFlag; }
+
+        /// Set the realization of the final state interactions of an oversampled event
+        ///@param primary: The number of the hard scattering event shared by all realizations
+        ///@param realization: The index of the realization of the cascade
+        ///@param nrealizations: The number of realizations for the hard scattering event
+        void SetRealization(size_t primary, size_t realization, size_t nrealizations) {
+            m_primary = primary;
+            m_realization = realization;
+            m_nrealizations = nrealizations;
+        }
+        size_t PrimaryID() const { return m_primary; }
+        size_t Realization() const { return m_realization; }
+        size_t NRealizations() const { return m_nrealizations; }
         void Rotate(const std::array<double,9>&);
 
         bool operator==(const Event &other) const {
@@ -98,7 +121,9 @@ class Event {
         NuclearRemnant m_remnant{};
         vMomentum m_mom{};
         std::vector<double> m_me;
-        double m_vWgt{}, m_meWgt{}, m_wgt{-1};
+        double m_vWgt{}, m_meWgt{}, m_wgt{-1}, m_biasWgt{1};
+        int m_cascadeFlag{};
+        size_t m_primary{}, m_realization{}, m_nrealizations{1};
         vParticles m_leptons{};
         vParticles m_history{};
         double flux;
@@ -4,7 +4,9 @@
 #include "Achilles/CombinedCuts.hh"
 #include "Achilles/Histogram.hh"
 #include "Achilles/ParticleInfo.hh"
+#include "Achilles/PhaseSpaceBias.hh"
 #include "Achilles/QuasielasticTestMapper.hh"
+#include "Achilles/RadiativeCorrections.hh"
 #include "Achilles/Vegas.hh"
 #include "Achilles/MultiChannel.hh"
 #include "Achilles/Unweighter.hh"
@@ -33,14 +35,22 @@ class SherpaMEs;
 class EventGen {
     public:
         EventGen(const std::string&, std::vector<std::string>);
+        EventGen(YAML::Node, std::vector<std::string>, std::shared_ptr<EventWriter> = nullptr);
         void Initialize();
         void GenerateEvents();
+        void GenerateEvents(size_t);
+
+        const Unweighter* GetUnweighter() const { return unweighter.get(); }
 
     private:
         bool runCascade{false}, outputEvents{false}, doHardCuts{false};
-        bool doRotate{false};
+        bool doRotate{false}, saveResults{true};
+        size_t nevents{}, eventNumber{}, oversample{1};
         double GenerateEvent(const std::vector<FourVector>&, const double&);
+        double GenerateRealizations(Event&);
+        bool EvolveCascade(Event&);
         bool MakeCuts(Event&);
+        void WriteEvent(const Event&);
         // bool MakeEventCuts(Event&);
         void Rotate(Event&);
 
@@ -53,9 +63,19 @@ class EventGen {
         MultiChannel integrator;
         Integrand<FourVector> integrand;
         YAML::Node config;
+        // Estimate of the integral from all generated batches
+        StatsData generatedResults{};
 
         std::shared_ptr<EventWriter> writer;
         std::unique_ptr<Unweighter> unweighter;
+
+        // Phase space biasing, and the integral estimated with the bias removed
+        PhaseSpaceBias bias{};
+        double eventBias{1};
+        StatsData unbiasedResults{};
+
+        // QED corrections for electron scattering
+        RadiativeCorrections radiative{};
 };
 
 }
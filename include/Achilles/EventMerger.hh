@@ -0,0 +1,94 @@
+#ifndef EVENT_MERGER_HH
+#define EVENT_MERGER_HH
+
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace achilles {
+
+/// Summary of a single event sample, as needed to combine it with other samples
+struct SampleSummary {
+    std::string filename{};
+    double xsec{}, error{};
+    size_t trials{}, nevents{};
+    double max_weight{};
+};
+
+/// Base class for merging event samples from independent runs. All samples must have been
+/// generated with the same setup, so that they estimate the same cross section. The cross
+/// sections are combined by weighting each sample with its number of trials, which is
+/// equivalent to treating all trials as a single run. Optionally, the events are unweighted
+/// again to the largest maximum weight of all samples, so that the merged sample has a single
+/// event weight. The files are processed event by event and never loaded into memory. The
+/// realizations of an oversampled primary event are a single trial, and are unweighted together.
+class EventMerger {
+    public:
+        EventMerger(std::vector<std::string> inputs, bool reunweight=true);
+        EventMerger(const EventMerger&) = delete;
+        EventMerger& operator=(const EventMerger&) = delete;
+        virtual ~EventMerger() = default;
+
+        /// Scan all the input files to obtain their summaries
+        void Initialize();
+
+        /// Write all the events into a single output file
+        ///@param output: The name of the output file
+        void Merge(const std::string &output);
+
+        const std::vector<SampleSummary>& Summaries() const { return m_summaries; }
+        const SampleSummary& Combined() const { return m_combined; }
+
+        /// Combine the summaries of independent samples
+        ///@param summaries: The summaries of each sample
+        ///@return SampleSummary: The summary of the combined sample
+        static SampleSummary Combine(const std::vector<SampleSummary>&);
+
+        /// Unweight an event again to a new maximum weight
+        ///@param wgt: The weight of the event
+        ///@param max_wgt: The new maximum weight
+        ///@return double: The new weight of the event, which is zero if it is rejected
+        static double Reunweight(double wgt, double max_wgt);
+
+    protected:
+        /// The new weights of the realizations of a primary event. The primary event is unweighted
+        /// as a whole, and its new weight is shared in proportion to the weights of the realizations
+        ///@param wgts: The weights of the realizations
+        ///@return std::vector<double>: The new weights, which are zero if the event is rejected
+        std::vector<double> NewWeights(std::vector<double>) const;
+
+    private:
+        virtual SampleSummary Scan(const std::string&) const = 0;
+        virtual void Open(const std::string&) = 0;
+        virtual void Copy(const SampleSummary&) = 0;
+        virtual void Close() = 0;
+
+        std::vector<std::string> m_inputs;
+        bool m_reunweight;
+        std::vector<SampleSummary> m_summaries{};
+        SampleSummary m_combined{};
+};
+
+/// Merge samples written in the Achilles event format. Every trial is written to this format,
+/// including the ones with zero weight, so the summary is obtained from the events directly.
+/// The realizations of a primary event follow each other, starting with realization 1.
+class AchillesMerger : public EventMerger {
+    public:
+        using EventMerger::EventMerger;
+
+    private:
+        SampleSummary Scan(const std::string&) const override;
+        void Open(const std::string&) override;
+        void Copy(const SampleSummary&) override;
+        void Close() override;
+
+        static std::unique_ptr<std::istream> OpenInput(const std::string&);
+
+        std::unique_ptr<std::ostream> m_out{};
+        size_t m_nevents{}, m_nprimaries{};
+};
+
+}
+
+#endif
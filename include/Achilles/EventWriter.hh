@@ -6,6 +6,8 @@
 #include <string>
 #include <vector>
 
+#include "Achilles/OutputFilter.hh"
+
 #if GZIP
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wshadow"
@@ -28,6 +30,13 @@ class EventWriter {
 
         virtual void WriteHeader(const std::string&) = 0;
         virtual void Write(const Event&) = 0;
+
+        /// Restrict the particles written out for each event
+        void SetFilter(OutputFilter filter) { m_filter = std::move(filter); }
+        const OutputFilter& Filter() const { return m_filter; }
+
+    private:
+        OutputFilter m_filter{};
 };
 
 class AchillesWriter : public EventWriter {
@@ -64,6 +73,48 @@ class AchillesWriter : public EventWriter {
         std::ostream *m_out; 
 };
 
+/// Flattened particle information stored by the BufferWriter
+struct BufferedParticle {
+    size_t event;
+    long int pid;
+    int status;
+    double E, px, py, pz;
+    double x, y, z;
+};
+
+/// Flattened event information stored by the BufferWriter
+struct BufferedEvent {
+    double weight, flux;
+    size_t nparticles;
+    long int remnant_pid;
+};
+
+/// The BufferWriter keeps events in memory instead of writing them to disk. The events are
+/// flattened into plain structures, so that they can be handed off to other languages
+/// (i.e. as NumPy structured arrays) without any additional conversion. Events with
+/// zero weight are only counted as trials.
+class BufferWriter : public EventWriter {
+    public:
+        BufferWriter() = default;
+
+        void WriteHeader(const std::string&) override {}
+        void Write(const Event&) override;
+
+        const std::vector<BufferedEvent>& Events() const { return m_events; }
+        const std::vector<BufferedParticle>& Particles() const { return m_particles; }
+        size_t Trials() const { return m_trials; }
+        void Clear() {
+            m_events.clear();
+            m_particles.clear();
+            m_trials = 0;
+        }
+
+    private:
+        std::vector<BufferedEvent> m_events;
+        std::vector<BufferedParticle> m_particles;
+        size_t m_trials{};
+};
+
 }
 
 #endif
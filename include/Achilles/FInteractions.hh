@@ -2,14 +2,13 @@
 #define FINTERACTIONS_HH
 
 #include "Achilles/Interactions.hh"
+#include "Achilles/FTypes.hh"
 
 extern "C" {
-    using namespace achilles;
-
     // Procedures implemented in Fortran to interface with Interactions
     void InitializeInteraction(const char*);
-    double CrossSectionFortran(const Particle *part1, const Particle *part2);
-    ThreeVector* MakeMomentumFortran(bool, const double, const double[2]);
+    double CrossSectionFortran(const FParticle *part1, const FParticle *part2);
+    void MakeMomentumFortran(bool, const double, const double[2], FThreeVector*);
 }
 
 namespace achilles {
@@ -18,10 +17,7 @@ class FortranInteraction : public Interactions {
     public:
         FortranInteraction(const YAML::Node &node) {
             auto name = node["Name"].as<std::string>();
-            size_t len = name.size();
-            auto cname = std::unique_ptr<char>(new char[len]);
-            strcpy(cname.get(), name.c_str());
-            InitializeInteraction(cname.get());
+            InitializeInteraction(name.c_str());
         };
 
         static std::unique_ptr<Interactions> Create(const YAML::Node &data) {
@@ -32,11 +28,15 @@ class FortranInteraction : public Interactions {
         std::string Name() const override { return FortranInteraction::GetName(); }
         static bool IsRegistered() noexcept { return registered; }
         double CrossSection(const Particle &part1, const Particle &part2) const override {
-            return CrossSectionFortran(&part1, &part2);
+            const FParticle fpart1 = ToFortran(part1);
+            const FParticle fpart2 = ToFortran(part2);
+            return CrossSectionFortran(&fpart1, &fpart2);
         }
         ThreeVector MakeMomentum(bool samePID, const double &pcm,
                                  const std::array<double, 2> &rans) const override {
-            return {*MakeMomentumFortran(samePID, pcm, rans.data())};
+            FThreeVector mom{};
+            MakeMomentumFortran(samePID, pcm, rans.data(), &mom);
+            return FromFortran(mom);
         }
 
     private:
@@ -0,0 +1,64 @@
+#ifndef FTYPES_HH
+#define FTYPES_HH
+
+#include <type_traits>
+
+#include "Achilles/FourVector.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/ThreeVector.hh"
+
+// Plain-data types shared with Fortran. The layouts must match the bind(C)
+// types defined in src/Achilles/fortran/interop_mod.f90. These are passed by
+// reference or returned through caller-provided storage, so crossing the
+// language boundary never requires a heap allocation.
+extern "C" {
+
+struct FThreeVector {
+    double x, y, z;
+};
+
+struct FFourVector {
+    double e, px, py, pz;
+};
+
+struct FParticle {
+    long int pid;
+    long int status;
+    FFourVector momentum;
+    FThreeVector position;
+};
+
+}
+
+static_assert(std::is_standard_layout_v<FThreeVector> && std::is_trivial_v<FThreeVector>);
+static_assert(std::is_standard_layout_v<FFourVector> && std::is_trivial_v<FFourVector>);
+static_assert(std::is_standard_layout_v<FParticle> && std::is_trivial_v<FParticle>);
+static_assert(sizeof(FThreeVector) == 3*sizeof(double));
+static_assert(sizeof(FFourVector) == 4*sizeof(double));
+
+namespace achilles {
+
+inline FThreeVector ToFortran(const ThreeVector &vec) noexcept {
+    return {vec.Px(), vec.Py(), vec.Pz()};
+}
+
+inline FFourVector ToFortran(const FourVector &vec) noexcept {
+    return {vec.E(), vec.Px(), vec.Py(), vec.Pz()};
+}
+
+inline FParticle ToFortran(const Particle &part) noexcept {
+    return {part.ID().AsInt(), static_cast<long int>(part.Status()),
+            ToFortran(part.Momentum()), ToFortran(part.Position())};
+}
+
+inline ThreeVector FromFortran(const FThreeVector &vec) noexcept {
+    return {vec.x, vec.y, vec.z};
+}
+
+inline FourVector FromFortran(const FFourVector &vec) noexcept {
+    return {vec.e, vec.px, vec.py, vec.pz};
+}
+
+}
+
+#endif
@@ -53,8 +53,37 @@ class TwoBodyMapper : public FinalStateMapper,
 
     private:
         const double s2, s3;
-        static constexpr double dCos = 2;
-        static constexpr double dPhi = 2*M_PI;
+};
+
+/// Two body final state of a lepton and a hadronic system of variable invariant mass W, as
+/// needed for inelastic scattering. The first mass is the minimum of W^2
+class InelasticMapper : public FinalStateMapper,
+                               RegistrablePS<FinalStateMapper, InelasticMapper, std::vector<double>> {
+    public:
+        InelasticMapper(const std::vector<double> &m) : FinalStateMapper(2), s2{m[0]}, s3{m[1]} {}
+        static std::string Name() { return "Inelastic"; }
+        static std::unique_ptr<FinalStateMapper> Construct(const std::vector<double> &m) {
+            if(m.size() != 2) {
+                auto msg = fmt::format("Incorrect number of masses. Expected 2. Got {}", m.size());
+                throw std::runtime_error(msg);
+            }
+            return std::make_unique<InelasticMapper>(m);
+        }
+
+        void GeneratePoint(std::vector<FourVector>&, const std::vector<double>&) override;
+        double GenerateWeight(const std::vector<FourVector>&, std::vector<double>&) override;
+        size_t NDims() const override { return 3; }
+        YAML::Node ToYAML() const override {
+            YAML::Node result;
+            result["Name"] = Name();
+            result["Masses"] = std::vector<double>{s2, s3};
+            return result;
+        }
+
+    private:
+        std::pair<double, double> MassRange(const std::vector<FourVector>&) const;
+
+        const double s2, s3;
 };
 
 #ifdef ENABLE_BSM
@@ -0,0 +1,64 @@
+#ifndef FLOW_MAPPER_HH
+#define FLOW_MAPPER_HH
+
+#include "Achilles/Mapper.hh"
+#include "Achilles/NormalizingFlow.hh"
+
+namespace achilles {
+
+/// Mapper that places a trainable normalizing flow in front of another mapper. The random
+/// numbers are transformed by the flow before being passed to the wrapped mapping, allowing
+/// the channel to learn correlations between the dimensions of the phase space.
+template<typename T>
+class FlowMapper : public Mapper<T> {
+    public:
+        FlowMapper(std::unique_ptr<Mapper<T>> mapping, FlowParams params={})
+            : m_mapping{std::move(mapping)}, m_flow(m_mapping -> NDims(), std::move(params)) {}
+
+        void GeneratePoint(std::vector<T> &point, const std::vector<double> &rans) override {
+            m_flow.Forward(rans, m_rans);
+            m_mapping -> GeneratePoint(point, m_rans);
+            Mapper<T>::Print(__PRETTY_FUNCTION__, point, rans);
+        }
+        double GenerateWeight(const std::vector<T> &point, std::vector<double> &rans) override {
+            m_rans.resize(NDims());
+            const double wgt = m_mapping -> GenerateWeight(point, m_rans);
+            m_density = m_flow.Inverse(m_rans, rans);
+            Mapper<T>::Print(__PRETTY_FUNCTION__, point, rans);
+            return wgt*m_density;
+        }
+        size_t NDims() const override { return m_mapping -> NDims(); }
+        void SetMasses(std::vector<double> masses) override { m_mapping -> SetMasses(std::move(masses)); }
+        const std::vector<double>& Masses() const override { return m_mapping -> Masses(); }
+
+        // The flow is trained on the point from the last call to GenerateWeight
+        void AddTrainData(double val2) override {
+            m_flow.AddTrainData(m_rans, m_density, val2);
+            m_mapping -> AddTrainData(val2);
+        }
+        void Train() override {
+            m_flow.Train();
+            m_mapping -> Train();
+        }
+
+        const NormalizingFlow& Flow() const { return m_flow; }
+        NormalizingFlow& Flow() { return m_flow; }
+
+        YAML::Node ToYAML() const override {
+            YAML::Node result;
+            result["Name"] = "FlowMapper";
+            result["Mapper"] = m_mapping -> ToYAML();
+            result["Flow"] = m_flow;
+            return result;
+        }
+
+    private:
+        std::unique_ptr<Mapper<T>> m_mapping;
+        NormalizingFlow m_flow;
+        std::vector<double> m_rans;
+        double m_density{1};
+};
+
+}
+
+#endif
@@ -0,0 +1,226 @@
+#ifndef FOAM_HH
+#define FOAM_HH
+
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "yaml-cpp/yaml.h"
+#pragma GCC diagnostic pop
+
+namespace achilles {
+
+enum class FoamObjective {
+    Variance,
+    MaxWeight,
+};
+
+struct FoamParams {
+    size_t max_cells{max_cells_default}, splits{splits_default}, nbins{nbins_default};
+    double efficiency{efficiency_default}, mixing{mixing_default};
+    FoamObjective objective{FoamObjective::MaxWeight};
+
+    static constexpr size_t max_cells_default{500}, splits_default{20}, nbins_default{8};
+    static constexpr double efficiency_default{1}, mixing_default{0.1};
+};
+
+/// Cell of the foam, a box on the unit hypercube with its share of the points
+struct FoamCell {
+    std::vector<double> lower, upper;
+    double probability{}, integral{}, moment{}, max_value{};
+
+    double Volume() const;
+    /// Maximum weight of the points in the cell, relative to the integral over the unit hypercube
+    double MaxWeight() const { return max_value*Volume()/probability; }
+};
+
+/// Adaptive cellular sampler of the unit hypercube, following the FOAM algorithm
+/// (S. Jadach, Comput. Phys. Commun. 152, 55 (2003)). The hypercube is divided into boxes by
+/// recursive binary splits, and points are distributed uniformly within each box with a
+/// trainable probability per box. Unlike the factorized grid of Vegas, the boxes can follow
+/// peaks that are not aligned with the axes. During the training, the box and split that most
+/// reduce either the variance of the weights or the sum of the maximum weights of the boxes
+/// are chosen from histograms of the points inside each box, so that the maximum weight, and
+/// with it the unweighting efficiency, can be targeted directly. The box is selected with the
+/// first coordinate of the point, which is then rescaled to the box, so that the map keeps the
+/// dimension of the hypercube.
+class Foam {
+    public:
+        Foam() = default;
+        Foam(size_t, FoamParams={});
+
+        // Utilities
+        size_t NDims() const { return ndims; }
+        size_t NCells() const { return cells.size(); }
+        const FoamCell& Cell(size_t idx) const { return cells[idx]; }
+        FoamParams Parameters() const { return params; }
+        FoamParams &Parameters() { return params; }
+
+        /// Map uniform random numbers to a point in the foam
+        ///@param rans: The random numbers, which are replaced by the point
+        ///@return double: The jacobian of the map, i.e. the inverse of the density
+        double operator()(std::vector<double>&) const;
+
+        /// The inverse of the density of the foam at a given point
+        ///@param point: The point in the unit hypercube
+        ///@return double: The jacobian of the map at the point
+        double GenerateWeight(const std::vector<double>&) const;
+
+        /// The index of the cell containing the point
+        size_t FindCell(const std::vector<double>&) const;
+
+        /// Store a point sampled from the foam to be used in the next training step
+        ///@param point: The point in the unit hypercube
+        ///@param val2: The squared weight of the integrand at the point
+        void AddTrainData(const std::vector<double>&, double);
+
+        /// Split the cells and update their probabilities using the stored points
+        void Adapt();
+
+        /// The unweighting efficiency expected from the estimates of the cells
+        double Efficiency() const;
+
+        // YAML interface
+        friend YAML::convert<achilles::Foam>;
+
+    private:
+        static constexpr size_t leaf = std::numeric_limits<size_t>::max();
+        struct Node {
+            size_t dim{}, left{leaf}, right{leaf}, cell{};
+            double position{};
+        };
+        struct TrainData {
+            size_t npoints{};
+            double integral{}, moment{}, max_value{};
+            std::vector<double> bin_integral, bin_moment, bin_max;
+        };
+        struct SplitCandidate {
+            size_t cell{}, dim{}, bin{};
+            double gain{};
+        };
+
+        double Objective(double, double, double) const;
+        SplitCandidate BestSplit(size_t) const;
+        void Split(const SplitCandidate&, double);
+        void UpdateProbabilities();
+        void BuildCDF();
+        void ResetTrain();
+
+        size_t ndims{};
+        FoamParams params{};
+        std::vector<FoamCell> cells;
+        std::vector<Node> nodes;
+        std::vector<size_t> cell_nodes;
+        std::vector<double> cdf;
+        std::vector<TrainData> train;
+};
+
+}
+
+namespace YAML {
+
+template<>
+struct convert<achilles::FoamParams> {
+    static Node encode(const achilles::FoamParams &rhs) {
+        Node node;
+
+        node["MaxCells"] = rhs.max_cells;
+        node["Splits"] = rhs.splits;
+        node["NBins"] = rhs.nbins;
+        node["Efficiency"] = rhs.efficiency;
+        node["Mixing"] = rhs.mixing;
+        node["Objective"] = rhs.objective == achilles::FoamObjective::Variance ? "Variance" : "MaxWeight";
+
+        return node;
+    }
+
+    static bool decode(const Node &node, achilles::FoamParams &rhs) {
+        if(node["MaxCells"]) rhs.max_cells = node["MaxCells"].as<size_t>();
+        if(node["Splits"]) rhs.splits = node["Splits"].as<size_t>();
+        if(node["NBins"]) rhs.nbins = node["NBins"].as<size_t>();
+        if(node["Efficiency"]) rhs.efficiency = node["Efficiency"].as<double>();
+        if(node["Mixing"]) rhs.mixing = node["Mixing"].as<double>();
+        if(node["Objective"]) {
+            const auto objective = node["Objective"].as<std::string>();
+            if(objective == "Variance") rhs.objective = achilles::FoamObjective::Variance;
+            else if(objective == "MaxWeight") rhs.objective = achilles::FoamObjective::MaxWeight;
+            else return false;
+        }
+
+        return rhs.max_cells > 0 && rhs.nbins > 1 && rhs.mixing > 0 && rhs.mixing <= 1;
+    }
+};
+
+template<>
+struct convert<achilles::Foam> {
+    static Node encode(const achilles::Foam &rhs) {
+        Node node;
+        node["NDims"] = rhs.ndims;
+        node["Parameters"] = rhs.params;
+        for(const auto &tree_node : rhs.nodes) {
+            Node tree;
+            if(tree_node.left == achilles::Foam::leaf) {
+                const auto &cell = rhs.cells[tree_node.cell];
+                tree["Probability"] = cell.probability;
+                tree["Integral"] = cell.integral;
+                tree["Moment"] = cell.moment;
+                tree["MaxValue"] = cell.max_value;
+            } else {
+                tree["Dim"] = tree_node.dim;
+                tree["Position"] = tree_node.position;
+                tree["Children"] = std::vector<size_t>{tree_node.left, tree_node.right};
+            }
+            node["Nodes"].push_back(tree);
+        }
+        return node;
+    }
+
+    // The cells are rebuilt by walking the tree, which is stored with parents before children
+    static bool decode(const Node &node, achilles::Foam &rhs) {
+        if(node.size() != 3) return false;
+
+        rhs = achilles::Foam(node["NDims"].as<size_t>(), node["Parameters"].as<achilles::FoamParams>());
+        const auto tree = node["Nodes"];
+        rhs.nodes.resize(tree.size());
+        rhs.cells.clear();
+        rhs.cell_nodes.clear();
+        std::vector<achilles::FoamCell> boxes(tree.size());
+        boxes[0] = {std::vector<double>(rhs.ndims, 0), std::vector<double>(rhs.ndims, 1)};
+        for(size_t i = 0; i < tree.size(); ++i) {
+            auto &tree_node = rhs.nodes[i];
+            if(tree[i]["Children"]) {
+                const auto children = tree[i]["Children"].as<std::vector<size_t>>();
+                if(children.size() != 2 || children[0] <= i || children[1] <= i
+                   || children[0] >= tree.size() || children[1] >= tree.size()) return false;
+                tree_node.dim = tree[i]["Dim"].as<size_t>();
+                tree_node.position = tree[i]["Position"].as<double>();
+                tree_node.left = children[0];
+                tree_node.right = children[1];
+                if(tree_node.dim >= rhs.ndims) return false;
+                boxes[tree_node.left] = boxes[i];
+                boxes[tree_node.left].upper[tree_node.dim] = tree_node.position;
+                boxes[tree_node.right] = boxes[i];
+                boxes[tree_node.right].lower[tree_node.dim] = tree_node.position;
+            } else {
+                auto cell = boxes[i];
+                cell.probability = tree[i]["Probability"].as<double>();
+                cell.integral = tree[i]["Integral"].as<double>();
+                cell.moment = tree[i]["Moment"].as<double>();
+                cell.max_value = tree[i]["MaxValue"].as<double>();
+                tree_node.cell = rhs.cells.size();
+                rhs.cells.push_back(cell);
+                rhs.cell_nodes.push_back(i);
+            }
+        }
+        rhs.BuildCDF();
+        rhs.ResetTrain();
+        return true;
+    }
+};
+
+}
+
+#endif
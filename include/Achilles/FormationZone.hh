@@ -0,0 +1,113 @@
+#ifndef FORMATION_ZONE_HH
+#define FORMATION_ZONE_HH
+
+#include "Achilles/Factory.hh"
+#include "Achilles/FourVector.hh"
+
+#include <memory>
+#include <string>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "yaml-cpp/yaml.h"
+#pragma GCC diagnostic pop
+
+namespace achilles {
+
+class Particle;
+
+/// Model of the formation of a hadron after a hard scattering or a collision in the cascade.
+/// The model sets the formation time of the hadron in the lab frame, and the fraction of the
+/// free cross section with which it interacts while it is still forming. Models are registered
+/// by name and selected with the FormationZone sub-section of the cascade
+class FormationZone {
+    public:
+        FormationZone() = default;
+        virtual ~FormationZone() = default;
+        static std::string Name() { return "Formation Zone Models"; }
+
+        /// Start the formation of a hadron
+        ///@param particle: The hadron, with its momentum after the interaction
+        ///@param initial: The momentum of the hadron before the interaction
+        virtual void Form(Particle&, const FourVector&) const = 0;
+
+        /// Start the formation of a hadron leaving the hard scattering. By default the same as Form
+        ///@param particle: The hadron, with its momentum after the hard scattering
+        ///@param initial: The momentum of the initial state hadron
+        virtual void FormPrimary(Particle &particle, const FourVector &initial) const { Form(particle, initial); }
+
+        /// The fraction of the free cross section for a hadron in its formation zone
+        ///@param particle: The hadron in its formation zone
+        ///@return double: The suppression factor between 0 and 1
+        virtual double Suppression(const Particle&) const { return 0; }
+
+        virtual std::string GetName() const = 0;
+};
+
+template<typename Derived>
+using RegistrableFormationZone = Registrable<FormationZone, Derived, const YAML::Node&>;
+using FormationZoneFactory = Factory<FormationZone, const YAML::Node&>;
+
+/// The formation time t = E/|m^2 - p.q| of Particle::SetFormationZone, without any interactions
+/// during the formation. This is the model used if none is given. The hadrons leaving the hard
+/// scattering are not formed by this model, and start interacting immediately
+class DefaultFormationZone : public FormationZone, RegistrableFormationZone<DefaultFormationZone> {
+    public:
+        DefaultFormationZone(const YAML::Node&) {}
+        void Form(Particle&, const FourVector&) const override;
+        void FormPrimary(Particle&, const FourVector&) const override {}
+
+        // Required factory methods
+        static std::unique_ptr<FormationZone> Construct(const YAML::Node &node) {
+            return std::make_unique<DefaultFormationZone>(node);
+        }
+        static std::string Name() { return "Default"; }
+        std::string GetName() const override { return Name(); }
+};
+
+/// A constant formation time Tau (in fm) in the rest frame of the hadron, dilated to the lab
+/// frame, with a constant fraction Suppression (default 0) of the cross section during the formation
+class ConstantFormationZone : public FormationZone, RegistrableFormationZone<ConstantFormationZone> {
+    public:
+        ConstantFormationZone(const YAML::Node&);
+        void Form(Particle&, const FourVector&) const override;
+        double Suppression(const Particle&) const override { return m_suppression; }
+
+        // Required factory methods
+        static std::unique_ptr<FormationZone> Construct(const YAML::Node &node) {
+            return std::make_unique<ConstantFormationZone>(node);
+        }
+        static std::string Name() { return "Constant"; }
+        std::string GetName() const override { return Name(); }
+
+    private:
+        double m_tau, m_suppression{};
+};
+
+/// Quantum diffusion model of color transparency (G. R. Farrar, H. Liu, L. L. Frankfurt and
+/// M. I. Strikman, Phys. Rev. Lett. 61, 686 (1988)). The hadron is produced as a small
+/// configuration with a cross section reduced by n^2 <k_t^2>/Q^2, where Q^2 is the virtuality
+/// of the momentum transfer, and grows linearly to the free cross section over the formation
+/// length 2p/Delta m^2. The parameters are the number of constituents (NQuarks, default 3), the
+/// mean squared transverse momentum (KT2, default 0.35^2 GeV^2) and the mass difference of the
+/// intermediate states (DeltaM2, default 0.7 GeV^2), with the dimensionful values in MeV^2
+class QuantumDiffusion : public FormationZone, RegistrableFormationZone<QuantumDiffusion> {
+    public:
+        QuantumDiffusion(const YAML::Node&);
+        void Form(Particle&, const FourVector&) const override;
+        double Suppression(const Particle&) const override;
+
+        // Required factory methods
+        static std::unique_ptr<FormationZone> Construct(const YAML::Node &node) {
+            return std::make_unique<QuantumDiffusion>(node);
+        }
+        static std::string Name() { return "QuantumDiffusion"; }
+        std::string GetName() const override { return Name(); }
+
+    private:
+        double m_nquarks{3}, m_kt2{350*350}, m_deltam2{0.7e6};
+};
+
+}
+
+#endif
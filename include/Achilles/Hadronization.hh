@@ -0,0 +1,54 @@
+#ifndef HADRONIZATION_HH
+#define HADRONIZATION_HH
+
+#include <vector>
+
+#include "Achilles/FourVector.hh"
+#include "Achilles/ThreeVector.hh"
+
+#include "yaml-cpp/node/node.h"
+
+namespace achilles {
+
+class Particle;
+
+/// Simple hadronization of the hadronic system produced in inelastic scattering into a
+/// nucleon and pions. The number of pions is one plus a Poisson distributed number with an
+/// average multiplicity of a + b ln(W^2/GeV^2) - 1, limited by the available energy. The charges
+/// are assigned randomly subject to charge conservation, and the momenta are distributed
+/// according to the n-body phase space of the hadronic system.
+class Hadronization {
+    public:
+        Hadronization(double a=0.4, double b=1.4);
+        Hadronization(const YAML::Node&);
+
+        /// Average number of pions produced
+        ///@param W: The invariant mass of the hadronic system in MeV
+        ///@return double: The average pion multiplicity, at least one
+        double AverageMultiplicity(double) const;
+
+        /// The lowest invariant mass that can be hadronized for any charge, a nucleon and a
+        /// charged pion
+        ///@return double: The threshold in MeV
+        static double Threshold();
+
+        /// Hadronize a hadronic system
+        ///@param momentum: The momentum of the hadronic system
+        ///@param charge: The charge of the hadronic system
+        ///@param position: The position of the produced hadrons
+        ///@return std::vector<Particle>: The nucleon followed by the pions, all propagating
+        std::vector<Particle> operator()(const FourVector&, int, const ThreeVector&) const;
+
+        /// Distribute the momentum of a system over particles according to the n-body phase space
+        ///@param momentum: The momentum of the decaying system
+        ///@param masses: The masses of the decay products
+        ///@return std::vector<FourVector>: The momenta of the decay products
+        static std::vector<FourVector> PhaseSpaceDecay(const FourVector&, const std::vector<double>&);
+
+    private:
+        double m_a, m_b;
+};
+
+}
+
+#endif
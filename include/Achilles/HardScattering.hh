@@ -2,6 +2,8 @@
 #define HARD_SCATTERING_HH
 
 #include "Achilles/Spinor.hh"
+#include <array>
+#include <map>
 #include <utility>
 #include <complex>
 #include <vector>
@@ -32,6 +34,8 @@ class NuclearModel;
 using Particles = std::vector<Particle>;
 using Current = std::vector<std::vector<std::complex<double>>>;
 using Currents = std::map<int, Current>;
+using Tensor = std::array<std::complex<double>, 16>;
+using Tensors = std::map<int, Tensor>;
 using FFDictionary = std::map<std::pair<PID, PID>, std::vector<FormFactorInfo>>;
 
 class LeptonicCurrent {
@@ -40,6 +44,9 @@ class LeptonicCurrent {
         void Initialize(const Process_Info&);
         FFDictionary GetFormFactor();
         Currents CalcCurrents(const std::vector<FourVector>&, const double&) const;
+        /// Spin summed leptonic tensor L^{\mu\nu} = \sum J^\mu J^{\nu*}, evaluated
+        /// analytically from the trace instead of the spinors
+        Tensors CalcTensors(const std::vector<FourVector>&, const double&) const;
 
     private:
         bool NeutralCurrent(PID, PID) const;
@@ -61,6 +68,11 @@ class HardScattering {
 
         // Calculation details
         std::vector<double> CrossSection(Event&) const;
+        std::vector<double> AmplitudeCrossSection(Event&) const;
+        std::vector<double> TensorCrossSection(Event&) const;
+        /// The tensor contraction is used for Standard Model currents if the nuclear model
+        /// provides hadronic tensors, otherwise the amplitudes are squared for each spin
+        bool UseTensors() const;
 
         // Select initial state
         bool FillEvent(Event&, const std::vector<double>&) const;
@@ -80,6 +92,9 @@ class HardScattering {
     private:
         Currents LeptonicCurrents(const std::vector<FourVector>&,
                                   const double&) const;
+        const std::vector<std::map<int, std::vector<FormFactorInfo>>>&
+        FFInfo(const std::vector<int>&) const;
+        double Normalization(const Event&) const;
         FFDictionary SMFormFactor;
 
 #ifdef ENABLE_BSM
@@ -1,6 +1,8 @@
 #ifndef INTEGRAND_HH
 #define INTEGRAND_HH
 
+#include "Achilles/ControlVariate.hh"
+#include "Achilles/Foam.hh"
 #include "Achilles/Mapper.hh"
 #include "Achilles/PhaseSpaceBuilder.hh"
 #include "Achilles/Beams.hh"
@@ -11,8 +13,12 @@ namespace achilles {
 template<typename T>
 struct Channel {
     Vegas integrator;
+    // Optional cellular sampler used instead of the Vegas grid
+    std::unique_ptr<Foam> foam;
     std::unique_ptr<Mapper<T>> mapping;
     double weight{};
+    // Density of the channel at the last point given to Integrand::GenerateWeight
+    double density{};
     std::vector<double> train_data;
     std::vector<double> rans;
 
@@ -30,6 +36,29 @@ class Integrand {
         Func<T> Function() const { return m_func; }
         Func<T> &Function() { return m_func; }
 
+        // Control variate utilities. The densities of the channels can be used as control
+        // variates, each of which integrates to one. They are evaluated at the last point given
+        // to GenerateWeight
+        void AddControlVariate(ControlVariate<T> control) { controls.push_back(std::move(control)); }
+        const std::vector<ControlVariate<T>>& ControlVariates() const { return controls; }
+        void SetChannelControlVariates(bool enabled) { m_channel_controls = enabled; }
+        bool ChannelControlVariates() const { return m_channel_controls; }
+        size_t NControlVariates() const { return controls.size() + (m_channel_controls ? NChannels() : 0); }
+        std::vector<double> ControlVariateIntegrals() const {
+            std::vector<double> integrals;
+            for(const auto &control : controls) integrals.push_back(control.integral);
+            if(m_channel_controls) integrals.resize(NControlVariates(), 1.0);
+            return integrals;
+        }
+        void EvaluateControlVariates(const std::vector<T> &point, double wgt, std::vector<double> &values) const {
+            values.resize(NControlVariates());
+            for(size_t i = 0; i < controls.size(); ++i)
+                values[i] = wgt == 0 ? 0 : controls[i].function(point, wgt);
+            if(!m_channel_controls) return;
+            for(size_t i = 0; i < NChannels(); ++i)
+                values[controls.size() + i] = channels[i].density*wgt;
+        }
+
         // Channel Utilities
         void AddChannel(Channel<T> channel) { 
             if(channels.size() != 0)
@@ -48,17 +77,28 @@ class Integrand {
         // Train integrator
         void InitializeTrain() {
             for(auto &channel : channels) {
+                if(channel.foam) continue;
                 const auto grid = channel.integrator.Grid();
                 channel.train_data.resize(grid.Dims()*grid.Bins());
             }
         }
         void AddTrainData(size_t channel, const double val2) {
+            channels[channel].mapping -> AddTrainData(val2);
+            if(channels[channel].foam) {
+                channels[channel].foam -> AddTrainData(channels[channel].rans, val2);
+                return;
+            }
             const auto grid = channels[channel].integrator.Grid();
             for(size_t j = 0; j < grid.Dims(); ++j) 
                 channels[channel].train_data[j * grid.Bins() + grid.FindBin(j, channels[channel].rans[j])] += val2;
         }
         void Train() {
             for(auto &channel : channels) {
+                channel.mapping -> Train();
+                if(channel.foam) {
+                    channel.foam -> Adapt();
+                    continue;
+                }
                 if(std::all_of(channel.train_data.begin(), channel.train_data.end(),
                                [](double i) { return i == 0; })) continue;
                 channel.integrator.Adapt(channel.train_data);
@@ -68,7 +108,8 @@ class Integrand {
 
         // Interface to MultiChannel integration
         void GeneratePoint(size_t channel, std::vector<double> &rans, std::vector<T> &point) const {
-            channels[channel].integrator.Grid()(rans);
+            if(channels[channel].foam) (*channels[channel].foam)(rans);
+            else channels[channel].integrator.Grid()(rans);
             channels[channel].mapping -> GeneratePoint(point, rans); 
         }
         double GenerateWeight(const std::vector<double> &wgts, const std::vector<T> &point,
@@ -78,8 +119,10 @@ class Integrand {
             for(size_t i = 0; i < NChannels(); ++i) {
                 densities[i] = channels[i].mapping -> GenerateWeight(point, rans);
                 channels[i].rans = rans;
-                double vw = channels[i].integrator.GenerateWeight(rans);
-                weight += wgts[i] * densities[i] / vw;
+                double vw = channels[i].foam ? channels[i].foam -> GenerateWeight(rans)
+                                             : channels[i].integrator.GenerateWeight(rans);
+                channels[i].density = densities[i] / vw;
+                weight += wgts[i] * channels[i].density;
             }
             return 1.0 / weight;
         }
@@ -89,6 +132,8 @@ class Integrand {
 
     private:
         std::vector<Channel<T>> channels;
+        std::vector<ControlVariate<T>> controls;
+        bool m_channel_controls{};
         Func<T> m_func{};
 };
 
@@ -101,6 +146,7 @@ struct convert<achilles::Channel<T>> {
     static Node encode(const achilles::Channel<T> &rhs) {
         Node node;
         node["Integrator"] = rhs.integrator;
+        if(rhs.foam) node["Foam"] = *rhs.foam;
         node["Mapper"] = rhs.mapping -> ToYAML();
         return node;
     }
@@ -37,6 +37,10 @@ class Mapper {
         virtual void SetMasses(std::vector<double> masses) { m_masses = std::move(masses); }
         virtual const std::vector<double>& Masses() const { return m_masses; }
 
+        // Training of trainable mappings, using the squared weight of the last point
+        virtual void AddTrainData(double) {}
+        virtual void Train() {}
+
         // Printers
         static void Print(const char* func, const std::vector<T> &point, const std::vector<double> &rans) {
             spdlog::trace("{}", func);
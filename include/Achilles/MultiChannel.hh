@@ -1,14 +1,23 @@
 #ifndef MULTICHANNEL_HH
 #define MULTICHANNEL_HH
 
+#include <numeric>
+
 #include "Achilles/Vegas.hh"
 #include "Achilles/Integrand.hh"
 
 namespace achilles {
 
+struct PrunedChannel {
+    size_t id{}, iteration{};
+    double weight{};
+};
+
 struct MultiChannelSummary {
     std::vector<StatsData> results;
     std::vector<double> best_weights;
+    std::vector<size_t> channel_ids;
+    std::vector<PrunedChannel> pruned;
     StatsData sum_results;
 
     StatsData Result() const { return sum_results; }
@@ -19,13 +28,15 @@ struct MultiChannelParams {
     double rtol{rtol_default};
     size_t nrefine{nrefine_default};
     double beta{beta_default}, min_alpha{min_alpha_default};
+    double prune_threshold{prune_threshold_default};
     size_t iteration{};
 
     static constexpr size_t ncalls_default{1000}, nint_default{10};
     static constexpr double rtol_default{1e-2};
     static constexpr size_t nrefine_default{1};
     static constexpr double beta_default{0.25}, min_alpha_default{1e-5};
-    static constexpr size_t nparams = 7;
+    static constexpr double prune_threshold_default{0};
+    static constexpr size_t nparams = 8;
 };
 
 class MultiChannel {
@@ -36,14 +47,24 @@ class MultiChannel {
         // Utilities
         size_t Dimensions() const { return ndims; }
         size_t NChannels() const { return channel_weights.size(); }
+        const std::vector<size_t>& ChannelIDs() const { return channel_ids; }
         MultiChannelParams Parameters() const { return params; }
         MultiChannelParams &Parameters() { return params; }
+        const std::vector<double>& ControlCoefficients() const { return control_coefficients; }
+        const QuasiRandom& Sampling() const { return sampling; }
+        void SetSampling(QuasiRandom _sampling) { sampling = std::move(_sampling); }
 
         // Optimization and event generation
         template<typename T>
         void operator()(Integrand<T>&);
         template<typename T>
         void Optimize(Integrand<T>&);
+        /// Sample the integrand with the current channel weights and grids, without adapting
+        /// them or adding to the summary. Used to generate events after the optimization
+        ///@param func: The integrand to sample
+        ///@return StatsData: The estimate of the integral from the sampled points
+        template<typename T>
+        StatsData Sample(Integrand<T>&);
 
         // Getting results
         MultiChannelSummary Summary();
@@ -53,43 +74,81 @@ class MultiChannel {
 
     private:
         void Adapt(const std::vector<double>&);
+        size_t SelectChannel(double) const;
         void TrainChannels();
         template<typename T>
         void RefineChannels(Integrand<T> &func) {
             params.iteration = 0;
             params.ncalls *= 2;
             for(auto &channel : func.Channels()) {
+                // The foam refines itself during the training
+                if(channel.foam) continue;
                 if(channel.integrator.Grid().Bins() < 200)
                     channel.integrator.Refine();
             }
         }
+        template<typename T>
+        void PruneChannels(Integrand<T>&);
+        template<typename T>
+        StatsData Iterate(Integrand<T>&, std::vector<double>*);
         void PrintIteration() const;
         void MaxDifference(const std::vector<double>&);
 
         size_t ndims{};
         MultiChannelParams params{};
         std::vector<double> channel_weights, best_weights;
+        std::vector<size_t> channel_ids;
         double min_diff{lim::infinity()};
         MultiChannelSummary summary;
+        QuasiRandom sampling{};
+        std::vector<double> control_coefficients;
 };
 
 template<typename T>
 void achilles::MultiChannel::operator()(Integrand<T> &func) {
+    std::vector<double> train_data(channel_weights.size());
+    StatsData results = Iterate(func, &train_data);
+
+    Adapt(train_data);
+    func.Train();
+    MaxDifference(train_data);
+    summary.results.push_back(results);
+    summary.sum_results += results;
+}
+
+template<typename T>
+achilles::StatsData achilles::MultiChannel::Sample(Integrand<T> &func) {
+    return Iterate(func, nullptr);
+}
+
+// One pass over params.ncalls points. The training data for the channel weights and the
+// grids is only collected if requested
+template<typename T>
+achilles::StatsData achilles::MultiChannel::Iterate(Integrand<T> &func, std::vector<double> *train_data) {
     size_t nchannels = channel_weights.size();
-    std::vector<double> rans(ndims);
+    std::vector<double> rans(ndims), qrans(ndims + 1);
     std::vector<T> point(ndims);
     std::vector<double> densities(nchannels);
-    std::vector<double> train_data(nchannels);
+    std::vector<double> controls;
+    ControlVariateEstimator estimator(func.ControlVariateIntegrals());
 
     StatsData results;
-    func.InitializeTrain();
-
-    for(size_t i = 0; i < params.ncalls; ++i) {
-        // Generate needed random numbers
-        Random::Instance().Generate(rans);
-
-        // Select a channel
-        size_t ichannel = Random::Instance().SelectIndex(channel_weights); 
+    if(train_data) func.InitializeTrain();
+    // The number of calls of pseudo-random points can grow during the iteration
+    if(sampling.Enabled()) sampling.Start(ndims + 1, params.ncalls);
+
+    for(size_t i = 0; i < (sampling.Enabled() ? sampling.Calls() : params.ncalls); ++i) {
+        // Generate needed random numbers, and select a channel. For quasi-random points the
+        // channel is selected with an additional dimension, to stratify the channels as well
+        size_t ichannel{};
+        if(sampling.Enabled()) {
+            sampling.Generate(qrans);
+            std::copy(qrans.begin(), qrans.end() - 1, rans.begin());
+            ichannel = SelectChannel(qrans.back());
+        } else {
+            Random::Instance().Generate(rans);
+            ichannel = Random::Instance().SelectIndex(channel_weights);
+        }
 
         // Map the point based on the channel
         func.GeneratePoint(ichannel, rans, point);
@@ -97,22 +156,38 @@ void achilles::MultiChannel::operator()(Integrand<T> &func) {
         // Evaluate the function at this point
         double wgt = func.GenerateWeight(channel_weights, point, densities);
         double val = wgt == 0 ? 0 : func(point, wgt);
+        // The variance is minimized by sampling according to |f|, so the squared weight is the
+        // correct training target for negative weights as well. Sign cancellations are kept
+        // track of separately in the results
         double val2 = val * val;
-        func.AddTrainData(ichannel, val2);
+        if(train_data) func.AddTrainData(ichannel, val2);
         results += val;
+        if(sampling.Enabled()) sampling.Add(val);
+        if(estimator.NVariates() > 0) {
+            if(sampling.Enabled() && i % (sampling.Calls()/sampling.Replicas()) == 0) estimator.NewBlock();
+            func.EvaluateControlVariates(point, wgt, controls);
+            estimator.Add(val, controls);
+        }
 
-        if(val2 != 0) {
+        if(train_data && val2 != 0) {
             for(size_t j = 0; j < nchannels; ++j) {
-                train_data[j] += densities[j] * val2 * wgt;
+                (*train_data)[j] += densities[j] * val2 * wgt;
             }
         }
     }
 
-    Adapt(train_data);
-    func.Train();
-    MaxDifference(train_data);
-    summary.results.push_back(results);
-    summary.sum_results += results;
+    // The reported result uses the control variates, which does not change the sampled points.
+    // The points of a quasi-random point set are not independent, so each replica is a block
+    if(estimator.NVariates() > 0) {
+        estimator.Solve();
+        control_coefficients = estimator.Coefficients();
+        results.SetMean(estimator.Mean());
+        results.SetError(sampling.Enabled() ? estimator.BlockError() : estimator.Error());
+    } else if(sampling.Enabled()) {
+        results.SetError(sampling.Error());
+    }
+
+    return results;
 }
 
 template<typename T>
@@ -120,6 +195,7 @@ void achilles::MultiChannel::Optimize(Integrand<T> &func) {
     double rel_err = lim::max();
     while((rel_err > params.rtol) || summary.results.size() < params.niterations) {
         (*this)(func);
+        PruneChannels(func);
         StatsData current = summary.sum_results;
         rel_err = current.Error() / std::abs(current.Mean());
 
@@ -128,10 +204,54 @@ void achilles::MultiChannel::Optimize(Integrand<T> &func) {
     }
 }
 
+// Remove the channels whose weight dropped below the pruning threshold. The weights of the
+// remaining channels are renormalized, and the removed channels are recorded in the summary.
+// At least one channel is always kept.
+template<typename T>
+void achilles::MultiChannel::PruneChannels(Integrand<T> &func) {
+    if(params.prune_threshold <= 0) return;
+
+    for(size_t i = channel_weights.size(); i-- > 0;) {
+        if(channel_weights.size() == 1) break;
+        if(channel_weights[i] >= params.prune_threshold) continue;
+
+        spdlog::info("MultiChannel: Removing channel {} with weight {}", channel_ids[i], channel_weights[i]);
+        summary.pruned.push_back({channel_ids[i], summary.results.size(), channel_weights[i]});
+        func.RemoveChannel(static_cast<int>(i));
+        channel_weights.erase(channel_weights.begin() + static_cast<std::ptrdiff_t>(i));
+        best_weights.erase(best_weights.begin() + static_cast<std::ptrdiff_t>(i));
+        channel_ids.erase(channel_ids.begin() + static_cast<std::ptrdiff_t>(i));
+    }
+
+    for(auto *weights : {&channel_weights, &best_weights}) {
+        const double sum = std::accumulate(weights -> begin(), weights -> end(), 0.0);
+        for(auto &wgt : *weights) wgt /= sum;
+    }
+}
+
 }
 
 namespace YAML {
 
+template<>
+struct convert<achilles::PrunedChannel> {
+    static Node encode(const achilles::PrunedChannel &rhs) {
+        Node node;
+        node["ID"] = rhs.id;
+        node["Iteration"] = rhs.iteration;
+        node["Weight"] = rhs.weight;
+        return node;
+    }
+
+    static bool decode(const Node &node, achilles::PrunedChannel &rhs) {
+        if(node.size() != 3) return false;
+        rhs.id = node["ID"].as<size_t>();
+        rhs.iteration = node["Iteration"].as<size_t>();
+        rhs.weight = node["Weight"].as<double>();
+        return true;
+    }
+};
+
 template<>
 struct convert<achilles::MultiChannelSummary> {
     static Node encode(const achilles::MultiChannelSummary &rhs) {
@@ -143,6 +263,11 @@ struct convert<achilles::MultiChannelSummary> {
         node["NChannels"] = rhs.best_weights.size();
         for(const auto &weight : rhs.best_weights)
             node["ChannelWeights"].push_back(weight);
+        for(const auto &id : rhs.channel_ids)
+            node["ChannelIDs"].push_back(id);
+
+        for(const auto &channel : rhs.pruned)
+            node["Pruned"].push_back(channel);
 
         return node;
     }
@@ -166,6 +291,17 @@ struct convert<achilles::MultiChannelSummary> {
         for(const auto &weight : node["ChannelWeights"])
             rhs.best_weights.push_back(weight.as<double>());
 
+        // Load the channel provenance, which is missing for older results
+        if(node["ChannelIDs"]) {
+            rhs.channel_ids = node["ChannelIDs"].as<std::vector<size_t>>();
+            if(rhs.channel_ids.size() != nchannels) return false;
+        } else {
+            rhs.channel_ids.resize(nchannels);
+            std::iota(rhs.channel_ids.begin(), rhs.channel_ids.end(), 0);
+        }
+        if(node["Pruned"])
+            rhs.pruned = node["Pruned"].as<std::vector<achilles::PrunedChannel>>();
+
         return true;
     }
 };
@@ -181,13 +317,16 @@ struct convert<achilles::MultiChannelParams> {
         node["nrefine"] = rhs.nrefine;
         node["beta"] = rhs.beta;
         node["min_alpha"] = rhs.min_alpha;
+        node["prune_threshold"] = rhs.prune_threshold;
         node["iteration"] = rhs.iteration;
 
         return node;
     }
 
     static bool decode(const Node &node, achilles::MultiChannelParams &rhs) {
-        if(node.size() != rhs.nparams) return false;
+        // The pruning threshold is missing for older results
+        const bool has_prune = static_cast<bool>(node["prune_threshold"]);
+        if(node.size() != rhs.nparams - (has_prune ? 0 : 1)) return false;
 
         rhs.ncalls = node["NCalls"].as<size_t>();
         rhs.niterations = node["NIterations"].as<size_t>();
@@ -195,6 +334,7 @@ struct convert<achilles::MultiChannelParams> {
         rhs.nrefine = node["nrefine"].as<size_t>();
         rhs.beta = node["beta"].as<double>();
         rhs.min_alpha = node["min_alpha"].as<double>();
+        if(has_prune) rhs.prune_threshold = node["prune_threshold"].as<double>();
         rhs.iteration = node["iteration"].as<size_t>();
 
         return true;
@@ -223,6 +363,7 @@ struct convert<achilles::MultiChannel> {
         if(rhs.summary.best_weights.size() != nchannels) return false; 
         rhs.channel_weights = rhs.summary.best_weights;
         rhs.best_weights = rhs.summary.best_weights;
+        rhs.channel_ids = rhs.summary.channel_ids;
         return true;
     }
 };
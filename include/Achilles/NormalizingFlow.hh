@@ -0,0 +1,185 @@
+#ifndef NORMALIZING_FLOW_HH
+#define NORMALIZING_FLOW_HH
+
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#pragma GCC diagnostic ignored "-Wconversion"
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+#pragma GCC diagnostic ignored "-Wnull-dereference"
+#include "Eigen/Dense"
+#pragma GCC diagnostic pop
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "yaml-cpp/yaml.h"
+#pragma GCC diagnostic pop
+
+namespace achilles {
+
+struct FlowParams {
+    size_t nlayers{nlayers_default}, nbins{nbins_default}, nhidden{nhidden_default};
+    size_t nepochs{nepochs_default}, batch_size{batch_size_default};
+    double learning_rate{learning_rate_default};
+
+    static constexpr size_t nlayers_default{4}, nbins_default{16}, nhidden_default{32};
+    static constexpr size_t nepochs_default{1}, batch_size_default{100};
+    static constexpr double learning_rate_default{1e-2};
+    static constexpr size_t nparams = 6;
+};
+
+/// Normalizing flow on the unit hypercube built from piecewise-linear coupling layers
+/// (see arXiv:1808.03856). Each layer transforms half of the dimensions with a piecewise-linear
+/// CDF, whose bin widths are predicted by a small neural network of the remaining dimensions.
+/// This allows the flow to learn correlations between dimensions, which the factorized
+/// AdaptiveMap of Vegas can not. The flow is initialized to the identity map, and is trained
+/// by minimizing the variance of the integrand with the Adam optimizer.
+class NormalizingFlow {
+    public:
+        NormalizingFlow() = default;
+        NormalizingFlow(size_t, FlowParams={});
+
+        // Utilities
+        size_t NDims() const { return ndims; }
+        FlowParams Parameters() const { return params; }
+        FlowParams &Parameters() { return params; }
+
+        /// Map a point from the unit hypercube to the flow space
+        ///@param rans: The point on the unit hypercube
+        ///@param point: The resulting point in the flow space
+        ///@return double: The density of the flow at the resulting point
+        double Forward(const std::vector<double> &rans, std::vector<double> &point) const;
+
+        /// Map a point from the flow space back to the unit hypercube
+        ///@param point: The point in the flow space
+        ///@param rans: The resulting point on the unit hypercube
+        ///@return double: The density of the flow at the given point
+        double Inverse(const std::vector<double> &point, std::vector<double> &rans) const;
+
+        /// Store a point sampled from the flow to be used in the next training step
+        ///@param point: The point in the flow space
+        ///@param density: The density of the flow at the point when it was sampled
+        ///@param val2: The squared weight of the integrand at the point
+        void AddTrainData(const std::vector<double> &point, double density, double val2);
+        void Train();
+        double Loss() const { return loss; }
+
+        // YAML interface
+        friend YAML::convert<achilles::NormalizingFlow>;
+
+    private:
+        struct Parameter {
+            Eigen::MatrixXd value, grad, m, v;
+
+            Parameter() = default;
+            Parameter(Eigen::MatrixXd);
+            void Step(double, size_t);
+        };
+
+        struct Layer {
+            std::vector<size_t> cond, trans;
+            Parameter w1, b1, w2, b2;
+        };
+
+        struct LayerCache {
+            Eigen::VectorXd x_cond, pre, hidden;
+            Eigen::MatrixXd prob;
+            std::vector<size_t> bins;
+        };
+
+        void Initialize();
+        void Conditioner(const Layer&, const std::vector<double>&, LayerCache&) const;
+        double Gradient(const std::vector<double>&, double);
+
+        size_t ndims{};
+        FlowParams params{};
+        std::vector<Layer> layers;
+        size_t nsteps{};
+        double loss{};
+        std::vector<double> train_points, train_weights, train_densities;
+};
+
+}
+
+namespace YAML {
+
+template<>
+struct convert<achilles::FlowParams> {
+    static Node encode(const achilles::FlowParams &rhs) {
+        Node node;
+
+        node["NLayers"] = rhs.nlayers;
+        node["NBins"] = rhs.nbins;
+        node["NHidden"] = rhs.nhidden;
+        node["NEpochs"] = rhs.nepochs;
+        node["BatchSize"] = rhs.batch_size;
+        node["LearningRate"] = rhs.learning_rate;
+
+        return node;
+    }
+
+    static bool decode(const Node &node, achilles::FlowParams &rhs) {
+        if(node["NLayers"]) rhs.nlayers = node["NLayers"].as<size_t>();
+        if(node["NBins"]) rhs.nbins = node["NBins"].as<size_t>();
+        if(node["NHidden"]) rhs.nhidden = node["NHidden"].as<size_t>();
+        if(node["NEpochs"]) rhs.nepochs = node["NEpochs"].as<size_t>();
+        if(node["BatchSize"]) rhs.batch_size = node["BatchSize"].as<size_t>();
+        if(node["LearningRate"]) rhs.learning_rate = node["LearningRate"].as<double>();
+
+        return rhs.nlayers > 0 && rhs.nbins > 0 && rhs.nhidden > 0 && rhs.batch_size > 0;
+    }
+};
+
+template<>
+struct convert<achilles::NormalizingFlow> {
+    static Node encode(const achilles::NormalizingFlow &rhs) {
+        Node node;
+        node["NDims"] = rhs.ndims;
+        node["Parameters"] = rhs.params;
+        node["NSteps"] = rhs.nsteps;
+        for(const auto &layer : rhs.layers) {
+            Node layer_node;
+            layer_node["W1"] = Flatten(layer.w1.value);
+            layer_node["B1"] = Flatten(layer.b1.value);
+            layer_node["W2"] = Flatten(layer.w2.value);
+            layer_node["B2"] = Flatten(layer.b2.value);
+            node["Layers"].push_back(layer_node);
+        }
+        return node;
+    }
+
+    static bool decode(const Node &node, achilles::NormalizingFlow &rhs) {
+        if(node.size() != 4) return false;
+
+        rhs = achilles::NormalizingFlow(node["NDims"].as<size_t>(),
+                                        node["Parameters"].as<achilles::FlowParams>());
+        rhs.nsteps = node["NSteps"].as<size_t>();
+        if(node["Layers"].size() != rhs.layers.size()) return false;
+        for(size_t i = 0; i < rhs.layers.size(); ++i) {
+            auto &layer = rhs.layers[i];
+            if(!Unflatten(node["Layers"][i]["W1"], layer.w1.value)) return false;
+            if(!Unflatten(node["Layers"][i]["B1"], layer.b1.value)) return false;
+            if(!Unflatten(node["Layers"][i]["W2"], layer.w2.value)) return false;
+            if(!Unflatten(node["Layers"][i]["B2"], layer.b2.value)) return false;
+        }
+        return true;
+    }
+
+    private:
+        static std::vector<double> Flatten(const Eigen::MatrixXd &mat) {
+            return {mat.data(), mat.data() + mat.size()};
+        }
+
+        static bool Unflatten(const Node &node, Eigen::MatrixXd &mat) {
+            auto values = node.as<std::vector<double>>();
+            if(values.size() != static_cast<size_t>(mat.size())) return false;
+            std::copy(values.begin(), values.end(), mat.data());
+            return true;
+        }
+};
+
+}
+
+#endif
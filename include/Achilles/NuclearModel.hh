@@ -4,8 +4,10 @@
 #include "Achilles/Event.hh"
 #include "Achilles/Factory.hh"
 #include "Achilles/FormFactor.hh"
+#include "Achilles/Hadronization.hh"
 #include "Achilles/ProcessInfo.hh"
 #include "Achilles/SpectralFunction.hh"
+#include "Achilles/StructureFunctions.hh"
 
 #include "yaml-cpp/node/node.h"
 
@@ -16,6 +18,7 @@ namespace achilles {
 class PID;
 class PSBuilder;
 class Spinor;
+class SpinMatrix;
 
 enum class NuclearMode {
     None = -1,
@@ -32,6 +35,8 @@ class NuclearModel {
     public:
         using Current = std::vector<std::vector<std::complex<double>>>;
         using Currents = std::map<int, Current>;
+        using Tensor = std::array<std::complex<double>, 16>;
+        using Tensors = std::map<int, Tensor>;
         using FFInfoMap = std::map<int, std::vector<FormFactorInfo>>;
         using FormFactorArray = std::array<std::complex<double>, 4>;
 
@@ -49,6 +54,17 @@ class NuclearModel {
         virtual void AllowedStates(Process_Info&) const = 0;
         virtual size_t NSpins() const = 0;
         virtual bool FillNucleus(Event&, const std::vector<double>&) const = 0;
+        // Called once the hadrons of the hard interaction are set, allowing the model to
+        // replace the outgoing hadronic system by the hadrons it produces
+        virtual void Hadronize(Event&) const {}
+        // Called once the hadrons of the hard interaction are set, allowing the model to
+        // add nucleons that are correlated with the struck nucleon
+        virtual void FillCorrelations(Event&) const {}
+
+        // Hadronic tensors W^{\mu\nu} = \sum J^\mu J^{\nu*} summed over the nucleon spins.
+        // Models that can evaluate these from traces should override both methods
+        virtual bool HasTensors() const { return false; }
+        virtual std::vector<Tensors> CalcTensors(const Event&, const std::vector<FFInfoMap>&) const;
 
         static std::string Name() { return "Nuclear Model"; }
 
@@ -77,6 +93,8 @@ class Coherent : public NuclearModel, RegistrableNuclearModel<Coherent> {
         void AllowedStates(Process_Info&) const override;
         size_t NSpins() const override { return 1; }
         bool FillNucleus(Event&, const std::vector<double>&) const override;
+        bool HasTensors() const override { return true; }
+        std::vector<Tensors> CalcTensors(const Event&, const std::vector<FFInfoMap>&) const override;
 
         // Required factory methods
         static std::unique_ptr<NuclearModel> Construct(const YAML::Node&);
@@ -96,15 +114,73 @@ class QESpectral : public NuclearModel, RegistrableNuclearModel<QESpectral> {
         void AllowedStates(Process_Info&) const override;
         size_t NSpins() const override { return 4; }
         bool FillNucleus(Event&, const std::vector<double>&) const override;
+        bool HasTensors() const override { return true; }
+        std::vector<Tensors> CalcTensors(const Event&, const std::vector<FFInfoMap>&) const override;
+        void FillCorrelations(Event&) const override;
+
+        /// Probability for the struck nucleon to belong to a short-range correlated pair
+        ///@param pid: The species of the struck nucleon
+        ///@param p: The momentum of the struck nucleon in MeV
+        ///@param removal_energy: The removal energy of the struck nucleon in MeV
+        ///@return double: The probability of the correlated part of the spectral function
+        double CorrelatedProbability(const PID&, double, double) const;
 
         // Required factory methods
         static std::unique_ptr<NuclearModel> Construct(const YAML::Node&);
         static std::string Name() { return "QESpectral"; }
 
     private:
+        // Short-range correlated pairs. The correlated part of the spectral function is either
+        // obtained by removing the mean-field spectral function, or taken as all nucleons with
+        // a momentum above the cut. The ratio of np to pp (and nn) pairs sets the partner species
+        struct SRCPairs {
+            bool enabled{false};
+            double momentum_cut{300}, pair_ratio{20}, cm_width{0};
+            std::shared_ptr<SpectralFunction> mean_field_proton{}, mean_field_neutron{};
+        };
+
         bool b_ward{};
+        SRCPairs m_src{};
         Current HadronicCurrent(const std::array<Spinor, 2>&, const std::array<Spinor, 2>&,
                                 const FourVector&, const FormFactorArray&) const;
+        std::array<SpinMatrix, 4> Vertex(const FourVector&, const FormFactorArray&) const;
+        SpectralFunction spectral_proton, spectral_neutron; 
+};
+
+class InelasticSpectral : public NuclearModel, RegistrableNuclearModel<InelasticSpectral> {
+    public:
+        InelasticSpectral(const YAML::Node&);
+
+        NuclearMode Mode() const override { return NuclearMode::DeepInelastic; }
+        std::string PhaseSpace() const override { return QESpectral::Name(); }
+        std::vector<Currents> CalcCurrents(const Event&, const std::vector<FFInfoMap>&) const override;
+        void AllowedStates(Process_Info&) const override;
+        size_t NSpins() const override { return 1; }
+        bool FillNucleus(Event&, const std::vector<double>&) const override;
+        bool HasTensors() const override { return true; }
+        std::vector<Tensors> CalcTensors(const Event&, const std::vector<FFInfoMap>&) const override;
+        void Hadronize(Event&) const override;
+
+        /// Hadronic tensor of a free nucleon, W^{mu nu} = 2|g|^2 [-g^{mu nu} F1 + ... ], normalized such
+        /// that it integrates with the phase space in W^2 to the spin averaged tensor of an exclusive final state
+        ///@param p: The momentum of the nucleon
+        ///@param q: The momentum transfer
+        ///@param sf: The structure functions at x = Q^2/(2 p.q) and Q^2
+        ///@param coupling2: The squared coupling of the boson to the quarks
+        ///@return Tensor: The hadronic tensor with upper indices
+        static Tensor StructureTensor(const FourVector&, const FourVector&,
+                                      const StructureFunctions::Values&, double);
+
+        /// Squared coupling of the exchanged boson to the quarks
+        static double Coupling2(int);
+
+        // Required factory methods
+        static std::unique_ptr<NuclearModel> Construct(const YAML::Node&);
+        static std::string Name() { return "InelasticSpectral"; }
+
+    private:
+        StructureFunctions m_structure;
+        Hadronization m_hadronization;
         SpectralFunction spectral_proton, spectral_neutron; 
 };
 
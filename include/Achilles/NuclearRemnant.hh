@@ -17,6 +17,8 @@ class NuclearRemnant {
             return os;
         }
 
+        size_t NA() const { return m_nA; }
+        size_t NZ() const { return m_nZ; }
         int PID() const { return std::stoi(fmt::format("100{:03}{:03}0", m_nZ, m_nA)); }
         double Mass() const { return static_cast<double>(m_nA)*Constant::mN; }
         bool operator==(const NuclearRemnant &other) const {
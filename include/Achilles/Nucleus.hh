@@ -177,6 +177,13 @@ class Nucleus {
         /// Generate a configuration of the nucleus based on the density function
         MOCK void GenerateConfig();
 
+        /// Generate a new configuration of the spectator nucleons for an event that has
+        /// already been generated. Every nucleon of the event that is no longer in the background
+        /// replaces the closest nucleon of the same type in the new configuration, keeping its
+        /// position and momentum, and any additional particles are appended unchanged
+        ///@param original: The nucleons of the event, starting with the previous configuration
+        void ResampleConfig(const Particles&);
+
         /// Generate a random momentum for a nucleon in the nucleus
         ///@return std::array<double, 3>: Random momentum generated using the Fermi momentum
         const std::array<double, 3> GenerateMomentum(const double&) noexcept;
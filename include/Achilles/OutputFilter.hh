@@ -0,0 +1,78 @@
+#ifndef OUTPUT_FILTER_HH
+#define OUTPUT_FILTER_HH
+
+#include <set>
+#include <string>
+#include <vector>
+
+#include "Achilles/ParticleInfo.hh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "yaml-cpp/yaml.h"
+#pragma GCC diagnostic pop
+
+namespace achilles {
+
+class Particle;
+enum class ParticleStatus : int;
+
+/// Selects the particles of an event that are written out by an EventWriter. Particles are
+/// selected by their status, species and kinematic thresholds. The initial state particles are
+/// always kept, since the writers build the interaction from them. The spectator nucleons are
+/// already collected in the nuclear remnant when the event is written, so they can not be
+/// selected. A default constructed filter keeps every particle.
+class OutputFilter {
+    public:
+        OutputFilter() = default;
+        OutputFilter(std::set<ParticleStatus>, std::set<PID>, double, double);
+
+        bool Enabled() const { return m_enabled; }
+
+        /// Check if a particle should be written out
+        ///@param particle: The particle to check
+        ///@return bool: True if the particle passes the filter
+        bool Keep(const Particle&) const;
+
+        /// Select the particles that pass the filter
+        ///@param particles: The particles to filter
+        ///@return std::vector<Particle>: The particles to be written out
+        std::vector<Particle> operator()(const std::vector<Particle>&) const;
+
+        static ParticleStatus StatusFromName(const std::string&);
+
+    private:
+        bool m_enabled{false};
+        std::set<ParticleStatus> m_status{};
+        std::set<PID> m_pids{};
+        double m_min_momentum{}, m_min_kinetic{};
+};
+
+}
+
+namespace YAML {
+
+template<>
+struct convert<achilles::OutputFilter> {
+    static bool decode(const Node &node, achilles::OutputFilter &filter) {
+        if(!node.IsMap()) return false;
+        std::set<achilles::ParticleStatus> status;
+        if(node["Status"]) {
+            for(const auto &name : node["Status"].as<std::vector<std::string>>())
+                status.insert(achilles::OutputFilter::StatusFromName(name));
+        }
+        std::set<achilles::PID> pids;
+        if(node["PIDs"]) {
+            for(const auto &pid : node["PIDs"].as<std::vector<long int>>())
+                pids.insert(achilles::PID{pid});
+        }
+        double min_momentum = node["MinMomentum"] ? node["MinMomentum"].as<double>() : 0;
+        double min_kinetic = node["MinKineticEnergy"] ? node["MinKineticEnergy"].as<double>() : 0;
+        filter = achilles::OutputFilter(status, pids, min_momentum, min_kinetic);
+        return true;
+    }
+};
+
+}
+
+#endif
@@ -80,7 +80,8 @@ class Particle {
         Particle(const Particle &other) : info{ParticleInfo(other.info.ID())},
             momentum{other.momentum},
             position{other.position}, status{other.status}, mothers{other.mothers},
-            formationZone{other.formationZone} {}
+            formationZone{other.formationZone}, formationTime{other.formationTime},
+            formationScale{other.formationScale} {}
 
         Particle(Particle&&) = default;
         Particle& operator=(const Particle&) = default;
@@ -134,6 +135,14 @@ class Particle {
         ///@param q: The momentum of the hadron after the interaction
         void SetFormationZone(const FourVector&, const FourVector&) noexcept;
 
+        /// Set the formation zone of the particle from a formation zone model
+        ///@param time: The formation time in the lab frame
+        ///@param scale: The fraction of the cross section at the start of the formation
+        void SetFormation(double time, double scale) noexcept {
+            formationZone = formationTime = time;
+            formationScale = scale;
+        }
+
         /// Update the formation zone time by a given time step
         ///@param timeStep: The time step to update the formation zone by
         void UpdateFormationZone(const double& timeStep) noexcept {formationZone -= timeStep;}
@@ -182,6 +191,14 @@ class Particle {
         ///@return double: Time left in formation zone
         const double& FormationZone() const noexcept {return formationZone;}
 
+        /// Return the total formation time set at the start of the formation
+        ///@return double: The formation time
+        double FormationTime() const noexcept {return formationTime;}
+
+        /// Return the fraction of the cross section at the start of the formation
+        ///@return double: The fraction of the cross section
+        double FormationScale() const noexcept {return formationScale;}
+
         /// Return the mass of the given particle
         ///@return double: The mass of the particle
         double Mass() const noexcept { return info.Mass(); }
@@ -286,6 +303,7 @@ class Particle {
         ParticleStatus status;
         std::vector<int> mothers, daughters;
         double formationZone;
+        double formationTime{}, formationScale{};
         double distanceTraveled = 0.0;
 };
 
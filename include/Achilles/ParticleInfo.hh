@@ -70,6 +70,11 @@ namespace achilles {
             static constexpr PID neutron() { return PID{ 2112 }; }
             // Dummy hadron
             static constexpr PID dummyHadron() { return PID{ 2212 }; }
+            // Light Nuclei
+            static constexpr PID deuteron() { return PID{ 1000010020 }; }
+            static constexpr PID triton() { return PID{ 1000010030 }; }
+            static constexpr PID helium3() { return PID{ 1000020030 }; }
+            static constexpr PID alpha() { return PID{ 1000020040 }; }
             // Common Elements
             static constexpr PID dummyNucleus() { return PID{ 1000000000 }; }
             static constexpr PID carbon() { return PID{ 1000060120 }; }
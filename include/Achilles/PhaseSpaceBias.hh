@@ -0,0 +1,122 @@
+#ifndef PHASE_SPACE_BIAS_HH
+#define PHASE_SPACE_BIAS_HH
+
+#include <string>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "yaml-cpp/yaml.h"
+#pragma GCC diagnostic pop
+
+namespace achilles {
+
+class Event;
+class FourVector;
+
+/// Bias function on the lepton kinematics of an event. The integrand is multiplied by the bias
+/// during both the optimization of the integrator and the event generation, so that regions
+/// with a large bias are sampled more often. The event weights carry the inverse of the bias,
+/// which keeps weighted distributions unbiased. The bias is a product of terms, each depending
+/// on a single kinematic variable x through either a power law (1 + |x|/scale)^exponent or an
+/// exponential exp(exponent*x/scale).
+class PhaseSpaceBias {
+    public:
+        enum class Variable {
+            Q2,
+            Omega,
+            ThetaLepton,
+            W
+        };
+
+        enum class Form {
+            Power,
+            Exponential
+        };
+
+        struct Term {
+            Variable variable{Variable::Q2};
+            Form form{Form::Power};
+            double scale{1}, exponent{1};
+        };
+
+        PhaseSpaceBias() = default;
+        PhaseSpaceBias(std::vector<Term>);
+
+        bool Enabled() const { return !m_terms.empty(); }
+        const std::vector<Term>& Terms() const { return m_terms; }
+
+        /// Evaluate a kinematic variable, assuming a nucleon target at rest for W
+        ///@param variable: The variable to evaluate
+        ///@param lep_in: The momentum of the incoming lepton
+        ///@param lep_out: The momentum of the outgoing lepton
+        ///@return double: The value of the variable in MeV (MeV^2 for Q2), or radians
+        static double Evaluate(Variable, const FourVector&, const FourVector&);
+
+        /// Evaluate the bias for the given lepton momenta
+        ///@param lep_in: The momentum of the incoming lepton
+        ///@param lep_out: The momentum of the outgoing lepton
+        ///@return double: The bias factor
+        double operator()(const FourVector&, const FourVector&) const;
+
+        /// Evaluate the bias for the leptons of an event
+        ///@param event: The event to evaluate the bias for
+        ///@return double: The bias factor
+        double operator()(const Event&) const;
+
+    private:
+        std::vector<Term> m_terms{};
+};
+
+}
+
+namespace YAML {
+
+template<>
+struct convert<achilles::PhaseSpaceBias::Variable> {
+    static bool decode(const Node &node, achilles::PhaseSpaceBias::Variable &variable) {
+        const auto name = node.as<std::string>();
+        if(name == "Q2") variable = achilles::PhaseSpaceBias::Variable::Q2;
+        else if(name == "Omega") variable = achilles::PhaseSpaceBias::Variable::Omega;
+        else if(name == "ThetaLepton") variable = achilles::PhaseSpaceBias::Variable::ThetaLepton;
+        else if(name == "W") variable = achilles::PhaseSpaceBias::Variable::W;
+        else return false;
+        return true;
+    }
+};
+
+template<>
+struct convert<achilles::PhaseSpaceBias::Form> {
+    static bool decode(const Node &node, achilles::PhaseSpaceBias::Form &form) {
+        const auto name = node.as<std::string>();
+        if(name == "Power") form = achilles::PhaseSpaceBias::Form::Power;
+        else if(name == "Exponential") form = achilles::PhaseSpaceBias::Form::Exponential;
+        else return false;
+        return true;
+    }
+};
+
+template<>
+struct convert<achilles::PhaseSpaceBias::Term> {
+    static bool decode(const Node &node, achilles::PhaseSpaceBias::Term &term) {
+        if(!node.IsMap() || !node["Variable"]) return false;
+        term.variable = node["Variable"].as<achilles::PhaseSpaceBias::Variable>();
+        if(node["Form"]) term.form = node["Form"].as<achilles::PhaseSpaceBias::Form>();
+        if(node["Scale"]) term.scale = node["Scale"].as<double>();
+        if(node["Exponent"]) term.exponent = node["Exponent"].as<double>();
+        return term.scale > 0;
+    }
+};
+
+template<>
+struct convert<achilles::PhaseSpaceBias> {
+    static bool decode(const Node &node, achilles::PhaseSpaceBias &bias) {
+        if(!node.IsSequence()) return false;
+        bias = achilles::PhaseSpaceBias(node.as<std::vector<achilles::PhaseSpaceBias::Term>>());
+        return true;
+    }
+};
+
+}
+
+#endif
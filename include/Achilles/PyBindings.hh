@@ -26,6 +26,7 @@ void NucleusModule(py::module&);
 // Calculation Objects
 void InteractionsModule(py::module&);
 void CascadeModule(py::module&);
+void EventGenModule(py::module&);
 
 
 #endif
@@ -0,0 +1,101 @@
+#ifndef QUASIRANDOM_HH
+#define QUASIRANDOM_HH
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "yaml-cpp/yaml.h"
+#pragma GCC diagnostic pop
+
+namespace achilles {
+
+/// Source of the points on the unit hypercube used by the integrators. The default draws
+/// independent pseudo-random points. The Sobol option uses a randomized Sobol sequence
+/// (Joe-Kuo direction numbers with a random linear matrix scramble and digital shift), whose
+/// integration error falls faster than 1/sqrt(N) for smooth integrands. The calls of an iteration
+/// are divided over a number of independently randomized copies of the point set (replicas), and
+/// the error is estimated from the spread of the replica means, since the points within a
+/// replica are not independent. Dimensions beyond the table of direction numbers are padded
+/// with pseudo-random numbers.
+class QuasiRandom {
+    public:
+        enum class Type {
+            Pseudo,
+            Sobol,
+        };
+
+        QuasiRandom() = default;
+        QuasiRandom(Type, size_t replicas=replicas_default);
+
+        Type GetType() const { return m_type; }
+        size_t Replicas() const { return m_replicas; }
+        bool Enabled() const { return m_type != Type::Pseudo; }
+
+        /// Prepare the point sets for an iteration
+        ///@param dims: The number of dimensions of the points
+        ///@param ncalls: The requested number of points, rounded up to a multiple of the replicas
+        void Start(size_t, size_t);
+
+        /// The number of points of the iteration
+        ///@return size_t: The number of points in all replicas
+        size_t Calls() const { return m_npoints*m_replicas; }
+
+        /// Fill the next point, starting a new randomization at the start of every replica
+        ///@param point: The vector to be filled, with the size given to Start
+        void Generate(std::vector<double>&);
+
+        /// Add the integrand value of the last point to the current replica
+        ///@param value: The value of the integrand
+        void Add(double value) { m_means.back() += value/static_cast<double>(m_npoints); }
+
+        /// Error on the mean of the iteration from the spread of the replica means
+        ///@return double: The estimated error of the integral
+        double Error() const;
+
+        /// The number of dimensions with direction numbers
+        static constexpr size_t MaxDimension() { return maxdims; }
+        static std::string Name(Type);
+
+        static constexpr size_t replicas_default = 8;
+        static constexpr size_t bits = 32;
+
+    private:
+        static constexpr size_t maxdims = 32;
+        void Randomize();
+
+        Type m_type{Type::Pseudo};
+        size_t m_replicas{1}, m_dims{}, m_npoints{}, m_index{};
+        std::vector<std::array<uint32_t, bits>> m_directions;
+        std::vector<uint32_t> m_state;
+        std::vector<double> m_means;
+};
+
+}
+
+namespace YAML {
+
+template<>
+struct convert<achilles::QuasiRandom> {
+    static bool decode(const Node &node, achilles::QuasiRandom &rhs) {
+        if(!node["Points"]) return false;
+        const auto name = node["Points"].as<std::string>();
+        achilles::QuasiRandom::Type type;
+        if(name == "Pseudo") type = achilles::QuasiRandom::Type::Pseudo;
+        else if(name == "Sobol") type = achilles::QuasiRandom::Type::Sobol;
+        else return false;
+
+        const auto replicas = node["Replicas"] ? node["Replicas"].as<size_t>()
+                                               : achilles::QuasiRandom::replicas_default;
+        rhs = achilles::QuasiRandom(type, replicas);
+        return true;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,103 @@
+#ifndef RADIATIVE_CORRECTIONS_HH
+#define RADIATIVE_CORRECTIONS_HH
+
+#include <memory>
+
+#include "Achilles/Beams.hh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "yaml-cpp/yaml.h"
+#pragma GCC diagnostic pop
+
+namespace achilles {
+
+class Event;
+
+/// Electron beam after initial state radiation in the peaking approximation. The fraction of
+/// the beam energy carried away by the collinear photon, y, is sampled from beta*y^(beta-1)
+/// with a fixed reference beta. The generation weight includes the remaining (1-y+3y^2/4)
+/// factor of the radiator, while the difference to the beta of the event is corrected for by
+/// the RadiativeCorrections once the kinematics of the event are known.
+class ISRFlux : public FluxType {
+    public:
+        ISRFlux(double energy, double beta) : m_energy{energy}, m_beta{beta} {}
+        int NVariables() const override { return 1; }
+        FourVector Flux(const std::vector<double>&, double) const override;
+        double GenerateWeight(const FourVector&, std::vector<double>&, double) const override;
+        std::string Type() const override { return "ISR"; }
+        double EvaluateFlux(const FourVector&) const override { return 1; }
+
+        double Energy() const { return m_energy; }
+        double Beta() const { return m_beta; }
+
+    private:
+        double MaxFraction(double) const;
+
+        double m_energy, m_beta;
+};
+
+/// QED radiative corrections for electron scattering in the peaking approximation (Mo and Tsai).
+/// The event weight is multiplied by the vertex and vacuum polarization corrections, and
+/// collinear photons are radiated from the incoming (using the ISRFlux) and outgoing electron.
+/// The radiated photons are added to the leptons of the event, and the incoming electron
+/// carries the full beam energy in the event record.
+class RadiativeCorrections {
+    public:
+        RadiativeCorrections() = default;
+        RadiativeCorrections(bool isr, bool fsr, bool virt)
+            : m_isr{isr}, m_fsr{fsr}, m_virtual{virt} {}
+
+        bool Enabled() const { return m_isr || m_fsr || m_virtual; }
+        bool ISR() const { return m_isr; }
+        bool FSR() const { return m_fsr; }
+        bool Virtual() const { return m_virtual; }
+
+        /// Exponent of the collinear radiation off a single electron leg
+        ///@param Q2: The momentum transfer in MeV^2
+        ///@return double: beta = alpha/pi*(ln(Q2/me^2) - 1)
+        static double Beta(double);
+
+        /// Remaining factor of the radiator in the peaking approximation
+        ///@param y: The fraction of the energy carried by the photon
+        ///@return double: 1 - y + 3/4 y^2
+        static double Radiator(double y) { return 1 - y + 0.75*y*y; }
+
+        /// Vertex and vacuum polarization (electron loop) correction
+        ///@param Q2: The momentum transfer in MeV^2
+        ///@return double: 1 + delta_vertex + delta_vac
+        static double VirtualFactor(double);
+
+        /// Create the flux for an electron beam including initial state radiation
+        ///@param energy: The energy of the electron beam in MeV
+        ///@return std::shared_ptr<FluxType>: The radiated flux, which is also used in Radiate
+        std::shared_ptr<FluxType> MakeISRFlux(double);
+
+        /// Add the radiation to an event and correct its weight
+        ///@param event: The event to radiate photons from
+        void Radiate(Event&) const;
+
+    private:
+        bool m_isr{false}, m_fsr{false}, m_virtual{false};
+        std::shared_ptr<ISRFlux> m_flux{};
+};
+
+}
+
+namespace YAML {
+
+template<>
+struct convert<achilles::RadiativeCorrections> {
+    static bool decode(const Node &node, achilles::RadiativeCorrections &corrections) {
+        if(!node.IsMap()) return false;
+        const bool isr = node["ISR"] ? node["ISR"].as<bool>() : true;
+        const bool fsr = node["FSR"] ? node["FSR"].as<bool>() : true;
+        const bool virt = node["Virtual"] ? node["Virtual"].as<bool>() : true;
+        corrections = achilles::RadiativeCorrections(isr, fsr, virt);
+        return true;
+    }
+};
+
+}
+
+#endif
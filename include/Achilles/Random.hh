@@ -32,6 +32,16 @@ class Random {
             return m_rng -> uniform(low, high);
         }
 
+        template<typename T>
+        T Normal(T mean, T sigma) {
+            return m_rng -> variate<T, std::normal_distribution>(mean, sigma);
+        }
+
+        template<typename T>
+        T Poisson(double mean) {
+            return m_rng -> variate<T, std::poisson_distribution>(mean);
+        }
+
         template<typename T>
         T Pick(const std::vector<T> &vec) {
             return m_rng -> pick(vec);
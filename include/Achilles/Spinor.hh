@@ -217,6 +217,31 @@ class SpinMatrix {
             return m_mat == other.m_mat;
         }
 
+        SpinMatrix Dagger() const {
+            SpinMatrix result;
+            for(size_t i = 0; i < 4; ++i) {
+                for(size_t j = 0; j < 4; ++j) {
+                    result[4*i+j] = std::conj(m_mat[4*j+i]);
+                }
+            }
+            return result;
+        }
+
+        Complex Trace() const {
+            return m_mat[0] + m_mat[5] + m_mat[10] + m_mat[15];
+        }
+
+        // Trace of the product of two matrices, without forming the product
+        static Complex Trace(const SpinMatrix &lhs, const SpinMatrix &rhs) {
+            Complex result{};
+            for(size_t i = 0; i < 4; ++i) {
+                for(size_t j = 0; j < 4; ++j) {
+                    result += lhs[4*i+j]*rhs[4*j+i];
+                }
+            }
+            return result;
+        }
+
         Complex& operator[](size_t i) { return m_mat[i]; }
         const Complex& operator[](size_t i) const { return m_mat[i]; }
 
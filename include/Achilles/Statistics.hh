@@ -77,6 +77,10 @@ class StatsData {
             max = std::max(max, x);
 
             if(x != 0) n_finite++;
+            if(x < 0) {
+                n_neg++;
+                sum_neg += x;
+            }
 
             return *this;
         }
@@ -88,6 +92,8 @@ class StatsData {
             n_finite += x.n_finite;
             sum += x.sum;
             sum2 += x.sum2;
+            n_neg += x.n_neg;
+            sum_neg += x.sum_neg;
             min = std::min(min, x.min);
             max = std::max(max, x.max);
 
@@ -103,6 +109,26 @@ class StatsData {
         double Min() const { return min; }
         double Max() const { return max; }
         double Error() const { return sqrt(Variance()); }
+        // Replace the error estimate while keeping the mean, for points that are not independent
+        // and whose error is estimated separately
+        void SetError(double error) { sum2 = n*(error*error*(n - 1) + Mean()*Mean()); }
+        // Replace the mean while keeping the error, for estimators other than the sample mean
+        void SetMean(double mean) {
+            const double error = Error();
+            sum = n*mean;
+            SetError(error);
+        }
+
+        // Separate accounting of the positive and negative contributions
+        size_t NegativeCalls() const { return static_cast<size_t>(n_neg); }
+        size_t PositiveCalls() const { return static_cast<size_t>(n_finite - n_neg); }
+        double PositiveMean() const { return (sum - sum_neg)/n; }
+        double NegativeMean() const { return sum_neg/n; }
+        // Fraction of the absolute cross section that comes from negative weights
+        double NegativeFraction() const {
+            const double abs_sum = sum - 2*sum_neg;
+            return abs_sum == 0 ? 0 : -sum_neg/abs_sum;
+        }
 
         bool operator==(const StatsData &other) const {
             static constexpr double tol = 1e-6;
@@ -111,6 +137,7 @@ class StatsData {
             equal = equal && (std::abs(max - other.max) < tol);
             equal = equal && (std::abs(sum - other.sum) < tol);
             equal = equal && (std::abs(sum2 - other.sum2) < tol);
+            equal = equal && n_neg == other.n_neg && (std::abs(sum_neg - other.sum_neg) < tol);
             return equal;
         }
         bool operator!=(const StatsData &other) const { return !(*this == other); }
@@ -118,7 +145,8 @@ class StatsData {
         friend YAML::convert<achilles::StatsData>;
 
     private:
-        double n{}, min{lim::max()}, max{lim::min()}, sum{}, sum2{}, n_finite{};
+        double n{}, min{lim::max()}, max{lim::lowest()}, sum{}, sum2{}, n_finite{};
+        double n_neg{}, sum_neg{};
 };
 
 }
@@ -129,14 +157,15 @@ template<>
 struct convert<achilles::StatsData> {
     static Node encode(const achilles::StatsData &rhs) {
         Node node;
-        node = std::vector<double>{rhs.n, rhs.min, rhs.max, rhs.sum, rhs.sum2, rhs.n_finite};
+        node = std::vector<double>{rhs.n, rhs.min, rhs.max, rhs.sum, rhs.sum2, rhs.n_finite,
+                                   rhs.n_neg, rhs.sum_neg};
         node.SetStyle(YAML::EmitterStyle::Flow);
         return node;
     }
 
     static bool decode(const Node &node, achilles::StatsData &rhs) {
-        // Ensure the node has 6 entries
-        if(node.size() != 6 || !node.IsSequence()) return false;
+        // Ensure the node has 8 entries (6 for results without negative weight information)
+        if((node.size() != 8 && node.size() != 6) || !node.IsSequence()) return false;
 
         // Load the entries
         rhs.n = node[0].as<double>();
@@ -145,6 +174,10 @@ struct convert<achilles::StatsData> {
         rhs.sum = node[3].as<double>();
         rhs.sum2 = node[4].as<double>();
         rhs.n_finite = node[5].as<double>();
+        if(node.size() == 8) {
+            rhs.n_neg = node[6].as<double>();
+            rhs.sum_neg = node[7].as<double>();
+        }
 
         return true;
     }
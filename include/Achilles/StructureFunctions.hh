@@ -0,0 +1,66 @@
+#ifndef STRUCTURE_FUNCTIONS_HH
+#define STRUCTURE_FUNCTIONS_HH
+
+#include "Achilles/ParticleInfo.hh"
+
+#include "yaml-cpp/node/node.h"
+
+namespace achilles {
+
+/// Inelastic structure functions of a free nucleon from a compiled-in leading order quark model.
+/// The valence distributions are x q_v = N x^a (1-x)^b, normalized to the valence quark numbers,
+/// and the flavor symmetric sea is x S = A (1-x)^c, normalized to the sea momentum fraction.
+/// The distributions are evaluated at the Bodek-Yang scaling variable xi_w, and the valence and
+/// sea contributions are multiplied by low Q^2 factors, such that the structure functions
+/// vanish at the real photon point and approach the quark model at large Q^2. This gives a
+/// duality averaged description of the shallow inelastic region without resonance peaks.
+/// No QCD evolution is included. The Cabibbo angle and heavy quarks are neglected.
+class StructureFunctions {
+    public:
+        struct Values {
+            double F1{}, F2{}, F3{};
+        };
+
+        struct Parameters {
+            // Valence and sea shapes
+            double alpha_valence{0.5}, beta_u{3}, beta_d{4};
+            double sea_momentum{0.2}, beta_sea{7};
+            // Bodek-Yang scaling variable and low Q^2 factors in GeV^2
+            double A{0.419}, B{0.223};
+            double C_sea{0.381}, C_valence1{0.417}, C_valence2{0.323};
+            // Ratio of longitudinal to transverse cross sections
+            double R{0.18};
+        };
+
+        StructureFunctions() : StructureFunctions(Parameters{}) {}
+        StructureFunctions(const Parameters&);
+        StructureFunctions(const YAML::Node&);
+
+        /// Evaluate the structure functions
+        ///@param nucleon: The PID of the struck nucleon
+        ///@param boson: The PID of the exchanged boson, where -24 (24) raises (lowers) the hadron charge
+        ///@param x: The Bjorken scaling variable
+        ///@param Q2: The momentum transfer in MeV^2
+        ///@return Values: The structure functions F1, F2, and F3
+        Values operator()(PID, int, double, double) const;
+
+        /// Parton distributions (not multiplied by x) at the given momentum fraction
+        double UValence(double) const;
+        double DValence(double) const;
+        double Sea(double) const;
+
+        /// Bodek-Yang scaling variable
+        ///@param x: The Bjorken scaling variable
+        ///@param Q2: The momentum transfer in GeV^2
+        double Xi(double, double) const;
+
+        const Parameters& Params() const { return m_params; }
+
+    private:
+        Parameters m_params;
+        double m_norm_u{}, m_norm_d{}, m_norm_sea{};
+};
+
+}
+
+#endif
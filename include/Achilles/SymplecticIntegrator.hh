@@ -3,10 +3,13 @@
 
 #include <functional>
 #include <utility>
+#include <vector>
 
 #include "Achilles/Potential.hh"
 #include "Achilles/ThreeVector.hh"
 
+#include "yaml-cpp/yaml.h"
+
 namespace achilles {
 
 struct PSState {
@@ -26,19 +29,33 @@ struct is_even {
 
 }
 
+/// Symplectic integrator for non-separable Hamiltonians in an extended phase space (Tao,
+/// Phys. Rev. E 94, 043303). The second order scheme can be composed into higher order schemes,
+/// which allow much larger steps at the same accuracy. The cost of a scheme is given by the
+/// number of second order stages it requires per step.
 class SymplecticIntegrator {
     public:
+        enum class Scheme {
+            Order2,     // Second order scheme (1 stage)
+            ForestRuth, // Fourth order triple jump of Forest-Ruth and Yoshida (3 stages)
+            Suzuki,     // Fourth order fractal composition of Suzuki (5 stages)
+            Yoshida6,   // Sixth order composition of Yoshida, solution A (7 stages)
+        };
+
         using dHamiltonian = std::function<ThreeVector(const ThreeVector&, const ThreeVector&,
                                                        std::shared_ptr<achilles::Potential>)>;
         using PhaseSpace = std::pair<ThreeVector, ThreeVector>;
         SymplecticIntegrator() = default;
         SymplecticIntegrator(PSState state, std::shared_ptr<achilles::Potential> pot,
-                             dHamiltonian dHdr, dHamiltonian dHdp, double omega) 
-            : m_omega{std::move(omega)}, m_state{std::move(state)},
+                             dHamiltonian dHdr, dHamiltonian dHdp, double omega,
+                             Scheme scheme=Scheme::Order2) 
+            : m_omega{std::move(omega)}, m_scheme{scheme}, m_state{std::move(state)},
               m_dHdr{std::move(dHdr)}, m_dHdp{std::move(dHdp)}, m_pot{std::move(pot)} {}
         SymplecticIntegrator(ThreeVector q, ThreeVector p, std::shared_ptr<achilles::Potential> pot,
-                             dHamiltonian dHdr, dHamiltonian dHdp, double omega) 
-            : m_omega{std::move(omega)}, m_dHdr{std::move(dHdr)}, m_dHdp{std::move(dHdp)}, m_pot{std::move(pot)} {
+                             dHamiltonian dHdr, dHamiltonian dHdp, double omega,
+                             Scheme scheme=Scheme::Order2) 
+            : m_omega{std::move(omega)}, m_scheme{scheme},
+              m_dHdr{std::move(dHdr)}, m_dHdp{std::move(dHdp)}, m_pot{std::move(pot)} {
                 m_state = PSState(q, p);
             }
 
@@ -54,15 +71,29 @@ class SymplecticIntegrator {
         dHamiltonian dHdp() const { return m_dHdp; }
         dHamiltonian& dHdp() { return m_dHdp; }
 
+        Scheme GetScheme() const { return m_scheme; }
+        void SetScheme(Scheme scheme) { m_scheme = scheme; }
+
+        /// Order of accuracy of a scheme
+        static size_t Order(Scheme);
+        /// Weights of the second order stages that make up a step of a scheme
+        static const std::vector<double>& Stages(Scheme);
+
+        /// Take a step using the triple jump composition to reach the given order
         template<size_t N>
         void Step(double);
 
+        /// Take a step using the scheme selected at runtime
+        ///@param time_step: The size of the step
+        void Step(double);
+
     private:
         void HamiltonianA(double);
         void HamiltonianB(double);
         void Coupling(double);
 
         double m_omega{1};
+        Scheme m_scheme{Scheme::Order2};
         PSState m_state;
         dHamiltonian m_dHdr, m_dHdp;
         std::shared_ptr<Potential> m_pot;
@@ -81,7 +112,8 @@ template<size_t order>
 void SymplecticIntegrator::Step(double time_step) {
     static_assert(order % 2 == 0, "SymplecticIntegrator: Order must be an even number");
 
-    constexpr double gamma = 1.0/(2-pow(2, 1.0/(static_cast<double>(order) + 1.0)));
+    // Composing a symmetric scheme of order n requires the weight 1/(2 - 2^(1/(n+1))), with n = order-2
+    const double gamma = 1.0/(2-pow(2, 1.0/(static_cast<double>(order) - 1.0)));
     Step<order-2>(gamma*time_step);
     Step<order-2>((1-2*gamma)*time_step);
     Step<order-2>(gamma*time_step);
@@ -89,4 +121,24 @@ void SymplecticIntegrator::Step(double time_step) {
 
 }
 
+namespace YAML {
+template<>
+struct convert<achilles::SymplecticIntegrator::Scheme> {
+    static bool decode(const Node &node, achilles::SymplecticIntegrator::Scheme &scheme) {
+        using Scheme = achilles::SymplecticIntegrator::Scheme;
+        if(node.as<std::string>() == "Order2")
+            scheme = Scheme::Order2;
+        else if(node.as<std::string>() == "ForestRuth")
+            scheme = Scheme::ForestRuth;
+        else if(node.as<std::string>() == "Suzuki")
+            scheme = Scheme::Suzuki;
+        else if(node.as<std::string>() == "Yoshida6")
+            scheme = Scheme::Yoshida6;
+        else
+            return false;
+        return true;
+    }
+};
+}
+
 #endif
@@ -0,0 +1,126 @@
+#ifndef TRANSPORT_HH
+#define TRANSPORT_HH
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+#include "Achilles/ThreeVector.hh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "yaml-cpp/yaml.h"
+#pragma GCC diagnostic pop
+
+namespace achilles {
+
+/// Settings of the parallel ensemble transport mode of the cascade. The mean field is the
+/// density dependent Skyrme-like potential U = alpha (rho/rho0) + beta (rho/rho0)^sigma,
+/// with the default parameters of the soft equation of state
+/// (G. F. Bertsch and S. Das Gupta, Phys. Rept. 160, 189 (1988))
+struct TransportParams {
+    size_t ensembles{}, threads{threads_default};
+    double spacing{spacing_default}, size{size_default};
+    double alpha{alpha_default}, beta{beta_default}, sigma{sigma_default}, rho0{rho0_default};
+
+    static constexpr size_t threads_default{1};
+    static constexpr double spacing_default{1}, size_default{12};
+    static constexpr double alpha_default{-356}, beta_default{303}, sigma_default{7.0/6.0}, rho0_default{0.16};
+
+    bool Enabled() const { return ensembles > 0; }
+
+    /// The mean field potential in MeV at a given density in fm^-3
+    double Potential(double rho) const {
+        const double x = rho/rho0;
+        return alpha*x + beta*std::pow(x, sigma);
+    }
+};
+
+/// Cubic lattice of the nucleon density, obtained from test particles with the cloud-in-cell
+/// scheme. The lattice covers [-size, size] in each direction, and particles outside of it do
+/// not contribute. The deposition and the interpolation of the forces are split over the given
+/// number of threads, and the positions are stored as separate coordinate arrays so that the
+/// arithmetic can be vectorized by the compiler. The threads and the per-thread deposition
+/// lattices are created once with the lattice, and reused for every step of the transport.
+class WorkerPool;
+
+class DensityLattice {
+    public:
+        DensityLattice();
+        DensityLattice(double, double, size_t threads=1);
+        DensityLattice(const DensityLattice&) = delete;
+        DensityLattice(DensityLattice&&) noexcept;
+        DensityLattice& operator=(const DensityLattice&) = delete;
+        DensityLattice& operator=(DensityLattice&&) noexcept;
+        ~DensityLattice();
+
+        // Utilities
+        size_t NPoints() const { return m_npoints; }
+        double Spacing() const { return m_spacing; }
+        double Size() const { return m_size; }
+
+        /// Replace the density with the one from the test particles
+        ///@param positions: The positions of the test particles in fm
+        ///@param weight: The number of nucleons represented by each test particle
+        void Deposit(const std::vector<ThreeVector>&, double);
+
+        /// The density interpolated to the given position
+        ///@param position: The position in fm
+        ///@return double: The density in fm^-3
+        double Density(const ThreeVector&) const;
+
+        /// Calculate the force -grad U(rho) at the lattice points from central differences
+        ///@param potential: The potential in MeV as a function of the density in fm^-3
+        void ComputeForces(const std::function<double(double)>&);
+
+        /// The force interpolated to the given positions
+        ///@param positions: The positions in fm
+        ///@return std::vector<ThreeVector>: The forces in MeV/fm
+        std::vector<ThreeVector> Forces(const std::vector<ThreeVector>&) const;
+
+    private:
+        struct Cell {
+            size_t index;
+            double fx, fy, fz;
+        };
+
+        bool Locate(double, double, double, Cell&) const;
+        double Interpolate(const std::vector<double>&, const Cell&) const;
+        void ParallelFor(size_t, const std::function<void(size_t, size_t, size_t)>&) const;
+        size_t Index(size_t i, size_t j, size_t k) const { return (i*m_npoints + j)*m_npoints + k; }
+
+        double m_spacing{}, m_size{};
+        size_t m_npoints{}, m_threads{1};
+        std::vector<double> m_density, m_fx, m_fy, m_fz;
+
+        // Buffers reused between the steps
+        std::unique_ptr<WorkerPool> m_pool;
+        std::vector<std::vector<double>> m_partial;
+        std::vector<double> m_xs, m_ys, m_zs, m_values;
+};
+
+}
+
+namespace YAML {
+
+template<>
+struct convert<achilles::TransportParams> {
+    static bool decode(const Node &node, achilles::TransportParams &rhs) {
+        rhs.ensembles = node["Ensembles"].as<size_t>();
+        if(node["Threads"]) rhs.threads = node["Threads"].as<size_t>();
+        if(node["Spacing"]) rhs.spacing = node["Spacing"].as<double>();
+        if(node["Size"]) rhs.size = node["Size"].as<double>();
+        if(node["Alpha"]) rhs.alpha = node["Alpha"].as<double>();
+        if(node["Beta"]) rhs.beta = node["Beta"].as<double>();
+        if(node["Sigma"]) rhs.sigma = node["Sigma"].as<double>();
+        if(node["SaturationDensity"]) rhs.rho0 = node["SaturationDensity"].as<double>();
+
+        return rhs.ensembles > 0 && rhs.threads > 0 && rhs.spacing > 0
+            && rhs.size > 2*rhs.spacing && rhs.rho0 > 0;
+    }
+};
+
+}
+
+#endif
@@ -4,9 +4,14 @@
 #include "Achilles/Statistics.hh"
 #include "Achilles/Factory.hh"
 
+#include <cstdio>
+#include <memory>
+
 namespace achilles {
 
 class Event;
+class EventWriter;
+class Nucleus;
 
 class Unweighter {
     public:
@@ -20,11 +25,33 @@ class Unweighter {
         virtual void AddEvent(const Event&) = 0;
         virtual bool AcceptEvent(Event&) = 0;
 
+        // Unweighters that need the full sample before deciding which events to keep
+        // store the events given to Spill instead of having them written directly,
+        // and hand them to the writer in Flush once the generation is finished
+        virtual bool Deferred() const { return false; }
+        virtual void Spill(const Event&, double) {}
+        virtual void Flush(EventWriter&) {}
+
         double Efficiency() const { return static_cast<double>(m_accepted) / static_cast<double>(m_total); }
         size_t Accepted() const { return m_accepted; }
+        size_t AcceptedNegative() const { return m_negative; }
+        double NegativeFraction() const {
+            return m_accepted == 0 ? 0 : static_cast<double>(m_negative) / static_cast<double>(m_accepted);
+        }
+        // Efficiency after accounting for the cancellation between positive and negative events,
+        // since N events with a negative fraction f have the statistical power of N(1-2f)^2 events
+        double EffectiveEfficiency() const {
+            const double dilution = 1 - 2*NegativeFraction();
+            return Efficiency() * dilution * dilution;
+        }
 
     protected:
-        size_t m_accepted{}, m_total{};
+        void Accept(double wgt) {
+            m_accepted++;
+            if(wgt < 0) m_negative++;
+        }
+
+        size_t m_accepted{}, m_total{}, m_negative{};
 };
 
 template<typename Derived>
@@ -35,7 +62,7 @@ class NoUnweighter : public Unweighter, RegistrableUnweighter<NoUnweighter> {
     public:
         NoUnweighter(const YAML::Node&) {}
         void AddEvent(const Event&) override {}
-        bool AcceptEvent(Event&) override { m_accepted++; m_total++; return true; }
+        bool AcceptEvent(Event&) override;
 
         // Required factory methods
         static std::unique_ptr<Unweighter> Construct(const YAML::Node &node) {
@@ -58,6 +85,51 @@ class PercentileUnweighter : public Unweighter, RegistrableUnweighter<Percentile
         Percentile m_percentile;
 };
 
+/// Unweights to the exact maximum weight of the generated sample. The events are stored with
+/// their full weight in a compact temporary file during the generation. Once the maximum is
+/// known, the file is read back one event at a time and every event is accepted with a
+/// probability of |w|/max_wgt, resulting in events with weights of exactly +/- max_wgt.
+/// Since the final number of events is only known after the second pass, the requested number
+/// of events is used as the expected number of accepted events during the generation. The
+/// realizations of an oversampled event are accepted together with the sum of their absolute
+/// weights, and share the accepted weight in proportion to their own weights.
+class ExactUnweighter : public Unweighter, RegistrableUnweighter<ExactUnweighter> {
+    public:
+        ExactUnweighter(const YAML::Node&);
+        ExactUnweighter(const ExactUnweighter&) = delete;
+        ExactUnweighter(ExactUnweighter&&) = default;
+        ExactUnweighter& operator=(const ExactUnweighter&) = delete;
+        ExactUnweighter& operator=(ExactUnweighter&&) = default;
+        ~ExactUnweighter() override = default;
+
+        void AddEvent(const Event&) override {}
+        bool AcceptEvent(Event&) override;
+
+        bool Deferred() const override { return true; }
+        /// Store an event in the spill file
+        ///@param event: The event with the weight to be written out
+        ///@param bias: The phase space bias, the event is unweighted according to weight*bias
+        void Spill(const Event&, double) override;
+        void Flush(EventWriter&) override;
+
+        double MaxWeight() const { return m_max; }
+        size_t Spilled() const { return m_spilled; }
+
+        // Required factory methods
+        static std::unique_ptr<Unweighter> Construct(const YAML::Node&);
+        static std::string Name() { return "Exact"; }
+
+    private:
+        struct FileCloser {
+            void operator()(std::FILE *file) const { std::fclose(file); }
+        };
+
+        std::unique_ptr<std::FILE, FileCloser> m_spill;
+        std::shared_ptr<Nucleus> m_nucleus{};
+        double m_max{}, m_sum{};
+        size_t m_spilled{}, m_flushed{}, m_flushedNegative{};
+};
+
 }
 
 #endif
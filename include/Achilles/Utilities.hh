@@ -225,6 +225,19 @@ T Sign(const T &a) {
   return a > 0 ? 1 : ( a < 0 ? -1 : 0 );
 }
 
+// Totally antisymmetric tensor with upper indices, epsilon^{0123} = +1
+inline double LeviCivita(size_t mu, size_t nu, size_t alpha, size_t beta) {
+    const std::array<size_t, 4> idx{mu, nu, alpha, beta};
+    double sign = 1;
+    for(size_t i = 0; i < 4; ++i) {
+        for(size_t j = i+1; j < 4; ++j) {
+            if(idx[i] == idx[j]) return 0;
+            if(idx[i] > idx[j]) sign = -sign;
+        }
+    }
+    return sign;
+}
+
 }
 
 #endif // end of include guard: UTILITIES_HH
@@ -14,6 +14,7 @@
 #include <vector>
 
 #include "Achilles/AdaptiveMap.hh"
+#include "Achilles/QuasiRandom.hh"
 #include "Achilles/Statistics.hh"
 #include "Achilles/Random.hh"
 
@@ -80,6 +81,8 @@ class Vegas {
         }
         AdaptiveMap Grid() const { return grid; }
         AdaptiveMap &Grid() { return grid; }
+        const QuasiRandom& Sampling() const { return sampling; }
+        void SetSampling(QuasiRandom _sampling) { sampling = std::move(_sampling); }
         // bool Serialize(std::ostream &out) const {
         //     
         // }
@@ -105,6 +108,7 @@ class Vegas {
         AdaptiveMap grid;
         VegasSummary summary;
         VegasParams params{};
+        QuasiRandom sampling{};
         Verbosity verbosity{Verbosity::normal};
 };
 
@@ -0,0 +1,38 @@
+#ifndef HEPMC3_EVENT_MERGER_HH
+#define HEPMC3_EVENT_MERGER_HH
+
+#include "Achilles/EventMerger.hh"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+#include "HepMC3/WriterAscii.h"
+#pragma GCC diagnostic pop
+
+namespace achilles {
+
+/// Merge samples written in the HepMC3 format. Events with zero weight are not written to
+/// this format, so the number of trials is taken from the GenCrossSection of the last event.
+/// The realizations of an oversampled event share the event number of their primary event,
+/// which is kept when the primary events are renumbered.
+class HepMC3Merger : public EventMerger {
+    public:
+        HepMC3Merger(std::vector<std::string> inputs, bool reunweight=true, bool zipped=true)
+            : EventMerger(std::move(inputs), reunweight), m_zipped{zipped} {}
+
+    private:
+        SampleSummary Scan(const std::string&) const override;
+        void Open(const std::string&) override;
+        void Copy(const SampleSummary&) override;
+        void Close() override;
+
+        bool m_zipped;
+        std::unique_ptr<HepMC3::WriterAscii> m_writer{};
+        // The number of primary events written
+        int m_nevents{};
+};
+
+}
+
+#endif
@@ -26,6 +26,7 @@ class HepMC3Writer : public EventWriter {
         static std::shared_ptr<std::ostream> InitializeStream(const std::string&, bool);
         HepMC3::WriterAscii file;
         achilles::StatsData results;
+        double primaryWeight{};
 };
 
 }
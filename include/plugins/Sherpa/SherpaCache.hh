@@ -0,0 +1,59 @@
+#ifndef achilles__plugins__SherpaCache_hh
+#define achilles__plugins__SherpaCache_hh
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace PHASIC { struct ChannelNode; }
+
+namespace achilles {
+
+/// Cache of the process information obtained from Sherpa, i.e. the momentum map and the
+/// topologies of the phase space channels. The cache is stored as a YAML file in the given
+/// directory, with a name derived from a hash of all the inputs (model, parameter card,
+/// process and Sherpa arguments). Changing any of the inputs results in a different file,
+/// so stale entries are never used. The same directory is used as the Sherpa process path,
+/// which allows Comix to reuse the process libraries it generated in earlier runs.
+class SherpaCache {
+    public:
+        using Topology = std::shared_ptr<PHASIC::ChannelNode>;
+
+        SherpaCache(std::string directory, std::vector<std::string> inputs);
+
+        /// Load the cache from disk
+        ///@return bool: True if a cache with matching inputs was found
+        bool Load();
+
+        /// Write the current contents of the cache to disk
+        void Save() const;
+
+        const std::string& Directory() const { return m_directory; }
+        std::string Filename() const;
+        uint64_t Key() const { return m_key; }
+
+        /// Read the contents of a file to be used as an input of the cache
+        ///@param filename: The file to read
+        ///@return std::string: The contents of the file
+        static std::string FileContents(const std::string &filename);
+
+        /// Stable 64-bit FNV-1a hash of the inputs
+        static uint64_t Hash(const std::vector<std::string>&);
+
+        // Cached data
+        std::map<size_t, long> momentum_map{};
+        std::vector<double> masses{};
+        std::vector<Topology> topologies{};
+
+    private:
+        static constexpr int version = 1;
+        std::string m_directory;
+        std::vector<std::string> m_inputs;
+        uint64_t m_key;
+};
+
+}
+
+#endif
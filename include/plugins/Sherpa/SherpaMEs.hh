@@ -13,6 +13,7 @@ namespace ATOOLS { class Cluster_Amplitude; }
 namespace PHASIC { 
     class Process_Base;
     class Channels;
+    struct ChannelNode;
 }
 namespace SHERPA { class Sherpa; }
 
@@ -43,6 +44,10 @@ public:
   bool InitializeProcess(const Process_Info &info);
 
   std::vector<std::unique_ptr<PHASIC::Channels>> GenerateChannels(const std::vector<long> &fl) const;
+  std::vector<std::shared_ptr<PHASIC::ChannelNode>> GenerateTopologies(const std::vector<long> &fl,
+                                                                       std::vector<double> &s) const;
+  static std::vector<std::unique_ptr<PHASIC::Channels>> BuildChannels
+  (const std::vector<std::shared_ptr<PHASIC::ChannelNode>> &topologies, const std::vector<double> &s);
   std::map<size_t, long> MomentumMap(const std::vector<long> &fl) const;
 
   MOCK LeptonCurrents Calc
@@ -1,9 +1,14 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <random>
 #include <iostream>
+#include <limits>
 #include <string>
 #include <map>
 #include <vector>
 
+#include "fmt/format.h"
 #include "spdlog/spdlog.h"
 
 #include "Achilles/Constants.hh"
@@ -18,6 +23,124 @@
 
 using namespace achilles;
 
+namespace {
+
+bool IsFinite(const Particle &particle) {
+    const auto &mom = particle.Momentum();
+    const auto &pos = particle.Position();
+    return std::isfinite(mom.E()) && std::isfinite(mom.Px()) && std::isfinite(mom.Py())
+        && std::isfinite(mom.Pz()) && std::isfinite(pos.X()) && std::isfinite(pos.Y())
+        && std::isfinite(pos.Z());
+}
+
+double TotalEnergy(const Particles &particles) {
+    double energy = 0;
+    for(const auto &particle : particles) energy += particle.Momentum().E();
+    return energy;
+}
+
+}
+
+ClosestApproach achilles::CovariantClosestApproach(const Particle &particle1, const Particle &particle2) {
+    // Boost the momenta and the positions at the current lab time to the center of mass frame
+    const ThreeVector beta = (particle1.Momentum() + particle2.Momentum()).BoostVector();
+    const FourVector p1 = particle1.Momentum().Boost(-beta);
+    const FourVector p2 = particle2.Momentum().Boost(-beta);
+    const FourVector x1 = FourVector(particle1.Position(), 0).Boost(-beta);
+    const FourVector x2 = FourVector(particle2.Position(), 0).Boost(-beta);
+    const ThreeVector v1 = p1.Vec3()/p1.E();
+    const ThreeVector v2 = p2.Vec3()/p2.E();
+
+    // The events are not simultaneous in the center of mass frame, so the second particle is
+    // moved to the time of the first
+    const ThreeVector dx = x1.Vec3() - (x2.Vec3() + v2*(x1.E() - x2.E()));
+    const ThreeVector dv = v1 - v2;
+    const double dv2 = dv.Magnitude2();
+    if(dv2 == 0) return {dx.Magnitude2(), std::numeric_limits<double>::infinity()};
+
+    const double tau = -dx.Dot(dv)/dv2;
+    const ThreeVector b = dx + dv*tau;
+    const FourVector collision = FourVector(x1.Vec3() + v1*tau, x1.E() + tau).Boost(beta);
+    return {b.Magnitude2(), collision.E()};
+}
+
+void CascadeWatchdog::Record(Reason reason, size_t event) {
+    const auto idx = static_cast<size_t>(reason);
+    m_counts[idx]++;
+    if(m_examples[idx].size() < max_examples) m_examples[idx].push_back(event);
+}
+
+size_t CascadeWatchdog::Total() const {
+    size_t total = 0;
+    for(size_t i = 1; i < nreasons; ++i) total += m_counts[i];
+    return total;
+}
+
+std::string CascadeWatchdog::Name(Reason reason) {
+    switch(reason) {
+        case Reason::None:
+            return "None";
+        case Reason::MaxSteps:
+            return "MaxSteps";
+        case Reason::WallTime:
+            return "WallTime";
+        case Reason::NaN:
+            return "NaN";
+        case Reason::EnergyViolation:
+            return "EnergyViolation";
+    }
+    return "Unknown";
+}
+
+std::string CascadeWatchdog::Name(Policy policy) {
+    switch(policy) {
+        case Policy::Drop:
+            return "Drop";
+        case Policy::Retry:
+            return "Retry";
+        case Policy::Flag:
+            return "Flag";
+    }
+    return "Unknown";
+}
+
+double CascadeBiasing::Scale(PID pid1, PID pid2) const {
+    if(pid2 < pid1) std::swap(pid1, pid2);
+    auto it = channel_scales.find({pid1, pid2});
+    return it == channel_scales.end() ? scale : it -> second;
+}
+
+double CascadeBiasing::Probability(double prob, PID pid1, PID pid2, bool first) const {
+    // Never sample interactions that can not occur, since they would carry zero weight
+    if(prob <= 0 || prob >= 1) return prob;
+
+    // The biased probability is kept below one, so that the non-interacting history can
+    // still be sampled and the weight correction stays finite
+    double biased = std::min(Scale(pid1, pid2)*prob, std::max(prob, max_prob));
+    if(first) biased += force_first*(1 - biased);
+    return biased;
+}
+
+bool CascadeBiasing::Accept(double prob, PID pid1, PID pid2, bool first, double &weight) const {
+    const double biased = Probability(prob, pid1, pid2, first);
+    if(Random::Instance().Uniform(0.0, 1.0) < biased) {
+        weight *= prob/biased;
+        return true;
+    }
+    weight *= (1 - prob)/(1 - biased);
+    return false;
+}
+
+bool CascadeBiasing::Roulette(double &weight) const {
+    if(weight >= roulette) return true;
+    if(Random::Instance().Uniform(0.0, 1.0) < weight/roulette) {
+        weight = roulette;
+        return true;
+    }
+    weight = 0;
+    return false;
+}
+
 Cascade::Cascade(std::unique_ptr<Interactions> interactions,
                  const ProbabilityType& prob,
                  const InMedium& medium,
@@ -134,7 +257,8 @@ std::size_t Cascade::GetInter(Particles &particles, const Particle &kickedPart,
         rhoDiff = localNucleus -> Rho(position)*2*static_cast<double>(index_diff.size())/static_cast<double>(particles.size());
     }
     if(rhoSame <= 0.0 && rhoDiff <= 0.0) return SIZE_MAX;
-    double lambda_tilde = 1.0 / (xsecSame / 10 * rhoSame + xsecDiff / 10 * rhoDiff);
+    const double formation = FormationSuppression(kickedPart);
+    double lambda_tilde = 1.0 / (formation*(xsecSame / 10 * rhoSame + xsecDiff / 10 * rhoDiff));
     double lambda = -log(Random::Instance().Uniform(0.0, 1.0))*lambda_tilde;
 
     if(lambda > stepDistance) return SIZE_MAX;
@@ -153,22 +277,104 @@ std::size_t Cascade::GetInter(Particles &particles, const Particle &kickedPart,
 void Cascade::Reset() {
     kickedIdxs.resize(0);
     integrators.clear();
+    m_nensembles = 1;
+}
+
+void Cascade::SetTransport(TransportParams transport) {
+    if(m_potential_prop)
+        throw std::runtime_error("Cascade: The transport mode calculates its own mean field, "
+                                 "and can not be combined with the propagation in the potential");
+    m_transport = std::move(transport);
+    m_lattice = DensityLattice(m_transport.spacing, m_transport.size, m_transport.threads);
+}
+
+/// Append the copies of the event for the parallel ensembles. Each copy has a new configuration
+/// of the spectator nucleons, in which the propagating particles replace the closest nucleons
+void Cascade::AddEnsembles(Particles &particles) {
+    const Particles original = particles;
+    for(std::size_t i = 1; i < m_transport.ensembles; ++i) {
+        localNucleus -> ResampleConfig(original);
+        const auto &ensemble = localNucleus -> Nucleons();
+        for(std::size_t j = 0; j < ensemble.size(); ++j) {
+            if(ensemble[j].Status() == ParticleStatus::propagating) SetKicked(particles.size() + j);
+        }
+        particles.insert(particles.end(), ensemble.begin(), ensemble.end());
+    }
+    m_nensembles = m_transport.ensembles;
+
+    // Leave the nucleus untouched in case the evolution is aborted
+    Particles nucleons = original;
+    localNucleus -> SetNucleons(nucleons);
+}
+
+/// Move all test particles in the mean field of the density of the ensembles. The spectator
+/// nucleons are propagated here, while the propagating particles were already moved in the
+/// search for collisions, so that only their momenta are updated
+void Cascade::MeanFieldStep(Particles &particles) {
+    std::vector<std::size_t> indices;
+    std::vector<ThreeVector> positions;
+    for(std::size_t i = 0; i < particles.size(); ++i) {
+        auto &particle = particles[i];
+        if(particle.Status() == ParticleStatus::background) particle.Propagate(timeStep);
+        else if(particle.Status() != ParticleStatus::propagating) continue;
+        indices.push_back(i);
+        positions.push_back(particle.Position());
+    }
+
+    m_lattice.Deposit(positions, 1.0/static_cast<double>(m_nensembles));
+    m_lattice.ComputeForces([&](double rho) { return m_transport.Potential(rho); });
+    const auto forces = m_lattice.Forces(positions);
+    const double dt = timeStep*Constant::HBARC;
+    for(std::size_t i = 0; i < indices.size(); ++i) {
+        auto &particle = particles[indices[i]];
+        const ThreeVector momentum = particle.Momentum().Vec3() + forces[i]*dt;
+        particle.SetMomentum({momentum, std::sqrt(momentum.P2() + pow(particle.Mass(), 2))});
+    }
 }
 
 void Cascade::Evolve(achilles::Event *event, const std::size_t &maxSteps) {
+    // The hadrons leaving the hard scattering are formed from the initial state hadrons in
+    // order, and any additional hadrons from the last of them
+    std::vector<FourVector> initial;
+    for(const auto &hadron : event -> Hadrons()) {
+        if(hadron.Status() == ParticleStatus::initial_state) initial.push_back(hadron.Momentum());
+    }
+
     // Set all propagating particles as kicked for the cascade
+    size_t nformed = 0;
     for(size_t idx = 0; idx < event -> Hadrons().size(); ++idx) {
-        if(event->Hadrons()[idx].Status() == ParticleStatus::propagating)
-            SetKicked(idx);
+        auto &hadron = event -> Hadrons()[idx];
+        if(hadron.Status() != ParticleStatus::propagating) continue;
+        SetKicked(idx);
+        if(!initial.empty()) FormPrimary(hadron, initial[std::min(nformed++, initial.size() - 1)]);
     }
 
     // Run the normal cascade
     Evolve(event->CurrentNucleus(), maxSteps);
+
+    // Correct the event weight for the biasing of the cascade
+    if(m_biasing.Enabled()) {
+        event -> BiasWeight() *= m_bias_weight;
+        event -> Weight() *= m_bias_weight;
+    }
 }
 
 void Cascade::Evolve(std::shared_ptr<Nucleus> nucleus, const std::size_t& maxSteps) {
     localNucleus = nucleus;
     Particles particles = nucleus -> Nucleons();
+    m_bias_weight = 1;
+    m_nhits = 0;
+    m_nclusters = 0;
+    m_ensemble_size = particles.size();
+    const auto start = std::chrono::steady_clock::now();
+    const double initial_energy = TotalEnergy(particles);
+    if(m_transport.Enabled()) AddEnsembles(particles);
+    auto abort = [&](CascadeWatchdog::Reason reason, const std::string &msg) {
+        spdlog::debug("Cascade aborted ({}): {}", CascadeWatchdog::Name(reason), msg);
+        for(const auto &p : particles) spdlog::debug("{}", p);
+        Reset();
+        throw CascadeAbort(reason, msg);
+    };
     // Initialize symplectic integrators
     std::vector<size_t> notCaptured{};
     for(auto idx : kickedIdxs) {
@@ -183,10 +389,18 @@ void Cascade::Evolve(std::shared_ptr<Nucleus> nucleus, const std::size_t& maxSte
     }
     kickedIdxs = notCaptured;
 
-    for(std::size_t step = 0; step < maxSteps; ++step) {
+    const std::size_t nsteps = std::min(maxSteps, m_watchdog.max_steps);
+    for(std::size_t step = 0; step < nsteps; ++step) {
         // Stop loop if no particles are propagating
         if(kickedIdxs.size() == 0) break;
 
+        if(m_watchdog.max_time > 0) {
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if(elapsed.count() > m_watchdog.max_time)
+                abort(CascadeWatchdog::Reason::WallTime,
+                      fmt::format("Cascade has failed. Exceeded the time budget after {} steps.", step));
+        }
+
         // Adapt time step
         AdaptiveStep(particles, distance);
 
@@ -197,13 +411,21 @@ void Cascade::Evolve(std::shared_ptr<Nucleus> nucleus, const std::size_t& maxSte
             spdlog::debug("Kicked ID: {}, Particle: {}", idx, *kickNuc);
 
             // Update formation zones
-            if(kickNuc -> InFormationZone()) {
+            if(FormationBlocked(*kickNuc)) {
                 kickNuc -> UpdateFormationZone(timeStep);
                 kickNuc -> Propagate(timeStep);
                 newKicked.push_back(idx);
                 continue;
             }
 
+            if(m_criterion == CollisionCriterion::Covariant) {
+                CovariantStep(particles, idx, newKicked);
+                continue;
+            }
+
+            // Hadrons that interact during their formation are tested at the end of the step
+            if(kickNuc -> InFormationZone()) kickNuc -> UpdateFormationZone(timeStep);
+
             // Get allowed interactions
             auto dist2 = AllowedInteractions(particles, idx);
             if(dist2.size() == 0) {
@@ -224,6 +446,7 @@ void Cascade::Evolve(std::shared_ptr<Nucleus> nucleus, const std::size_t& maxSte
             UpdateIntegrator(idx, kickNuc);
 
             if(hit) {
+                if(idx < m_ensemble_size) ++m_nhits;
                 if(m_potential_prop
                    && localNucleus -> GetPotential() -> Hamiltonian(kickNuc -> Momentum().P(),
                                                                     kickNuc -> Position().P()) < Constant::mN) {
@@ -249,19 +472,35 @@ void Cascade::Evolve(std::shared_ptr<Nucleus> nucleus, const std::size_t& maxSte
 
         // Replace kicked indices with new list
         kickedIdxs = newKicked;
+        if(m_transport.Enabled()) MeanFieldStep(particles);
+
+        for(auto idx : kickedIdxs) {
+            if(!IsFinite(particles[idx]))
+                abort(CascadeWatchdog::Reason::NaN, "Cascade has failed. Non-finite particle kinematics.");
+        }
 
         // After step checks
         Escaped(particles);
+        RussianRoulette(particles);
     }
 
-    for(auto particle : particles) {
-        if(particle.Status() == ParticleStatus::propagating) {
-            std::cout << "\n";
-            for(auto p : particles) spdlog::error("{}", p);
-            throw std::runtime_error("Cascade has failed. Insufficient max steps.");
-        }
+    for(const auto &particle : particles) {
+        if(particle.Status() == ParticleStatus::propagating)
+            abort(CascadeWatchdog::Reason::MaxSteps, "Cascade has failed. Insufficient max steps.");
+    }
+
+    // Only the original copy of the event is kept in the transport mode
+    particles.resize(m_ensemble_size);
+    if(m_watchdog.energy_tolerance > 0) {
+        const double violation = std::abs(TotalEnergy(particles) - initial_energy);
+        if(violation > m_watchdog.energy_tolerance)
+            abort(CascadeWatchdog::Reason::EnergyViolation,
+                  fmt::format("Cascade has failed. Energy violated by {} MeV.", violation));
     }
 
+    // The binding energy of the clusters is left to the remnant, so this follows the energy check
+    if(m_coalescence) m_nclusters = m_coalescence -> Form(particles, nucleus -> Radius());
+
     nucleus -> Nucleons() = particles;
     Reset();
 }
@@ -270,12 +509,12 @@ void Cascade::AddIntegrator(size_t idx, const Particle &part) {
     static constexpr double omega = 20;
     auto dHamiltonian_dr = [&](const ThreeVector &q, const ThreeVector &p, std::shared_ptr<Potential> potential) {
         auto vals = potential -> operator()(p.P(), q.P());
-        auto dpot_dp = potential -> derivative_p(p.P(), q.P());
+        auto dpot_dr = potential -> derivative_r(p.P(), q.P());
 
         auto mass_eff = achilles::Constant::mN + vals.rscalar + std::complex<double>(0, 1)*vals.iscalar;
-        double numerator = (vals.rscalar + achilles::Constant::mN)*dpot_dp.rscalar + p.P();
+        double numerator = (vals.rscalar + achilles::Constant::mN)*dpot_dr.rscalar;
         double denominator = sqrt(pow(mass_eff, 2) + p.P2()).real();
-        return numerator/denominator * p/p.P() + dpot_dp.rvector * p/p.P();
+        return numerator/denominator * q/q.P() + dpot_dr.rvector * q/q.P();
     };
     auto dHamiltonian_dp = [&](const ThreeVector &q, const ThreeVector &p, std::shared_ptr<Potential> potential) {
         auto vals = potential -> operator()(p.P(), q.P());
@@ -289,7 +528,7 @@ void Cascade::AddIntegrator(size_t idx, const Particle &part) {
     integrators[idx] = SymplecticIntegrator(part.Position(), part.Momentum().Vec3(),
                                             localNucleus -> GetPotential(),
                                             dHamiltonian_dr, dHamiltonian_dp,
-                                            omega);
+                                            omega, m_integrator_scheme);
 }
 
 void Cascade::UpdateIntegrator(size_t idx, Particle *kickNuc) {
@@ -300,7 +539,7 @@ void Cascade::UpdateIntegrator(size_t idx, Particle *kickNuc) {
 void Cascade::Propagate(size_t idx, Particle *kickNuc, double step) {
     timeStep = step/(kickNuc -> Beta().Magnitude());
     if(m_potential_prop) {
-        integrators[idx].Step<2>(timeStep);
+        integrators[idx].Step(timeStep);
         double energy = sqrt(pow(kickNuc -> Info().Mass(), 2) + integrators[idx].P().P2());
         FourVector mom{integrators[idx].P(), energy};
         kickNuc -> SetMomentum(mom);
@@ -345,7 +584,7 @@ void Cascade::NuWro(std::shared_ptr<Nucleus> nucleus, const std::size_t& maxStep
             Particle* kickNuc = &particles[idx];
 
             // Update formation zones
-            if(kickNuc -> InFormationZone()) {
+            if(FormationBlocked(*kickNuc)) {
                 Propagate(idx, kickNuc, distance);
                 kickNuc -> UpdateFormationZone(timeStep);
                 newKicked.push_back(idx);
@@ -354,6 +593,9 @@ void Cascade::NuWro(std::shared_ptr<Nucleus> nucleus, const std::size_t& maxStep
 
             double step_prop = distance;
             auto hitIdx = GetInter(particles, *kickNuc, step_prop);
+            // Same time as in the propagation of the step
+            if(kickNuc -> InFormationZone())
+                kickNuc -> UpdateFormationZone(step_prop/kickNuc -> Beta().Magnitude());
             if (hitIdx == SIZE_MAX) {
                 Propagate(idx, kickNuc, step_prop);
                 newKicked.push_back(idx);
@@ -427,11 +669,12 @@ void Cascade::MeanFreePath(std::shared_ptr<Nucleus> nucleus, const std::size_t&
     for(std::size_t step = 0; step < maxSteps; ++step) {
         AdaptiveStep(particles, distance);
 
-        if(kickNuc -> InFormationZone()) {
+        if(FormationBlocked(*kickNuc)) {
             kickNuc -> UpdateFormationZone(timeStep);
             kickNuc -> Propagate(timeStep);
             continue;
         }
+        if(kickNuc -> InFormationZone()) kickNuc -> UpdateFormationZone(timeStep);
 
         // Are we already outside nucleus?
         if (kickNuc -> Position().Magnitude() >= nucleus -> Radius()) {
@@ -540,6 +783,16 @@ void Cascade::Escaped(Particles &particles) {
     }
 }
 
+/// Terminate histories whose weight dropped below the roulette threshold. The event carries
+/// zero weight afterwards, so the remaining particles are simply marked as final state.
+void Cascade::RussianRoulette(Particles &particles) {
+    if(m_biasing.roulette <= 0 || m_biasing.Roulette(m_bias_weight)) return;
+
+    spdlog::debug("Cascade history terminated by Russian roulette");
+    for(auto idx : kickedIdxs) particles[idx].Status() = ParticleStatus::final_state;
+    kickedIdxs.clear();
+}
+
 /// Convert a time step in [fm] to [1/MeV].
 /// timeStep = distance / max("betas of all kicked particles") / hbarc
 void Cascade::AdaptiveStep(const Particles& particles, const double& stepDistance) noexcept {
@@ -604,6 +857,7 @@ const InteractionDistances Cascade::AllowedInteractions(Particles& particles,
         // TODO: Should particles propagating be able to interact with
         //       other propagating particles?
         if (particles[i].Status() != ParticleStatus::background) continue;
+        if(!SameEnsemble(i, idx)) continue;
         //if(i == idx) continue;
         // if(particles[i].InFormationZone()) continue;
         if(!BetweenPlanes(particles[i].Position(), point1, point2)) continue;
@@ -620,6 +874,101 @@ const InteractionDistances Cascade::AllowedInteractions(Particles& particles,
     return results;
 }
 
+/// Get the background nucleons the particle reaches the closest approach with in the lab
+/// time interval (tmin, tmax], sorted by the time of the closest approach. The times are in fm,
+/// relative to the start of the time step
+std::vector<std::pair<std::size_t, ClosestApproach>> Cascade::CovariantInteractions(
+        const Particles &particles, const std::size_t &idx, double tmin, double tmax,
+        std::size_t skip) const {
+    std::vector<std::pair<std::size_t, ClosestApproach>> results;
+    for(std::size_t i = 0; i < particles.size(); ++i) {
+        if(particles[i].Status() != ParticleStatus::background || i == skip) continue;
+        if(!SameEnsemble(i, idx)) continue;
+        auto approach = CovariantClosestApproach(particles[idx], particles[i]);
+        approach.time += tmin;
+        if(approach.time <= tmin || approach.time > tmax) continue;
+        results.emplace_back(i, approach);
+    }
+
+    std::sort(results.begin(), results.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.second.time < rhs.second.time;
+    });
+    return results;
+}
+
+/// Propagate a particle through a time step with the covariant collision criterion. The
+/// collisions are tried in the order of their lab frame time, and the particle is propagated
+/// to each collision that occurs, after which the search continues with the new momentum.
+/// Particles that can not interact in their formation zone, and the struck nucleons, are
+/// propagated to the end of the step, so that all particles stay synchronized
+void Cascade::CovariantStep(Particles &particles, std::size_t idx, std::vector<std::size_t> &newKicked) {
+    const double step = timeStep*Constant::HBARC;
+    double elapsed = 0;
+    auto advance = [](Particle *particle, double time) {
+        if(particle -> InFormationZone()) particle -> UpdateFormationZone(time);
+        particle -> Propagate(time);
+    };
+    auto finishStep = [&](Particle *particle) { advance(particle, (step - elapsed)/Constant::HBARC); };
+
+    std::size_t last = SIZE_MAX;
+    while(true) {
+        Particle* kickNuc = &particles[idx];
+        if(FormationBlocked(*kickNuc)) {
+            finishStep(kickNuc);
+            newKicked.push_back(idx);
+            return;
+        }
+
+        const auto candidates = CovariantInteractions(particles, idx, elapsed, step, last);
+        InteractionDistances dist2;
+        for(const auto &candidate : candidates) dist2.emplace_back(candidate.first, candidate.second.b2);
+        const auto hitIdx = dist2.empty() ? SIZE_MAX : Interacted(particles, *kickNuc, dist2);
+        if(hitIdx == SIZE_MAX) {
+            finishStep(kickNuc);
+            newKicked.push_back(idx);
+            return;
+        }
+
+        const auto it = std::find_if(candidates.begin(), candidates.end(),
+                                     [&](const auto &candidate) { return candidate.first == hitIdx; });
+        advance(kickNuc, (it -> second.time - elapsed)/Constant::HBARC);
+        elapsed = it -> second.time;
+        last = hitIdx;
+
+        Particle* hitNuc = &particles[hitIdx];
+        bool hit = FinalizeMomentum(*kickNuc, *hitNuc);
+        UpdateIntegrator(idx, kickNuc);
+        if(!hit) continue;
+
+        if(idx < m_ensemble_size) ++m_nhits;
+        if(m_potential_prop
+           && localNucleus -> GetPotential() -> Hamiltonian(hitNuc -> Momentum().P(),
+                                                            hitNuc -> Position().P()) < Constant::mN) {
+            hitNuc -> Status() = ParticleStatus::captured;
+        } else {
+            finishStep(hitNuc);
+            newKicked.push_back(hitIdx);
+            AddIntegrator(hitIdx, *hitNuc);
+            hitNuc -> Status() = ParticleStatus::propagating;
+        }
+        if(m_potential_prop
+           && localNucleus -> GetPotential() -> Hamiltonian(kickNuc -> Momentum().P(),
+                                                            kickNuc -> Position().P()) < Constant::mN) {
+            kickNuc -> Status() = ParticleStatus::captured;
+            return;
+        }
+    }
+}
+
+/// Fraction of the cross section of a particle, which is reduced in the formation zone
+double Cascade::FormationSuppression(const Particle &particle) const {
+    return particle.InFormationZone() ? m_formation -> Suppression(particle) : 1;
+}
+
+bool Cascade::FormationBlocked(const Particle &particle) const {
+    return particle.InFormationZone() && FormationSuppression(particle) <= 0;
+}
+
 double Cascade::GetXSec(const Particle& particle1, const Particle& particle2) const {
     auto p1 = particle1.Momentum();
     auto p2 = particle2.Momentum();
@@ -643,12 +992,18 @@ std::size_t Cascade::Interacted(const Particles& particles, const Particle& kick
                                 const InteractionDistances& dists) noexcept {
     for(auto dist : dists) {
         // Cross section in mb
-        const double xsec = GetXSec(kickedParticle, particles[dist.first]);
+        const double xsec = GetXSec(kickedParticle, particles[dist.first])*FormationSuppression(kickedParticle);
         // 1 barn = 100 fm^2, so 1 mb = 0.1 fm^2.
         // Thus: (xsec [mb]) x (0.1 [fm^2]/ 1 [mb]) = 0.1 xsec [fm^2]
         // dist.second is fm^2; factor of 10 converts mb to fm^2
         const double prob = probability(dist.second, xsec/10);
-        if(Random::Instance().Uniform(0.0, 1.0) < prob) return dist.first;
+        if(m_biasing.Enabled()) {
+            if(m_biasing.Accept(prob, kickedParticle.ID(), particles[dist.first].ID(),
+                                m_nhits == 0, m_bias_weight))
+                return dist.first;
+        } else if(Random::Instance().Uniform(0.0, 1.0) < prob) {
+            return dist.first;
+        }
     }
 
     return SIZE_MAX;
@@ -667,8 +1022,8 @@ bool Cascade::FinalizeMomentum(Particle& particle1, Particle& particle2) noexcep
 
     if(hit) {
         // Assign formation zone
-        particle1.SetFormationZone(p1Lab, pOut.first);
-        particle2.SetFormationZone(p2Lab, pOut.second);
+        FormHadron(particle1, p1Lab);
+        FormHadron(particle2, p2Lab);
 
         // Hit nucleon is now propagating
         // Users are responsibile for updating the status externally as desired
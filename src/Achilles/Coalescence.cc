@@ -0,0 +1,138 @@
+#include "Achilles/Coalescence.hh"
+#include "Achilles/Particle.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+using achilles::Coalescence;
+using achilles::PID;
+
+Coalescence::Coalescence(CoalescenceParams params) : m_params{std::move(params)} {
+    if(m_params.radius <= 0 || m_params.momentum <= 0)
+        throw std::runtime_error("Coalescence: The coalescence radius and momentum must be positive");
+    if(m_params.surface < 0)
+        throw std::runtime_error("Coalescence: The surface depth can not be negative");
+    if(m_params.max_size < 2 || m_params.max_size > 4)
+        throw std::runtime_error("Coalescence: Clusters must have between 2 and 4 nucleons");
+}
+
+PID Coalescence::Cluster(std::size_t nprotons, std::size_t nneutrons) {
+    if(nprotons == 1 && nneutrons == 1) return PID::deuteron();
+    if(nprotons == 1 && nneutrons == 2) return PID::triton();
+    if(nprotons == 2 && nneutrons == 1) return PID::helium3();
+    if(nprotons == 2 && nneutrons == 2) return PID::alpha();
+    return PID::undefined();
+}
+
+Coalescence::Cell Coalescence::Locate(const ThreeVector &position) const {
+    return {static_cast<int64_t>(std::floor(position[0]/m_params.radius)),
+            static_cast<int64_t>(std::floor(position[1]/m_params.radius)),
+            static_cast<int64_t>(std::floor(position[2]/m_params.radius))};
+}
+
+// Add the closest nucleon in phase space until no nucleon passes the criteria. The cell size
+// equals the coalescence radius, so the nucleons within the radius of the centroid are in the
+// neighbouring cells of the one containing it
+std::vector<std::size_t> Coalescence::Grow(const Particles &particles, const Grid &grid, std::size_t seed,
+                                           const std::vector<bool> &used) const {
+    std::vector<std::size_t> members{seed};
+    std::size_t nprotons = particles[seed].ID() == PID::proton() ? 1 : 0;
+    std::size_t nneutrons = 1 - nprotons;
+    FourVector total = particles[seed].Momentum();
+    ThreeVector centroid = particles[seed].Position();
+
+    while(members.size() < m_params.max_size) {
+        const Cell center = Locate(centroid);
+        std::size_t best = SIZE_MAX;
+        double best_distance = std::numeric_limits<double>::max();
+        for(int64_t dx = -1; dx <= 1; ++dx) {
+            for(int64_t dy = -1; dy <= 1; ++dy) {
+                for(int64_t dz = -1; dz <= 1; ++dz) {
+                    const auto cell = grid.find({center[0] + dx, center[1] + dy, center[2] + dz});
+                    if(cell == grid.end()) continue;
+                    for(const auto idx : cell -> second) {
+                        if(used[idx] || std::find(members.begin(), members.end(), idx) != members.end()) continue;
+                        const bool proton = particles[idx].ID() == PID::proton();
+                        if(Cluster(nprotons + proton, nneutrons + !proton) == PID::undefined()) continue;
+
+                        const double dr = (particles[idx].Position() - centroid).Magnitude();
+                        if(dr > m_params.radius) continue;
+                        // Momentum in the rest frame of the cluster the nucleon would form
+                        const ThreeVector beta = (total + particles[idx].Momentum()).BoostVector();
+                        const double dp = particles[idx].Momentum().Boost(-beta).P();
+                        if(dp > m_params.momentum) continue;
+
+                        const double distance = std::pow(dr/m_params.radius, 2)
+                                              + std::pow(dp/m_params.momentum, 2);
+                        if(distance < best_distance) {
+                            best_distance = distance;
+                            best = idx;
+                        }
+                    }
+                }
+            }
+        }
+        if(best == SIZE_MAX) break;
+
+        const auto n = static_cast<double>(members.size());
+        members.push_back(best);
+        if(particles[best].ID() == PID::proton()) ++nprotons;
+        else ++nneutrons;
+        total += particles[best].Momentum();
+        centroid = (centroid*n + particles[best].Position())/(n + 1);
+    }
+
+    return members;
+}
+
+std::size_t Coalescence::Form(Particles &particles, double radius) const {
+    // Nucleons leaving the nucleus, and spectators close to the surface
+    const double inner = radius - m_params.surface;
+    std::vector<std::size_t> candidates;
+    for(std::size_t i = 0; i < particles.size(); ++i) {
+        const auto &particle = particles[i];
+        if(particle.ID() != PID::proton() && particle.ID() != PID::neutron()) continue;
+        if(particle.Status() == ParticleStatus::final_state
+           || (m_params.surface > 0 && particle.Status() == ParticleStatus::background
+               && particle.Position().Magnitude() > inner))
+            candidates.push_back(i);
+    }
+    if(candidates.size() < 2) return 0;
+
+    Grid grid;
+    for(const auto idx : candidates) grid[Locate(particles[idx].Position())].push_back(idx);
+
+    std::vector<bool> used(particles.size(), false);
+    Particles clusters;
+    // Only the nucleons leaving the nucleus seed the clusters, the spectators can only join them
+    for(const auto seed : candidates) {
+        if(used[seed] || particles[seed].Status() != ParticleStatus::final_state) continue;
+        const auto members = Grow(particles, grid, seed, used);
+        if(members.size() < 2) continue;
+
+        std::size_t nprotons = 0;
+        ThreeVector momentum, position;
+        for(const auto idx : members) {
+            if(particles[idx].ID() == PID::proton()) ++nprotons;
+            momentum += particles[idx].Momentum().Vec3();
+            position += particles[idx].Position();
+            used[idx] = true;
+        }
+        const PID pid = Cluster(nprotons, members.size() - nprotons);
+        const double mass = ParticleInfo(pid).Mass();
+        clusters.emplace_back(pid, FourVector(momentum, std::sqrt(momentum.P2() + mass*mass)),
+                              position/static_cast<double>(members.size()), ParticleStatus::final_state);
+    }
+    if(clusters.empty()) return 0;
+
+    Particles remaining;
+    remaining.reserve(particles.size() + clusters.size());
+    for(std::size_t i = 0; i < particles.size(); ++i) {
+        if(!used[i]) remaining.push_back(std::move(particles[i]));
+    }
+    remaining.insert(remaining.end(), clusters.begin(), clusters.end());
+    particles = std::move(remaining);
+    return clusters.size();
+}
@@ -0,0 +1,133 @@
+#include "Achilles/ControlVariate.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+using achilles::ControlVariateEstimator;
+
+ControlVariateEstimator::ControlVariateEstimator(std::vector<double> integrals)
+        : m_integrals{std::move(integrals)}, m_gmean(NVariates()),
+          m_gg(NVariates()*NVariates()), m_gf(NVariates()) {}
+
+// Welford's update of the means and co-moments, which avoids the cancellations of the raw sums
+void ControlVariateEstimator::Add(double value, const std::vector<double> &controls) {
+    const size_t nvar = NVariates();
+    if(controls.size() != nvar)
+        throw std::runtime_error("ControlVariateEstimator: Wrong number of control variates");
+    if(m_block_npoints.empty()) NewBlock();
+    ++m_block_npoints.back();
+    m_block_f.back() += value;
+    for(size_t k = 0; k < nvar; ++k) m_block_g[m_block_g.size() - nvar + k] += controls[k];
+
+    const auto n = static_cast<double>(++m_npoints);
+    const double df = value - m_fmean;
+    m_fmean += df/n;
+    const double df_new = value - m_fmean;
+    m_ff += df*df_new;
+    std::vector<double> dg(nvar);
+    for(size_t k = 0; k < nvar; ++k) {
+        dg[k] = controls[k] - m_gmean[k];
+        m_gmean[k] += dg[k]/n;
+    }
+    for(size_t k = 0; k < nvar; ++k) {
+        for(size_t l = 0; l < nvar; ++l) m_gg[k*nvar + l] += dg[k]*(controls[l] - m_gmean[l]);
+        m_gf[k] += dg[k]*df_new;
+    }
+}
+
+void ControlVariateEstimator::NewBlock() {
+    m_block_npoints.push_back(0);
+    m_block_f.push_back(0);
+    m_block_g.resize(m_block_g.size() + NVariates());
+}
+
+// Solve cov(g, g) c = cov(g, f) with Gaussian elimination. Control variates without variance, or
+// linearly dependent on the others, get a coefficient of zero
+void ControlVariateEstimator::Solve() {
+    const size_t nvar = NVariates();
+    const size_t npts = NPoints();
+    m_coefficients.assign(nvar, 0);
+    if(npts < 2 || nvar == 0) return;
+    const auto n = static_cast<double>(npts);
+
+    // Augmented matrix of the covariances
+    std::vector<std::vector<double>> cov(nvar, std::vector<double>(nvar + 1));
+    for(size_t k = 0; k < nvar; ++k) {
+        for(size_t l = 0; l < nvar; ++l) cov[k][l] = m_gg[k*nvar + l];
+        cov[k][nvar] = m_gf[k];
+    }
+
+    static constexpr double tolerance = 1e-12;
+    std::vector<double> scale(nvar);
+    for(size_t k = 0; k < nvar; ++k) scale[k] = std::max(cov[k][k], n*m_gmean[k]*m_gmean[k]);
+    std::vector<bool> used(nvar, false);
+    std::vector<size_t> pivots(nvar, nvar);
+    for(size_t col = 0; col < nvar; ++col) {
+        size_t pivot = nvar;
+        double largest = 0;
+        for(size_t row = 0; row < nvar; ++row) {
+            if(used[row] || std::abs(cov[row][col]) <= largest) continue;
+            largest = std::abs(cov[row][col]);
+            pivot = row;
+        }
+        if(pivot == nvar || largest <= tolerance*scale[col]) continue;
+        used[pivot] = true;
+        pivots[col] = pivot;
+        for(size_t row = 0; row < nvar; ++row) {
+            if(row == pivot) continue;
+            const double factor = cov[row][col]/cov[pivot][col];
+            for(size_t k = col; k <= nvar; ++k) cov[row][k] -= factor*cov[pivot][k];
+        }
+    }
+    for(size_t col = 0; col < nvar; ++col) {
+        if(pivots[col] == nvar) continue;
+        m_coefficients[col] = cov[pivots[col]][nvar]/cov[pivots[col]][col];
+    }
+}
+
+double ControlVariateEstimator::Residual(double value, const double *controls) const {
+    if(m_coefficients.size() != NVariates()) return value;
+    for(size_t k = 0; k < NVariates(); ++k) value -= m_coefficients[k]*(controls[k] - m_integrals[k]);
+    return value;
+}
+
+double ControlVariateEstimator::Mean() const {
+    return Residual(m_fmean, m_gmean.data());
+}
+
+// The variance of the residuals follows from the co-moments as
+// var(f) - 2 c.cov(g, f) + c.cov(g, g).c
+double ControlVariateEstimator::Error() const {
+    const size_t nvar = NVariates();
+    const auto n = static_cast<double>(m_npoints);
+    if(m_npoints < 2) return std::numeric_limits<double>::infinity();
+    double moment = m_ff;
+    if(m_coefficients.size() == nvar) {
+        for(size_t k = 0; k < nvar; ++k) {
+            moment -= 2*m_coefficients[k]*m_gf[k];
+            for(size_t l = 0; l < nvar; ++l)
+                moment += m_coefficients[k]*m_gg[k*nvar + l]*m_coefficients[l];
+        }
+    }
+    return std::sqrt(std::max(moment, 0.0)/(n*(n - 1)));
+}
+
+double ControlVariateEstimator::BlockError() const {
+    const size_t nvar = NVariates();
+    const size_t nblocks = NBlocks();
+    if(nblocks < 2) return std::numeric_limits<double>::infinity();
+    std::vector<double> means(nblocks), controls(nvar);
+    for(size_t b = 0; b < nblocks; ++b) {
+        const auto n = static_cast<double>(m_block_npoints[b]);
+        for(size_t k = 0; k < nvar; ++k) controls[k] = m_block_g[b*nvar + k]/n;
+        means[b] = Residual(m_block_f[b]/n, controls.data());
+    }
+    const auto nb = static_cast<double>(nblocks);
+    const double mean = std::accumulate(means.begin(), means.end(), 0.0)/nb;
+    double variance = 0;
+    for(const auto &block : means) variance += (block - mean)*(block - mean);
+    return std::sqrt(variance/(nb*(nb - 1)));
+}
@@ -13,6 +13,7 @@
 #include "Achilles/NuclearModel.hh"
 #include "Achilles/ComplexFmt.hh"
 #include "Achilles/Units.hh"
+#include "Achilles/RadiativeCorrections.hh"
 
 // TODO: Turn this into a factory to reduce the number of includes
 #include "Achilles/PhaseSpaceBuilder.hh"
@@ -21,17 +22,21 @@
 #include "Achilles/FinalStateMapper.hh"
 #include "Achilles/PhaseSpaceMapper.hh"
 #include "Achilles/QuasielasticTestMapper.hh"
+#include "Achilles/FlowMapper.hh"
 
 #ifdef ENABLE_BSM
 #include "plugins/Sherpa/Channels1.hh"
 #include "plugins/Sherpa/Channels3.hh"
 #include "plugins/Sherpa/SherpaMEs.hh"
+#include "plugins/Sherpa/SherpaCache.hh"
 #endif
 
 #ifdef ENABLE_HEPMC3
 #include "plugins/HepMC3/HepMC3EventWriter.hh"
 #endif
 
+#include <numeric>
+
 #include "yaml-cpp/yaml.h"
 
 achilles::Channel<achilles::FourVector> BuildChannelTest(const YAML::Node &node, std::shared_ptr<achilles::Beam> beam) {
@@ -86,9 +91,14 @@ achilles::Channel<achilles::FourVector> BuildGenChannel(achilles::NuclearModel *
 #endif
 
 achilles::EventGen::EventGen(const std::string &configFile,
-                             std::vector<std::string> shargs) {
-    config = YAML::LoadFile(configFile);
+                             std::vector<std::string> shargs)
+        : EventGen(YAML::LoadFile(configFile), std::move(shargs)) {
+    writer -> WriteHeader(configFile);
+}
 
+achilles::EventGen::EventGen(YAML::Node node, std::vector<std::string> shargs,
+                             std::shared_ptr<EventWriter> eventWriter)
+        : config{std::move(node)}, writer{std::move(eventWriter)} {
     // Setup random number generator
     auto seed = static_cast<unsigned int>(std::chrono::high_resolution_clock::now().time_since_epoch().count());
     if(config["Initialize"]["Seed"])
@@ -104,6 +114,20 @@ achilles::EventGen::EventGen(const std::string &configFile,
     // Load initial state, massess
     spdlog::trace("Initializing the beams");
     beam = std::make_shared<Beam>(config["Beams"].as<Beam>());
+    if(config["RadiativeCorrections"]) {
+        radiative = config["RadiativeCorrections"].as<RadiativeCorrections>();
+        const auto pid = *beam -> BeamIDs().begin();
+        if(pid != PID::electron())
+            throw std::runtime_error("EventGen: Radiative corrections are only implemented for electron beams");
+        if(radiative.ISR()) {
+            if(beam -> at(pid) -> Type() != "Monochromatic")
+                throw std::runtime_error("EventGen: Initial state radiation requires a monochromatic beam");
+            const double energy = beam -> at(pid) -> Flux({}, 0).E();
+            beam -> SetFlux(pid, radiative.MakeISRFlux(energy));
+        }
+        spdlog::info("Radiative corrections: ISR = {}, FSR = {}, Virtual = {}",
+                     radiative.ISR(), radiative.FSR(), radiative.Virtual());
+    }
     nucleus = std::make_shared<Nucleus>(config["Nucleus"].as<Nucleus>());
 
     // Set potential for the nucleus
@@ -116,6 +140,20 @@ achilles::EventGen::EventGen(const std::string &configFile,
     spdlog::debug("Cascade mode: {}", config["Cascade"]["Run"].as<bool>());
     if(config["Cascade"]["Run"].as<bool>()) {
         cascade = std::make_unique<Cascade>(config["Cascade"].as<Cascade>());
+        const auto &watchdog = cascade -> Watchdog();
+        spdlog::info("Cascade watchdog: MaxSteps = {}, MaxTime = {} s, EnergyTolerance = {} MeV, Policy = {}",
+                     watchdog.max_steps, watchdog.max_time, watchdog.energy_tolerance,
+                     CascadeWatchdog::Name(watchdog.policy));
+        oversample = config["Cascade"]["Oversample"] ? config["Cascade"]["Oversample"].as<size_t>() : 1;
+        if(oversample == 0)
+            throw std::runtime_error("EventGen: Cascade oversampling requires at least one realization");
+        if(oversample > 1)
+            spdlog::info("Cascade oversampling: {} realizations per hard scattering event", oversample);
+        // Unweighting accepts the biased histories with a probability proportional to their
+        // weight, which restores the analog distribution and cancels the gain of the biasing
+        if(cascade -> Biasing().Enabled()
+           && config["Unweighting"]["Name"].as<std::string>() != NoUnweighter::Name())
+            throw std::runtime_error("EventGen: Biasing of the cascade requires weighted events (Unweighting: None)");
     } else {
         cascade = nullptr;
     }
@@ -144,13 +182,27 @@ achilles::EventGen::EventGen(const std::string &configFile,
     if(model == "SM") model = "SM_Nuc";
     shargs.push_back("MODEL=" + model);
     shargs.push_back("UFO_PARAM_CARD=" + param_card);
+
+    // Optionally cache the process information between runs
+    std::unique_ptr<SherpaCache> sherpaCache = nullptr;
+    bool cacheLoaded = false;
+    if(config["Process"]["Cache"]) {
+        std::vector<std::string> inputs{model, SherpaCache::FileContents(param_card),
+                                        fmt::format("{}", fmt::join(leptonicProcess.Ids(), ","))};
+        inputs.insert(inputs.end(), shargs.begin(), shargs.end());
+        sherpaCache = std::make_unique<SherpaCache>(config["Process"]["Cache"].as<std::string>(), inputs);
+        cacheLoaded = sherpaCache -> Load();
+        shargs.push_back("SHERPA_CPP_PATH=" + sherpaCache -> Directory());
+    }
+
     sherpa -> Initialize(shargs);
     spdlog::debug("Initializing leptonic currents");
     if(!sherpa -> InitializeProcess(leptonicProcess)) {
         spdlog::error("Cannot initialize hard process");
         exit(1);
     }
-    leptonicProcess.m_mom_map = sherpa -> MomentumMap(leptonicProcess.Ids());
+    if(cacheLoaded) leptonicProcess.m_mom_map = sherpaCache -> momentum_map;
+    else leptonicProcess.m_mom_map = sherpa -> MomentumMap(leptonicProcess.Ids());
 #else
     // Dummy call to remove unused error
     (void)shargs;
@@ -179,8 +231,12 @@ achilles::EventGen::EventGen(const std::string &configFile,
     } else {
 #ifndef ENABLE_BSM
         if(scattering -> Process().Multiplicity() == 4) {
-            Channel<FourVector> channel0 = BuildChannel<TwoBodyMapper>(scattering -> Nuclear(), 2, 2,
-                                                                       beam, masses);
+            // Inelastic models produce a hadronic system with a variable invariant mass
+            const auto mode = scattering -> Nuclear() -> Mode();
+            const bool inelastic = mode == NuclearMode::ShallowInelastic || mode == NuclearMode::DeepInelastic;
+            Channel<FourVector> channel0 = inelastic
+                ? BuildChannel<InelasticMapper>(scattering -> Nuclear(), 2, 2, beam, masses)
+                : BuildChannel<TwoBodyMapper>(scattering -> Nuclear(), 2, 2, beam, masses);
             integrand.AddChannel(std::move(channel0));
         } else {
             const std::string error = fmt::format("Leptonic Tensor can only handle 2->2 processes without "
@@ -189,7 +245,18 @@ achilles::EventGen::EventGen(const std::string &configFile,
             throw std::runtime_error(error);
         }
 #else
-        auto channels = sherpa -> GenerateChannels(scattering -> Process().Ids());
+        std::vector<std::unique_ptr<PHASIC::Channels>> channels;
+        if(cacheLoaded) {
+            channels = SherpaMEs::BuildChannels(sherpaCache -> topologies, sherpaCache -> masses);
+        } else if(sherpaCache) {
+            sherpaCache -> momentum_map = leptonicProcess.m_mom_map;
+            sherpaCache -> topologies = sherpa -> GenerateTopologies(scattering -> Process().Ids(),
+                                                                     sherpaCache -> masses);
+            sherpaCache -> Save();
+            channels = SherpaMEs::BuildChannels(sherpaCache -> topologies, sherpaCache -> masses);
+        } else {
+            channels = sherpa -> GenerateChannels(scattering -> Process().Ids());
+        }
         size_t count = 0;
         for(auto & chan : channels) {
             Channel<FourVector> channel = BuildGenChannel(scattering -> Nuclear(), 
@@ -201,6 +268,37 @@ achilles::EventGen::EventGen(const std::string &configFile,
 #endif
     }
 
+    // Optionally place a trainable normalizing flow in front of each channel
+    if(config["Initialize"]["Flow"]) {
+        auto flowParams = config["Initialize"]["Flow"].as<FlowParams>();
+        spdlog::info("Adding normalizing flows to the phase space channels");
+        for(auto &channel : integrand.Channels())
+            channel.mapping = std::make_unique<FlowMapper<FourVector>>(std::move(channel.mapping), flowParams);
+    }
+
+    // Optionally replace the Vegas grid of some or all channels by a cellular sampler
+    if(config["Initialize"]["Foam"]) {
+        const auto foamNode = config["Initialize"]["Foam"];
+        auto foamParams = foamNode.as<FoamParams>();
+        std::vector<size_t> foamChannels(integrand.NChannels());
+        std::iota(foamChannels.begin(), foamChannels.end(), 0);
+        if(foamNode["Channels"]) foamChannels = foamNode["Channels"].as<std::vector<size_t>>();
+        for(const auto &idx : foamChannels) {
+            if(idx >= integrand.NChannels())
+                throw std::runtime_error(fmt::format("EventGen: Invalid channel {} for the foam", idx));
+            auto &channel = integrand.GetChannel(idx);
+            channel.foam = std::make_unique<Foam>(channel.NDims(), foamParams);
+        }
+        spdlog::info("Using a foam with up to {} cells for {} channel(s)",
+                     foamParams.max_cells, foamChannels.size());
+    }
+
+    // Setup phase space biasing
+    if(config["Bias"]) {
+        bias = config["Bias"].as<PhaseSpaceBias>();
+        spdlog::info("Biasing the phase space with {} term(s)", bias.Terms().size());
+    }
+
     // Setup Multichannel integrator
     // auto params = config["Integration"]["Params"].as<MultiChannelParams>();
     integrator = MultiChannel(integrand.NDims(), integrand.NChannels(), {1000, 2});
@@ -220,30 +318,40 @@ achilles::EventGen::EventGen(const std::string &configFile,
     // spdlog::info("Apply event cuts? {}", doEventCuts);
     // event_cuts = config["EventCuts"].as<achilles::CutCollection>();
 
-    // Setup outputs
+    // Setup outputs, unless the caller has provided a writer
+    if(config["Initialize"]["SaveResults"])
+        saveResults = config["Initialize"]["SaveResults"].as<bool>();
     auto output = config["Main"]["Output"];
-    bool zipped = true;
-    if(output["Zipped"])
-        zipped = output["Zipped"].as<bool>();
-    spdlog::trace("Outputing as {} format", output["Format"].as<std::string>());
-    if(output["Format"].as<std::string>() == "Achilles") {
-        writer = std::make_unique<AchillesWriter>(output["Name"].as<std::string>(), zipped);
+    if(!writer) {
+        bool zipped = true;
+        if(output["Zipped"])
+            zipped = output["Zipped"].as<bool>();
+        spdlog::trace("Outputing as {} format", output["Format"].as<std::string>());
+        if(output["Format"].as<std::string>() == "Achilles") {
+            writer = std::make_unique<AchillesWriter>(output["Name"].as<std::string>(), zipped);
 #ifdef ENABLE_HEPMC3
-    } else if(output["Format"].as<std::string>() == "HepMC3") {
-        writer = std::make_unique<HepMC3Writer>(output["Name"].as<std::string>(), zipped);
+        } else if(output["Format"].as<std::string>() == "HepMC3") {
+            writer = std::make_unique<HepMC3Writer>(output["Name"].as<std::string>(), zipped);
 #endif
-    } else {
-        std::string msg = fmt::format("Achilles: Invalid output format requested {}",
-                                      output["Format"].as<std::string>());
-        throw std::runtime_error(msg);
+        } else {
+            std::string msg = fmt::format("Achilles: Invalid output format requested {}",
+                                          output["Format"].as<std::string>());
+            throw std::runtime_error(msg);
+        }
     }
-    writer -> WriteHeader(configFile);
+
+    // Restrict the particles written to the output
+    if(output["Filter"])
+        writer -> SetFilter(output["Filter"].as<OutputFilter>());
 }
 
 void achilles::EventGen::Initialize() {
     // TODO: Clean up loading of previous results
     auto func = [&](const std::vector<FourVector> &mom, const double &wgt) {
-        return GenerateEvent(mom, wgt);
+        eventBias = 1;
+        const double result = GenerateEvent(mom, wgt);
+        if(bias.Enabled()) unbiasedResults += result/eventBias;
+        return result;
     };
     // TODO: Loading the saved data is broken
     // try {
@@ -259,8 +367,35 @@ void achilles::EventGen::Initialize() {
         integrand.Function() = func;
         if(config["Initialize"]["Accuracy"])
             integrator.Parameters().rtol = config["Initialize"]["Accuracy"].as<double>();
+        if(config["Initialize"]["PruneThreshold"])
+            integrator.Parameters().prune_threshold = config["Initialize"]["PruneThreshold"].as<double>();
+        if(config["Initialize"]["Sampling"]) {
+            integrator.SetSampling(config["Initialize"]["Sampling"].as<QuasiRandom>());
+            spdlog::info("Integrating with {} points in {} replicas",
+                         QuasiRandom::Name(integrator.Sampling().GetType()), integrator.Sampling().Replicas());
+        }
+        if(config["Initialize"]["ChannelControlVariates"])
+            integrand.SetChannelControlVariates(config["Initialize"]["ChannelControlVariates"].as<bool>());
+        unbiasedResults = StatsData();
+        generatedResults = StatsData();
         integrator.Optimize(integrand);
         integrator.Summary();
+        for(size_t i = 0; i < integrand.NChannels(); ++i) {
+            const auto &foam = integrand.GetChannel(i).foam;
+            if(foam) spdlog::info("Foam of channel {}: {} cells, estimated efficiency = {:.3f}",
+                                  i, foam -> NCells(), foam -> Efficiency());
+        }
+        // The number of calls is not fixed during the event generation, which requires pseudo-random points
+        integrator.SetSampling(QuasiRandom());
+        // The generated events are weighted by the integrand alone
+        integrand.SetChannelControlVariates(false);
+        if(bias.Enabled()) {
+            spdlog::info("Integral without phase space bias = {:^8.5e} +/- {:^8.5e}",
+                         unbiasedResults.Mean(), unbiasedResults.Error());
+        }
+        // The generated batches are accumulated separately from the optimization
+        unbiasedResults = StatsData();
+        if(!saveResults) return;
 
         YAML::Node results;
         results["Multichannel"] = integrator;
@@ -273,26 +408,69 @@ void achilles::EventGen::Initialize() {
 }
 
 void achilles::EventGen::GenerateEvents() {
-    outputEvents = true;
-    runCascade = config["Cascade"]["Run"].as<bool>();
-    integrator.Parameters().ncalls = config["Main"]["NEvents"].as<size_t>();
-    integrator(integrand);
+    GenerateEvents(config["Main"]["NEvents"].as<size_t>());
     fmt::print("\n");
-    auto result = integrator.Summary();
+    const auto &result = generatedResults;
     fmt::print("Integral = {:^8.5e} +/- {:^8.5e} ({:^8.5e} %)\n",
-               result.results.back().Mean(), result.results.back().Error(),
-               result.results.back().Error() / result.results.back().Mean()*100);
+               result.Mean(), result.Error(), result.Error() / result.Mean()*100);
+    if(bias.Enabled()) {
+        // The integrator only sees the biased integrand
+        fmt::print("Integral without bias = {:^8.5e} +/- {:^8.5e} ({:^8.5e} %)\n",
+                   unbiasedResults.Mean(), unbiasedResults.Error(),
+                   unbiasedResults.Error() / unbiasedResults.Mean()*100);
+    }
+    if(result.NegativeCalls() > 0) {
+        fmt::print("  Positive = {:^8.5e}, Negative = {:^8.5e} ({:^8.5e} % of |Integral|)\n",
+                   result.PositiveMean(), result.NegativeMean(), result.NegativeFraction()*100);
+    }
     fmt::print("Unweighting efficiency: {:^8.5e} %\n",
                unweighter->Efficiency() * 100);
+    if(unweighter->AcceptedNegative() > 0) {
+        fmt::print("Negative weight events: {:^8.5e} %, effective efficiency: {:^8.5e} %\n",
+                   unweighter->NegativeFraction() * 100, unweighter->EffectiveEfficiency() * 100);
+    }
+    if(cascade && cascade->Watchdog().Total() > 0) {
+        const auto &watchdog = cascade->Watchdog();
+        fmt::print("Aborted cascades: {} (policy: {})\n", watchdog.Total(),
+                   CascadeWatchdog::Name(watchdog.policy));
+        for(size_t i = 1; i < CascadeWatchdog::nreasons; ++i) {
+            const auto reason = static_cast<CascadeWatchdog::Reason>(i);
+            if(watchdog.Count(reason) == 0) continue;
+            fmt::print("  {}: {} (e.g. events {})\n", CascadeWatchdog::Name(reason),
+                       watchdog.Count(reason), fmt::join(watchdog.Examples(reason), ", "));
+        }
+    }
+}
+
+void achilles::EventGen::GenerateEvents(size_t nevents_) {
+    outputEvents = true;
+    runCascade = config["Cascade"]["Run"].as<bool>();
+    nevents = nevents_;
+    eventNumber = 0;
+    integrator.Parameters().ncalls = nevents;
+    // The grids and channel weights are fixed after the initialization, so that all batches
+    // are drawn from the same distribution
+    generatedResults += integrator.Sample(integrand);
+
+    // Events held back by the unweighter can only be written once all are generated
+    if(unweighter->Deferred()) unweighter->Flush(*writer);
+}
+
+void achilles::EventGen::WriteEvent(const Event &event) {
+    if(unweighter->Deferred()) {
+        unweighter->Spill(event, eventBias);
+    } else {
+        writer -> Write(event);
+    }
 }
 
 double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, const double &wgt) {
     if(outputEvents) {
+        ++eventNumber;
         static constexpr size_t statusUpdate = 1000;
         if(unweighter->Accepted() % statusUpdate == 0) {
             fmt::print("Generated {} / {} events\r",
-                       unweighter->Accepted(),
-                       config["Main"]["NEvents"].as<size_t>());
+                       unweighter->Accepted(), nevents);
         }
     }
     // Initialize the event, which generates the nuclear configuration
@@ -324,7 +502,7 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
             event.SetMEWeight(0);
             event.CalcWeight();
             spdlog::trace("Outputting the event");
-            writer -> Write(event);
+            WriteEvent(event);
             // Update number of calls needed to ensure the number of generated events
             // is the same as that requested by the user
             integrator.Parameters().ncalls++;
@@ -347,6 +525,20 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
     event.CalcWeight();
     spdlog::trace("Weight: {}", event.Weight());
 
+    // Add the QED corrections, which include the radiated photons in the event
+    if(radiative.Enabled()) {
+        radiative.Radiate(event);
+        spdlog::trace("Weight after radiative corrections: {}", event.Weight());
+    }
+
+    // Bias the integrand towards the requested region of phase space. The written events
+    // carry the inverse of the bias in their weight
+    if(bias.Enabled()) {
+        eventBias = bias(event);
+        event.Weight() *= eventBias;
+        event.BiasWeight() /= eventBias;
+    }
+
     // if((event.Momentum()[3]+event.Momentum()[4]).M() < 400) {
     //     spdlog::info("Mass issue");
     //     spdlog::drop("achilles");
@@ -363,7 +555,7 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
             if(outputEvents) {
                 event.SetMEWeight(0);
                 event.CalcWeight();
-                writer -> Write(event);
+                WriteEvent(event);
                 // Update number of calls needed to ensure the number of generated events
                 // is the same as that requested by the user
                 integrator.Parameters().ncalls++;
@@ -382,8 +574,19 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
                 spdlog::trace("\t{}: {}", idx, particle);
             ++idx;
         }
+        // Each accepted hard scattering is followed by several independent cascades
+        if(outputEvents && oversample > 1) return GenerateRealizations(event);
+
         spdlog::debug("Runnning cascade");
-        cascade -> Evolve(&event);
+        if(!EvolveCascade(event)) {
+            event.SetMEWeight(0);
+            event.CalcWeight();
+            WriteEvent(event);
+            // Update number of calls needed to ensure the number of generated events
+            // is the same as that requested by the user
+            integrator.Parameters().ncalls++;
+            return 0;
+        }
 
         spdlog::trace("Hadrons (Post Cascade):");
         idx = 0;
@@ -418,7 +621,11 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
                 // is the same as that requested by the user
                 integrator.Parameters().ncalls++;
             }
-            writer -> Write(event);
+            // The integrator keeps seeing the biased weight
+            const double biasedWgt = event.Weight();
+            event.Weight() /= eventBias;
+            WriteEvent(event);
+            return biasedWgt;
         }
         } else {
             unweighter->AddEvent(event);
@@ -430,6 +637,79 @@ double achilles::EventGen::GenerateEvent(const std::vector<FourVector> &mom, con
     return event.Weight();
 }
 
+// Run the cascade several times for the same hard scattering, each time in a new configuration
+// of the spectator nucleons. The primary event is unweighted once, and the accepted weight is
+// shared equally by the realizations, which are written with the number of the primary event.
+// Returns the weight of the primary event seen by the integrator
+double achilles::EventGen::GenerateRealizations(Event &event) {
+    if(!unweighter->AcceptEvent(event)) {
+        // Update number of calls needed to ensure the number of generated events
+        // is the same as that requested by the user
+        integrator.Parameters().ncalls++;
+    }
+    const double biasedWgt = event.Weight();
+
+    // Rejected events are only needed to count the trials, so the cascade is skipped
+    if(biasedWgt == 0) {
+        event.SetRealization(eventNumber, 0, 1);
+        event.Finalize();
+        WriteEvent(event);
+        return 0;
+    }
+
+    const auto hadrons = event.Hadrons();
+    const auto leptons = event.Leptons();
+    const double biasWgt = event.BiasWeight();
+    for(size_t i = 0; i < oversample; ++i) {
+        if(i > 0) {
+            event.CurrentNucleus()->ResampleConfig(hadrons);
+            event.Leptons() = leptons;
+        }
+        event.Weight() = biasedWgt/static_cast<double>(oversample);
+        event.BiasWeight() = biasWgt;
+        event.CascadeFlag() = 0;
+        event.SetRealization(eventNumber, i, oversample);
+
+        spdlog::debug("Runnning cascade realization {} / {}", i+1, oversample);
+        // Dropped realizations keep their share of the trial with zero weight
+        if(!EvolveCascade(event)) event.Weight() = 0;
+
+        if(doRotate) Rotate(event);
+        event.Finalize();
+        event.Weight() /= eventBias;
+        WriteEvent(event);
+    }
+
+    return biasedWgt;
+}
+
+// Run the cascade, applying the policy of the watchdog to aborted events.
+// Returns false if the event should be dropped
+bool achilles::EventGen::EvolveCascade(Event &event) {
+    auto &watchdog = cascade -> Watchdog();
+    for(size_t attempt = 0; ; ++attempt) {
+        try {
+            cascade -> Evolve(&event);
+            return true;
+        } catch(const CascadeAbort &abort) {
+            spdlog::debug("Event {}: {}", eventNumber, abort.what());
+            watchdog.Record(abort.Reason(), eventNumber);
+            // The nucleus is unchanged by an aborted cascade, so it can be evolved again
+            if(watchdog.policy == CascadeWatchdog::Policy::Retry && attempt < watchdog.max_retries)
+                continue;
+            if(watchdog.policy != CascadeWatchdog::Policy::Flag) return false;
+
+            // Keep the event without final state interactions
+            event.CascadeFlag() = static_cast<int>(abort.Reason());
+            for(auto &nucleon : event.CurrentNucleus()->Nucleons()) {
+                if(nucleon.Status() == ParticleStatus::propagating)
+                    nucleon.Status() = ParticleStatus::final_state;
+            }
+            return true;
+        }
+    }
+}
+
 bool achilles::EventGen::MakeCuts(Event &event) {
     return hard_cuts.EvaluateCuts(event.Particles());
 }
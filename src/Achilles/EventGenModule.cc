@@ -0,0 +1,121 @@
+#include "Achilles/PyBindings.hh"
+#include "Achilles/EventGen.hh"
+#include "Achilles/EventWriter.hh"
+#include "Achilles/Unweighter.hh"
+
+#include "pybind11/numpy.h"
+
+// These are for convenience
+using achilles::BufferedEvent;
+using achilles::BufferedParticle;
+using achilles::BufferWriter;
+using achilles::EventGen;
+
+PYBIND11_NUMPY_DTYPE(BufferedParticle, event, pid, status, E, px, py, pz, x, y, z);
+PYBIND11_NUMPY_DTYPE(BufferedEvent, weight, flux, nparticles, remnant_pid);
+
+namespace {
+
+// Convert a (nested) python object into a YAML node, so that a run card can be given as a dict
+YAML::Node ToYAML(const py::handle &obj) {
+    if(py::isinstance<py::dict>(obj)) {
+        YAML::Node node(YAML::NodeType::Map);
+        for(const auto &item : obj.cast<py::dict>())
+            node[py::str(item.first).cast<std::string>()] = ToYAML(item.second);
+        return node;
+    } else if(py::isinstance<py::list>(obj) || py::isinstance<py::tuple>(obj)) {
+        YAML::Node node(YAML::NodeType::Sequence);
+        for(const auto &item : obj)
+            node.push_back(ToYAML(item));
+        return node;
+    } else if(obj.is_none()) {
+        return YAML::Node(YAML::NodeType::Null);
+    } else if(py::isinstance<py::bool_>(obj)) {
+        return YAML::Node(obj.cast<bool>());
+    } else if(py::isinstance<py::int_>(obj)) {
+        return YAML::Node(obj.cast<long int>());
+    } else if(py::isinstance<py::float_>(obj)) {
+        return YAML::Node(obj.cast<double>());
+    }
+    return YAML::Node(py::str(obj).cast<std::string>());
+}
+
+// In-process event generator that keeps the events in memory
+class PyEventGen {
+    public:
+        PyEventGen(const py::dict &config, std::vector<std::string> shargs)
+            : buffer{std::make_shared<BufferWriter>()} {
+            auto node = ToYAML(config);
+            // Avoid touching the disk unless explicitly requested
+            if(!node["Initialize"]["SaveResults"])
+                node["Initialize"]["SaveResults"] = false;
+            generator = std::make_unique<EventGen>(node, std::move(shargs), buffer);
+        }
+
+        void Initialize() { generator -> Initialize(); }
+
+        py::dict Generate(size_t nevents) {
+            buffer -> Clear();
+            generator -> GenerateEvents(nevents);
+
+            py::dict batch;
+            const auto &events = buffer -> Events();
+            const auto &particles = buffer -> Particles();
+            batch["events"] = py::array_t<BufferedEvent>(static_cast<py::ssize_t>(events.size()),
+                                                         events.data());
+            batch["particles"] = py::array_t<BufferedParticle>(static_cast<py::ssize_t>(particles.size()),
+                                                               particles.data());
+            batch["trials"] = buffer -> Trials();
+            return batch;
+        }
+
+        double Efficiency() const { return generator -> GetUnweighter() -> Efficiency(); }
+
+    private:
+        std::shared_ptr<BufferWriter> buffer;
+        std::unique_ptr<EventGen> generator;
+};
+
+// Python iterator yielding batches until the requested number of events is generated
+class EventBatches {
+    public:
+        EventBatches(PyEventGen &gen, size_t nevents, size_t batch_size)
+            : m_gen{gen}, m_remaining{nevents}, m_batch_size{batch_size} {
+            if(m_batch_size == 0) throw std::runtime_error("EventBatches: batch size must be positive");
+        }
+
+        py::dict Next() {
+            if(m_remaining == 0) throw py::stop_iteration();
+            const size_t nevents = std::min(m_remaining, m_batch_size);
+            m_remaining -= nevents;
+            return m_gen.Generate(nevents);
+        }
+
+    private:
+        PyEventGen &m_gen;
+        size_t m_remaining, m_batch_size;
+};
+
+}
+
+void EventGenModule(py::module &m) {
+    py::class_<PyEventGen>(m, "EventGen")
+        // Constructors
+        .def(py::init<const py::dict&, std::vector<std::string>>(),
+             py::arg("config"), py::arg("sherpa_args") = std::vector<std::string>())
+        // Functions
+        .def("initialize", &PyEventGen::Initialize,
+             "Train the integrator (and unweighter) before generating events")
+        .def("generate", &PyEventGen::Generate, py::arg("nevents"),
+             "Generate a single batch of events and return it as a dict of NumPy arrays")
+        .def("batches", [](PyEventGen &self, size_t nevents, size_t batch_size) {
+                return EventBatches(self, nevents, batch_size);
+             }, py::arg("nevents"), py::arg("batch_size") = 10000, py::keep_alive<0, 1>(),
+             "Iterate over batches of events until nevents have been generated")
+        // Getters
+        .def("efficiency", &PyEventGen::Efficiency);
+
+    py::class_<EventBatches>(m, "EventBatches")
+        .def("__iter__", [](EventBatches &self) -> EventBatches& { return self; })
+        .def("__next__", &EventBatches::Next);
+}
@@ -0,0 +1,269 @@
+#include "Achilles/EventMerger.hh"
+#include "Achilles/Random.hh"
+#include "Achilles/Statistics.hh"
+#include "Achilles/Version.hh"
+
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+#if GZIP
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wshadow"
+#include "gzstream/gzstream.h"
+#pragma GCC diagnostic pop
+#endif
+
+using achilles::EventMerger;
+using achilles::AchillesMerger;
+using achilles::SampleSummary;
+
+namespace {
+
+#ifdef GZIP
+bool IsZipped(const std::string &filename) {
+    return filename.size() > 3 && filename.substr(filename.size() - 3) == ".gz";
+}
+#endif
+
+constexpr std::string_view weight_tag = "  Weight: ";
+constexpr std::string_view realization_tag = "  Realization: ";
+
+// The lines of an event in the Achilles format following its "Event:" line
+struct TextEvent {
+    std::vector<std::string> lines{};
+    size_t weight_line{SIZE_MAX}, realization_line{SIZE_MAX};
+    double weight{};
+    size_t realization{1}, nrealizations{1};
+};
+
+// Read the events of a sample one primary event at a time, i.e. together with the other
+// realizations of an oversampled event
+class PrimaryReader {
+    public:
+        PrimaryReader(std::istream &input) : m_input{input} {
+            // Skip the header
+            while(std::getline(m_input, m_line) && !IsEvent(m_line)) {}
+            m_has_next = ReadEvent(m_next);
+        }
+
+        bool Next(std::vector<TextEvent> &primary) {
+            primary.clear();
+            if(!m_has_next) return false;
+            primary.push_back(std::move(m_next));
+            while((m_has_next = ReadEvent(m_next)) && m_next.realization > 1)
+                primary.push_back(std::move(m_next));
+            return true;
+        }
+
+    private:
+        static bool IsEvent(const std::string &line) { return line.rfind("Event: ", 0) == 0; }
+
+        bool ReadEvent(TextEvent &event) {
+            if(!IsEvent(m_line)) return false;
+            event = TextEvent{};
+            while(std::getline(m_input, m_line) && !IsEvent(m_line)) {
+                if(m_line.rfind(weight_tag, 0) == 0) {
+                    event.weight_line = event.lines.size();
+                    event.weight = std::stod(m_line.substr(weight_tag.size()));
+                } else if(m_line.rfind(realization_tag, 0) == 0) {
+                    // Realization: i / N (Primary: id)
+                    const auto value = m_line.substr(realization_tag.size());
+                    event.realization_line = event.lines.size();
+                    event.realization = std::stoul(value);
+                    event.nrealizations = std::stoul(value.substr(value.find('/') + 1));
+                }
+                event.lines.push_back(m_line);
+            }
+            return true;
+        }
+
+        std::istream &m_input;
+        std::string m_line{};
+        TextEvent m_next{};
+        bool m_has_next{};
+};
+
+double PrimaryWeight(const std::vector<TextEvent> &primary) {
+    double wgt = 0;
+    for(const auto &event : primary) wgt += event.weight;
+    return wgt;
+}
+
+}
+
+EventMerger::EventMerger(std::vector<std::string> inputs, bool reunweight)
+    : m_inputs{std::move(inputs)}, m_reunweight{reunweight} {
+    if(m_inputs.empty()) throw std::runtime_error("EventMerger: No input files given");
+}
+
+void EventMerger::Initialize() {
+    m_summaries.clear();
+    for(const auto &input : m_inputs) {
+        m_summaries.push_back(Scan(input));
+        const auto &summary = m_summaries.back();
+        spdlog::info("EventMerger: {}: {} +/- {} from {} trials, max weight = {}",
+                     summary.filename, summary.xsec, summary.error,
+                     summary.trials, summary.max_weight);
+    }
+    m_combined = Combine(m_summaries);
+    spdlog::info("EventMerger: Combined: {} +/- {} from {} trials, max weight = {}",
+                 m_combined.xsec, m_combined.error, m_combined.trials, m_combined.max_weight);
+}
+
+void EventMerger::Merge(const std::string &output) {
+    if(m_summaries.empty()) Initialize();
+
+    Open(output);
+    for(const auto &summary : m_summaries) Copy(summary);
+    Close();
+}
+
+SampleSummary EventMerger::Combine(const std::vector<SampleSummary> &summaries) {
+    SampleSummary result;
+    double sum = 0, sum_err2 = 0;
+    for(const auto &summary : summaries) {
+        const auto trials = static_cast<double>(summary.trials);
+        sum += trials*summary.xsec;
+        sum_err2 += std::pow(trials*summary.error, 2);
+        result.trials += summary.trials;
+        result.nevents += summary.nevents;
+        result.max_weight = std::max(result.max_weight, summary.max_weight);
+    }
+    if(result.trials == 0) return result;
+
+    const auto trials = static_cast<double>(result.trials);
+    result.xsec = sum/trials;
+    result.error = std::sqrt(sum_err2)/trials;
+    return result;
+}
+
+std::vector<double> EventMerger::NewWeights(std::vector<double> wgts) const {
+    if(!m_reunweight) return wgts;
+    const double wgt = std::accumulate(wgts.begin(), wgts.end(), 0.0);
+    const double new_wgt = Reunweight(wgt, m_combined.max_weight);
+    if(wgts.size() == 1) return {new_wgt};
+    for(auto &realization : wgts) realization *= wgt == 0 ? 0 : new_wgt/wgt;
+    return wgts;
+}
+
+double EventMerger::Reunweight(double wgt, double max_wgt) {
+    const double abs_wgt = std::abs(wgt);
+    if(abs_wgt >= max_wgt) return wgt;
+    if(abs_wgt < max_wgt*Random::Instance().Uniform(0.0, 1.0)) return 0;
+    return std::copysign(max_wgt, wgt);
+}
+
+std::unique_ptr<std::istream> AchillesMerger::OpenInput(const std::string &filename) {
+    std::unique_ptr<std::istream> input;
+#ifdef GZIP
+    if(IsZipped(filename)) input = std::make_unique<igzstream>(filename.c_str());
+    else
+#endif
+        input = std::make_unique<std::ifstream>(filename);
+    if(!input -> good())
+        throw std::runtime_error(fmt::format("AchillesMerger: Could not open {}", filename));
+    return input;
+}
+
+SampleSummary AchillesMerger::Scan(const std::string &filename) const {
+    auto input = OpenInput(filename);
+    PrimaryReader reader(*input);
+    StatsData results;
+    double max_weight = 0;
+    std::vector<TextEvent> primary;
+    while(reader.Next(primary)) {
+        const double wgt = PrimaryWeight(primary);
+        results += wgt;
+        max_weight = std::max(max_weight, std::abs(wgt));
+    }
+
+    SampleSummary summary;
+    summary.filename = filename;
+    summary.trials = results.Calls();
+    summary.nevents = results.FiniteCalls();
+    summary.max_weight = max_weight;
+    if(summary.trials > 0) summary.xsec = results.Mean();
+    if(summary.trials > 1) summary.error = results.Error();
+    return summary;
+}
+
+void AchillesMerger::Open(const std::string &filename) {
+#ifdef GZIP
+    if(IsZipped(filename)) m_out = std::make_unique<ogzstream>(filename.c_str());
+    else
+#endif
+        m_out = std::make_unique<std::ofstream>(filename);
+    m_nevents = 0;
+    m_nprimaries = 0;
+
+    // Header with the combined results, followed by the run card of the first sample
+    const auto &combined = Combined();
+    *m_out << fmt::format("Achilles Version: {}\n", ACHILLES_VERSION);
+    *m_out << fmt::format("{0:-^40}\n\n", "");
+    *m_out << fmt::format("Merged:\n");
+    *m_out << fmt::format("  CrossSection: {}\n", combined.xsec);
+    *m_out << fmt::format("  Error: {}\n", combined.error);
+    *m_out << fmt::format("  Trials: {}\n", combined.trials);
+    *m_out << fmt::format("  MaxWeight: {}\n", combined.max_weight);
+    *m_out << fmt::format("  Samples:\n");
+    for(const auto &summary : Summaries())
+        *m_out << fmt::format("  - {}\n", summary.filename);
+
+    auto input = OpenInput(Summaries().front().filename);
+    std::string line;
+    size_t nseparators = 0;
+    while(nseparators < 2 && std::getline(*input, line)) {
+        if(line.rfind("Event: ", 0) == 0) break;
+        if(line == fmt::format("{0:-^40}", "")) {
+            ++nseparators;
+            // Skip the blank line following the separator
+            std::getline(*input, line);
+            continue;
+        }
+        if(nseparators == 1) *m_out << line << "\n";
+    }
+    *m_out << fmt::format("{0:-^40}\n\n", "");
+}
+
+void AchillesMerger::Copy(const SampleSummary &summary) {
+    auto input = OpenInput(summary.filename);
+    PrimaryReader reader(*input);
+    std::vector<TextEvent> primary;
+    std::vector<double> wgts;
+    while(reader.Next(primary)) {
+        wgts.clear();
+        for(const auto &event : primary) wgts.push_back(event.weight);
+        wgts = NewWeights(wgts);
+
+        // Renumber the events and the primary events in the merged sample. Only the weight and
+        // the realization lines change, the other lines are copied
+        ++m_nprimaries;
+        for(size_t i = 0; i < primary.size(); ++i) {
+            const auto &event = primary[i];
+            *m_out << fmt::format("Event: {}\n", ++m_nevents);
+            for(size_t j = 0; j < event.lines.size(); ++j) {
+                if(j == event.weight_line)
+                    *m_out << fmt::format("{}{}\n", weight_tag, wgts[i]);
+                else if(j == event.realization_line)
+                    *m_out << fmt::format("{}{} / {} (Primary: {})\n", realization_tag, event.realization,
+                                          event.nrealizations, m_nprimaries);
+                else
+                    *m_out << event.lines[j] << "\n";
+            }
+        }
+    }
+}
+
+void AchillesMerger::Close() {
+#ifdef GZIP
+    if(auto *zipped = dynamic_cast<ogzstream*>(m_out.get())) zipped -> close();
+#endif
+    m_out.reset();
+}
@@ -31,9 +31,32 @@ void achilles::AchillesWriter::WriteHeader(const std::string &filename) {
 void achilles::AchillesWriter::Write(const Event &event) {
     *m_out << fmt::format("Event: {}\n", ++nEvents);
     *m_out << fmt::format("  Particles:\n");
-    for(const auto &part : event.Particles()) {
+    for(const auto &part : Filter()(event.Particles())) {
         *m_out << fmt::format("  - {}\n", part);
     }
     *m_out << fmt::format("  - {}\n", event.Remnant());
     *m_out << fmt::format("  Weight: {}\n", event.Weight());
+    if(event.BiasWeight() != 1)
+        *m_out << fmt::format("  BiasWeight: {}\n", event.BiasWeight());
+    if(event.CascadeFlag() != 0)
+        *m_out << fmt::format("  CascadeFlag: {}\n", event.CascadeFlag());
+    if(event.NRealizations() > 1)
+        *m_out << fmt::format("  Realization: {} / {} (Primary: {})\n", event.Realization() + 1,
+                              event.NRealizations(), event.PrimaryID());
+}
+
+void achilles::BufferWriter::Write(const Event &event) {
+    // The realizations of an oversampled event are a single trial
+    if(event.Realization() == 0) ++m_trials;
+    if(event.Weight() == 0) return;
+
+    const auto particles = Filter()(event.Particles());
+    for(const auto &part : particles) {
+        const auto &mom = part.Momentum();
+        const auto &pos = part.Position();
+        m_particles.push_back({m_events.size(), part.ID().AsInt(), static_cast<int>(part.Status()),
+                               mom.E(), mom.Px(), mom.Py(), mom.Pz(),
+                               pos.X(), pos.Y(), pos.Z()});
+    }
+    m_events.push_back({event.Weight(), event.Flux(), particles.size(), event.Remnant().PID()});
 }
@@ -0,0 +1,153 @@
+#include "Achilles/Unweighter.hh"
+#include "Achilles/Event.hh"
+#include "Achilles/EventWriter.hh"
+#include "Achilles/Nucleus.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/Random.hh"
+
+#include <cstdint>
+#include <vector>
+
+using achilles::ExactUnweighter;
+
+namespace {
+
+// Compact records written to the spill file. Only the information needed by the
+// event writers is kept, i.e. the weights, flux, remnant, realization, cascade flag and particle kinematics
+struct SpillEvent {
+    double weight, bias, flux;
+    uint64_t nA, nZ, nhadrons, nleptons;
+    uint64_t primary, realization, nrealizations;
+    int32_t flag;
+};
+
+struct SpillParticle {
+    int64_t pid;
+    int32_t status;
+    double E, px, py, pz;
+    double x, y, z;
+};
+
+void SpillParticles(std::FILE *file, const achilles::vParticles &particles) {
+    for(const auto &part : particles) {
+        const auto &mom = part.Momentum();
+        const auto &pos = part.Position();
+        SpillParticle record{part.ID().AsInt(), static_cast<int32_t>(part.Status()),
+                             mom.E(), mom.Px(), mom.Py(), mom.Pz(),
+                             pos.X(), pos.Y(), pos.Z()};
+        std::fwrite(&record, sizeof(record), 1, file);
+    }
+}
+
+achilles::vParticles ReadParticles(std::FILE *file, size_t nparticles) {
+    achilles::vParticles particles;
+    particles.reserve(nparticles);
+    for(size_t i = 0; i < nparticles; ++i) {
+        SpillParticle record{};
+        if(std::fread(&record, sizeof(record), 1, file) != 1)
+            throw std::runtime_error("ExactUnweighter: Spill file is truncated");
+        particles.emplace_back(achilles::PID{record.pid},
+                               achilles::FourVector{record.E, record.px, record.py, record.pz},
+                               achilles::ThreeVector{record.x, record.y, record.z},
+                               static_cast<achilles::ParticleStatus>(record.status));
+    }
+    return particles;
+}
+
+}
+
+ExactUnweighter::ExactUnweighter(const YAML::Node&) : m_spill{std::tmpfile()} {
+    if(!m_spill) throw std::runtime_error("ExactUnweighter: Could not open spill file");
+}
+
+// The unweighting is done on the absolute value of the weight, and the sign is kept
+// for the accepted events. This results in events with weights of +/- max_wgt
+bool ExactUnweighter::AcceptEvent(achilles::Event &event) {
+    const double abs_wgt = std::abs(event.Weight());
+    m_total++;
+    m_sum += abs_wgt;
+    m_max = std::max(m_max, abs_wgt);
+
+    // An event counts towards the requested number of events whenever the expected
+    // number of unweighted events has grown. The event itself keeps its weight
+    const auto expected = m_max > 0 ? static_cast<size_t>(m_sum/m_max) : 0;
+    if(expected <= m_accepted) return false;
+    Accept(event.Weight());
+    return true;
+}
+
+void ExactUnweighter::Spill(const achilles::Event &event, double bias) {
+    if(!m_nucleus) m_nucleus = event.CurrentNucleus();
+
+    const auto &hadrons = event.Hadrons();
+    const auto &leptons = event.Leptons();
+    SpillEvent record{event.Weight(), bias, event.Flux(),
+                      event.Remnant().NA(), event.Remnant().NZ(),
+                      hadrons.size(), leptons.size(),
+                      event.PrimaryID(), event.Realization(), event.NRealizations(),
+                      event.CascadeFlag()};
+    std::fwrite(&record, sizeof(record), 1, m_spill.get());
+    SpillParticles(m_spill.get(), hadrons);
+    SpillParticles(m_spill.get(), leptons);
+    m_spilled++;
+}
+
+void ExactUnweighter::Flush(achilles::EventWriter &writer) {
+    spdlog::info("ExactUnweighter: Unweighting {} events to a maximum weight of {}", m_spilled, m_max);
+    std::rewind(m_spill.get());
+    // Replace the expected number of events from the generation by the actual number
+    m_accepted = m_flushed;
+    m_negative = m_flushedNegative;
+
+    for(size_t i = 0; i < m_spilled; ) {
+        // The realizations of an oversampled event follow each other in the spill file,
+        // and are unweighted together according to the weight of the primary event
+        std::vector<SpillEvent> records;
+        std::vector<achilles::vParticles> hadrons, leptons;
+        do {
+            SpillEvent record{};
+            if(std::fread(&record, sizeof(record), 1, m_spill.get()) != 1)
+                throw std::runtime_error("ExactUnweighter: Spill file is truncated");
+            records.push_back(record);
+            hadrons.push_back(ReadParticles(m_spill.get(), record.nhadrons));
+            leptons.push_back(ReadParticles(m_spill.get(), record.nleptons));
+            ++i;
+        } while(i < m_spilled && records.size() < records.front().nrealizations);
+
+        // Events that failed the cuts only count as trials, and keep their zero weight. The
+        // primary event is accepted according to the sum of the weights of its realizations,
+        // which then share the accepted weight in proportion to their own weights
+        double weight = 0, abs_wgt = 0;
+        for(const auto &record : records) {
+            abs_wgt += std::abs(record.weight*record.bias);
+            if(std::abs(record.weight) > std::abs(weight)) weight = record.weight;
+        }
+        const bool accepted = abs_wgt > 0 && abs_wgt / m_max > achilles::Random::Instance().Uniform(0.0, 1.0);
+        if(accepted) Accept(weight);
+        const double scale = accepted ? std::max(abs_wgt, m_max) / abs_wgt : 0;
+
+        for(size_t j = 0; j < records.size(); ++j) {
+            const auto &record = records[j];
+            Event event;
+            event.CurrentNucleus() = m_nucleus;
+            event.Hadrons() = std::move(hadrons[j]);
+            event.Leptons() = std::move(leptons[j]);
+            event.SetRemnant({record.nA, record.nZ});
+            event.Flux() = record.flux;
+            event.SetRealization(record.primary, record.realization, record.nrealizations);
+            event.CascadeFlag() = record.flag;
+            event.Weight() = record.weight*scale;
+            writer.Write(event);
+        }
+    }
+
+    // Start a new spill file for any further generation
+    m_spill.reset(std::tmpfile());
+    m_spilled = 0;
+    m_flushed = m_accepted;
+    m_flushedNegative = m_negative;
+}
+
+std::unique_ptr<achilles::Unweighter> ExactUnweighter::Construct(const YAML::Node &node) {
+    return std::make_unique<ExactUnweighter>(node);
+}
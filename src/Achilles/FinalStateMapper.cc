@@ -13,18 +13,24 @@ using achilles::SherpaMapper;
 using achilles::TwoBodyMapper;
 using achilles::FourVector;
 
-void TwoBodyMapper::GeneratePoint(std::vector<FourVector> &mom, const std::vector<double> &rans) {
-    // The momentum are given in the following order:
-    // 1. Momentum of the initial hadron
-    // 2. Momentum of the initial lepton
-    // 3. Momentum of all outgoing parts of the leptonic tensor
-    // 4. Momentum of all outgoing hadrons
+using achilles::InelasticMapper;
+
+namespace {
+
+// Two body final state for the momenta given in the following order:
+// 1. Momentum of the initial hadron
+// 2. Momentum of the initial lepton
+// 3. Momentum of the outgoing hadronic system (mass squared s2)
+// 4. Momentum of the outgoing lepton (mass squared s3)
+// The angles are generated flat in the center of mass frame from rans[0] and rans[1]
+void TwoBodyPoint(std::vector<FourVector> &mom, const std::vector<double> &rans, double s2, double s3) {
+    static constexpr double dCos = 2, dPhi = 2*M_PI;
     auto p01 = (mom[0] + mom[1]);
     auto s = p01.M2();
     auto sqrts = sqrt(s);
     auto boostVec = p01.BoostVector();
     auto mom0 = mom[0].Boost(-boostVec);
-    Poincare zax(mom0, FourVector(1.,0.,0.,1.));
+    achilles::Poincare zax(mom0, FourVector(1.,0.,0.,1.));
     auto cosT = dCos*rans[0] - 1;
     auto sinT = sqrt(1 - cosT*cosT);
     auto phi = dPhi*rans[1];
@@ -42,12 +48,12 @@ void TwoBodyMapper::GeneratePoint(std::vector<FourVector> &mom, const std::vecto
     mom[2] = mom[2].Boost(boostVec);
     mom[3] = mom[3].Boost(boostVec);
 
-    Mapper<achilles::FourVector>::Print(__PRETTY_FUNCTION__, mom, rans);
-    spdlog::trace("  MassCheck: {}", CheckMasses({mom[2], mom[3]}, {s2, s3}));
+    spdlog::trace("  MassCheck: {}", achilles::CheckMasses({mom[2], mom[3]}, {s2, s3}));
     spdlog::trace("  s = {}, lambda = {}", s, lambda);
 }
 
-double TwoBodyMapper::GenerateWeight(const std::vector<FourVector> &mom, std::vector<double> &rans) {
+double TwoBodyWeight(const std::vector<FourVector> &mom, std::vector<double> &rans) {
+    static constexpr double dCos = 2, dPhi = 2*M_PI;
     auto boostVec = (mom[0] + mom[1]).BoostVector();
     auto mom0 = mom[0].Boost(-boostVec);
     auto rotMat = mom0.AlignZ();
@@ -60,10 +66,50 @@ double TwoBodyMapper::GenerateWeight(const std::vector<FourVector> &mom, std::ve
 
     auto factor = pcm/ecm/(16*M_PI*M_PI);
     auto wgt = 1.0/dCos/dPhi/factor;
-    Mapper<achilles::FourVector>::Print(__PRETTY_FUNCTION__, mom, rans);
     spdlog::trace("  ct: {}", p2.CosTheta());
     spdlog::trace("  pcm: {}", pcm);
     spdlog::trace("  ecm: {}", ecm);
+    return wgt;
+}
+
+}
+
+void TwoBodyMapper::GeneratePoint(std::vector<FourVector> &mom, const std::vector<double> &rans) {
+    TwoBodyPoint(mom, rans, s2, s3);
+    Mapper<achilles::FourVector>::Print(__PRETTY_FUNCTION__, mom, rans);
+}
+
+double TwoBodyMapper::GenerateWeight(const std::vector<FourVector> &mom, std::vector<double> &rans) {
+    auto wgt = TwoBodyWeight(mom, rans);
+    Mapper<achilles::FourVector>::Print(__PRETTY_FUNCTION__, mom, rans);
+    spdlog::trace("  Weight: {}", wgt);
+
+    return wgt;
+}
+
+// The invariant mass of the hadronic system is generated flat in W^2 between
+// the mass of the nucleon and the kinematic limit
+std::pair<double, double> InelasticMapper::MassRange(const std::vector<FourVector> &mom) const {
+    const double sqrts = (mom[0] + mom[1]).M();
+    const double wmax = std::max(sqrts - sqrt(s3), sqrt(s2));
+    return {s2, wmax*wmax};
+}
+
+void InelasticMapper::GeneratePoint(std::vector<FourVector> &mom, const std::vector<double> &rans) {
+    const auto range = MassRange(mom);
+    const double w2 = range.first + (range.second - range.first)*rans[2];
+    TwoBodyPoint(mom, rans, w2, s3);
+    Mapper<achilles::FourVector>::Print(__PRETTY_FUNCTION__, mom, rans);
+    spdlog::trace("  W2 = {}", w2);
+}
+
+double InelasticMapper::GenerateWeight(const std::vector<FourVector> &mom, std::vector<double> &rans) {
+    const auto range = MassRange(mom);
+    const double dW2 = range.second - range.first;
+    rans[2] = dW2 > 0 ? (mom[2].M2() - range.first)/dW2 : 0;
+    auto wgt = TwoBodyWeight(mom, rans)/dW2;
+    Mapper<achilles::FourVector>::Print(__PRETTY_FUNCTION__, mom, rans);
+    spdlog::trace("  dW2: {}", dW2);
     spdlog::trace("  Weight: {}", wgt);
 
     return wgt;
@@ -0,0 +1,235 @@
+#include "Achilles/Foam.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+using achilles::Foam;
+using achilles::FoamCell;
+
+double FoamCell::Volume() const {
+    double volume = 1;
+    for(size_t i = 0; i < lower.size(); ++i) volume *= upper[i] - lower[i];
+    return volume;
+}
+
+Foam::Foam(size_t dims, FoamParams params_) : ndims{dims}, params{std::move(params_)} {
+    if(ndims == 0) throw std::runtime_error("Foam: At least one dimension is required");
+    if(params.nbins < 2) throw std::runtime_error("Foam: At least two bins are needed to split a cell");
+    cells.push_back({std::vector<double>(ndims, 0), std::vector<double>(ndims, 1), 1});
+    nodes.emplace_back();
+    cell_nodes.push_back(0);
+    BuildCDF();
+    ResetTrain();
+}
+
+// The first random number selects the cell, and is then rescaled to be uniform within it
+double Foam::operator()(std::vector<double> &rans) const {
+    const auto it = std::upper_bound(cdf.begin(), cdf.end(), rans[0]);
+    const auto idx = std::min(static_cast<size_t>(it - cdf.begin()), cells.size() - 1);
+    const auto &cell = cells[idx];
+    const double low = idx == 0 ? 0 : cdf[idx - 1];
+    rans[0] = std::clamp((rans[0] - low)/(cdf[idx] - low), 0.0, 1.0);
+    for(size_t i = 0; i < ndims; ++i)
+        rans[i] = cell.lower[i] + rans[i]*(cell.upper[i] - cell.lower[i]);
+    return cell.Volume()/cell.probability;
+}
+
+double Foam::GenerateWeight(const std::vector<double> &point) const {
+    const auto &cell = cells[FindCell(point)];
+    return cell.Volume()/cell.probability;
+}
+
+size_t Foam::FindCell(const std::vector<double> &point) const {
+    size_t idx = 0;
+    while(nodes[idx].left != leaf)
+        idx = point[nodes[idx].dim] < nodes[idx].position ? nodes[idx].left : nodes[idx].right;
+    return nodes[idx].cell;
+}
+
+// The stored values are chosen such that, summed over the points and divided by the number of
+// points, they estimate the integral of |f| and of f^2/volume over the cell. The largest value
+// of |f| seen in the cell is used for the maximum weight
+void Foam::AddTrainData(const std::vector<double> &point, double val2) {
+    const size_t idx = FindCell(point);
+    const auto &cell = cells[idx];
+    const double density = cell.probability/cell.Volume();
+    const double integral = std::sqrt(val2);
+    const double moment = val2*density;
+    const double value = integral*density;
+
+    auto &data = train[idx];
+    data.npoints++;
+    data.integral += integral;
+    data.moment += moment;
+    data.max_value = std::max(data.max_value, value);
+    for(size_t i = 0; i < ndims; ++i) {
+        const double x = (point[i] - cell.lower[i])/(cell.upper[i] - cell.lower[i]);
+        const auto bin = std::min(static_cast<size_t>(std::max(x, 0.0)*static_cast<double>(params.nbins)),
+                                  params.nbins - 1);
+        const size_t ibin = i*params.nbins + bin;
+        data.bin_integral[ibin] += integral;
+        data.bin_moment[ibin] += moment;
+        data.bin_max[ibin] = std::max(data.bin_max[ibin], value);
+    }
+}
+
+void Foam::Adapt() {
+    const size_t npoints = std::accumulate(train.begin(), train.end(), size_t{0},
+                                           [](size_t sum, const TrainData &data) { return sum + data.npoints; });
+    if(npoints == 0) return;
+    const auto norm = static_cast<double>(npoints);
+
+    // Cells without any points keep their previous estimates. The maximum is kept over all
+    // iterations, since a cell with an underestimated maximum receives fewer points and would
+    // otherwise never recover
+    for(size_t i = 0; i < cells.size(); ++i) {
+        if(train[i].npoints == 0) continue;
+        cells[i].integral = train[i].integral/norm;
+        cells[i].moment = train[i].moment/norm;
+        cells[i].max_value = std::max(cells[i].max_value, train[i].max_value);
+    }
+
+    // Split the cells with the largest gain, until the target efficiency is reached
+    if(Efficiency() < params.efficiency && cells.size() < params.max_cells) {
+        std::vector<SplitCandidate> candidates;
+        for(size_t i = 0; i < cells.size(); ++i) {
+            if(train[i].npoints < 2*params.nbins) continue;
+            auto candidate = BestSplit(i);
+            if(candidate.gain > 0) candidates.push_back(candidate);
+        }
+        std::sort(candidates.begin(), candidates.end(),
+                  [](const SplitCandidate &lhs, const SplitCandidate &rhs) { return lhs.gain > rhs.gain; });
+        const size_t nsplits = std::min({candidates.size(), params.splits, params.max_cells - cells.size()});
+        for(size_t i = 0; i < nsplits; ++i) Split(candidates[i], norm);
+    }
+
+    UpdateProbabilities();
+    ResetTrain();
+}
+
+double Foam::Efficiency() const {
+    double integral = 0, max_weight = 0;
+    for(const auto &cell : cells) {
+        integral += cell.integral;
+        max_weight = std::max(max_weight, cell.MaxWeight());
+    }
+    return max_weight > 0 ? integral/max_weight : 0;
+}
+
+// For the variance, the optimal probabilities are proportional to sqrt(V int f^2), and the
+// variance to the square of their sum. For the maximum weight, the optimal probabilities are
+// proportional to V max|f|, and the maximum weight to their sum
+double Foam::Objective(double volume, double moment, double max_value) const {
+    switch(params.objective) {
+        case FoamObjective::Variance:
+            return std::sqrt(volume*moment);
+        case FoamObjective::MaxWeight:
+            return volume*max_value;
+    }
+    return 0;
+}
+
+Foam::SplitCandidate Foam::BestSplit(size_t idx) const {
+    const auto &data = train[idx];
+    const double volume = cells[idx].Volume();
+    const double parent = Objective(volume, data.moment, data.max_value);
+    SplitCandidate best{idx, 0, 0, 0};
+    for(size_t i = 0; i < ndims; ++i) {
+        for(size_t bin = 1; bin < params.nbins; ++bin) {
+            double lmoment = 0, lmax = 0, rmoment = 0, rmax = 0;
+            for(size_t j = 0; j < params.nbins; ++j) {
+                const size_t ibin = i*params.nbins + j;
+                if(j < bin) {
+                    lmoment += data.bin_moment[ibin];
+                    lmax = std::max(lmax, data.bin_max[ibin]);
+                } else {
+                    rmoment += data.bin_moment[ibin];
+                    rmax = std::max(rmax, data.bin_max[ibin]);
+                }
+            }
+            const double fraction = static_cast<double>(bin)/static_cast<double>(params.nbins);
+            const double gain = parent - Objective(fraction*volume, lmoment, lmax)
+                                       - Objective((1 - fraction)*volume, rmoment, rmax);
+            // Ignore gains from rounding, e.g. for a constant integrand
+            if(gain > best.gain && gain > 1e-10*parent) best = {idx, i, bin, gain};
+        }
+    }
+    return best;
+}
+
+// The left half keeps the index of the cell, and the right half is added at the end. The
+// estimates of the halves are taken from the histograms of the points in the cell
+void Foam::Split(const SplitCandidate &candidate, double norm) {
+    const auto &data = train[candidate.cell];
+    FoamCell left = cells[candidate.cell];
+    FoamCell right = left;
+    const double fraction = static_cast<double>(candidate.bin)/static_cast<double>(params.nbins);
+    const double position = left.lower[candidate.dim]
+                          + fraction*(left.upper[candidate.dim] - left.lower[candidate.dim]);
+    left.upper[candidate.dim] = position;
+    right.lower[candidate.dim] = position;
+    left.probability *= fraction;
+    right.probability *= 1 - fraction;
+
+    left.integral = left.moment = left.max_value = 0;
+    right.integral = right.moment = right.max_value = 0;
+    for(size_t j = 0; j < params.nbins; ++j) {
+        const size_t ibin = candidate.dim*params.nbins + j;
+        auto &half = j < candidate.bin ? left : right;
+        half.integral += data.bin_integral[ibin]/norm;
+        half.moment += data.bin_moment[ibin]/norm;
+        half.max_value = std::max(half.max_value, data.bin_max[ibin]);
+    }
+
+    const size_t parent = cell_nodes[candidate.cell];
+    const size_t lnode = nodes.size();
+    const size_t rnode = lnode + 1;
+    nodes.push_back({0, leaf, leaf, candidate.cell, 0});
+    nodes.push_back({0, leaf, leaf, cells.size(), 0});
+    nodes[parent].dim = candidate.dim;
+    nodes[parent].position = position;
+    nodes[parent].left = lnode;
+    nodes[parent].right = rnode;
+
+    cells[candidate.cell] = std::move(left);
+    cells.push_back(std::move(right));
+    cell_nodes[candidate.cell] = lnode;
+    cell_nodes.push_back(rnode);
+}
+
+// A fraction of the points is always shared equally between the cells, so that every cell keeps
+// receiving points. Otherwise a cell with an underestimated maximum would hardly ever be sampled,
+// and the maximum would not be corrected
+void Foam::UpdateProbabilities() {
+    std::vector<double> targets(cells.size());
+    for(size_t i = 0; i < cells.size(); ++i)
+        targets[i] = Objective(cells[i].Volume(), cells[i].moment, cells[i].max_value);
+    const double total = std::accumulate(targets.begin(), targets.end(), 0.0);
+    const double share = 1.0/static_cast<double>(cells.size());
+    for(size_t i = 0; i < cells.size(); ++i) {
+        cells[i].probability = total > 0 ? (1 - params.mixing)*targets[i]/total + params.mixing*share
+                                         : cells[i].Volume();
+    }
+    BuildCDF();
+}
+
+void Foam::BuildCDF() {
+    cdf.resize(cells.size());
+    double sum = 0;
+    for(size_t i = 0; i < cells.size(); ++i) {
+        sum += cells[i].probability;
+        cdf[i] = sum;
+    }
+    for(auto &value : cdf) value /= sum;
+    for(size_t i = 0; i < cells.size(); ++i)
+        cells[i].probability = cdf[i] - (i == 0 ? 0 : cdf[i - 1]);
+}
+
+void Foam::ResetTrain() {
+    TrainData empty;
+    empty.bin_integral.resize(ndims*params.nbins);
+    empty.bin_moment.resize(ndims*params.nbins);
+    empty.bin_max.resize(ndims*params.nbins);
+    train.assign(cells.size(), empty);
+}
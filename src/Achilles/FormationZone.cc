@@ -0,0 +1,48 @@
+#include "Achilles/FormationZone.hh"
+#include "Achilles/Constants.hh"
+#include "Achilles/Particle.hh"
+
+#include <algorithm>
+#include <stdexcept>
+
+using achilles::ConstantFormationZone;
+using achilles::DefaultFormationZone;
+using achilles::QuantumDiffusion;
+
+void DefaultFormationZone::Form(Particle &particle, const FourVector &initial) const {
+    particle.SetFormationZone(initial, particle.Momentum());
+}
+
+ConstantFormationZone::ConstantFormationZone(const YAML::Node &node) : m_tau{node["Tau"].as<double>()} {
+    if(node["Suppression"]) m_suppression = node["Suppression"].as<double>();
+    if(m_tau < 0) throw std::runtime_error("ConstantFormationZone: The formation time must be positive");
+    if(m_suppression < 0 || m_suppression > 1)
+        throw std::runtime_error("ConstantFormationZone: The suppression must be between 0 and 1");
+}
+
+// Times in the cascade are in MeV^-1
+void ConstantFormationZone::Form(Particle &particle, const FourVector&) const {
+    const double gamma = particle.Momentum().E()/particle.Mass();
+    particle.SetFormation(gamma*m_tau/Constant::HBARC, m_suppression);
+}
+
+QuantumDiffusion::QuantumDiffusion(const YAML::Node &node) {
+    if(node["NQuarks"]) m_nquarks = node["NQuarks"].as<double>();
+    if(node["KT2"]) m_kt2 = node["KT2"].as<double>();
+    if(node["DeltaM2"]) m_deltam2 = node["DeltaM2"].as<double>();
+    if(m_nquarks <= 0 || m_kt2 <= 0 || m_deltam2 <= 0)
+        throw std::runtime_error("QuantumDiffusion: The parameters must be positive");
+}
+
+// The formation length 2p/Delta m^2 is covered in the time 2E/Delta m^2
+void QuantumDiffusion::Form(Particle &particle, const FourVector &initial) const {
+    const FourVector q = particle.Momentum() - initial;
+    const double Q2 = -q.M2();
+    const double scale = Q2 > 0 ? std::min(m_nquarks*m_nquarks*m_kt2/Q2, 1.0) : 1.0;
+    particle.SetFormation(2*particle.Momentum().E()/m_deltam2, scale);
+}
+
+double QuantumDiffusion::Suppression(const Particle &particle) const {
+    const double elapsed = std::clamp(1 - particle.FormationZone()/particle.FormationTime(), 0.0, 1.0);
+    return particle.FormationScale() + (1 - particle.FormationScale())*elapsed;
+}
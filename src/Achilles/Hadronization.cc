@@ -0,0 +1,138 @@
+#include "Achilles/Hadronization.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/ParticleInfo.hh"
+#include "Achilles/Random.hh"
+#include "Achilles/Units.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "fmt/format.h"
+#include "yaml-cpp/yaml.h"
+
+using achilles::Hadronization;
+
+namespace {
+
+// Momentum of the decay products of a two body decay a -> b + c in the rest frame of a
+double TwoBodyMomentum(double a, double b, double c) {
+    const double x = (a - b - c)*(a + b + c)*(a - b + c)*(a + b - c);
+    return x > 0 ? std::sqrt(x)/(2*a) : 0;
+}
+
+}
+
+Hadronization::Hadronization(double a, double b) : m_a{a}, m_b{b} {
+    if(m_b < 0)
+        throw std::runtime_error("Hadronization: Multiplicity slope must be non-negative");
+}
+
+Hadronization::Hadronization(const YAML::Node &node)
+    : Hadronization(node && node["MultiplicityA"] ? node["MultiplicityA"].as<double>() : 0.4,
+                    node && node["MultiplicityB"] ? node["MultiplicityB"].as<double>() : 1.4) {}
+
+double Hadronization::AverageMultiplicity(double W) const {
+    const double W2 = W*W/1.0_GeV/1.0_GeV;
+    return std::max(m_a + m_b*std::log(W2), 1.0);
+}
+
+double Hadronization::Threshold() {
+    return std::max(ParticleInfo(PID::proton()).Mass(), ParticleInfo(PID::neutron()).Mass())
+        + ParticleInfo(PID::pionp()).Mass();
+}
+
+std::vector<achilles::Particle> Hadronization::operator()(const FourVector &momentum, int charge,
+                                                          const ThreeVector &position) const {
+    const double W = momentum.M();
+    const double mpi = ParticleInfo(PID::pionp()).Mass();
+    const double nmax = std::floor((W - Threshold())/mpi) + 1;
+    if(nmax < 1 || charge < -1 || charge > 2)
+        throw std::runtime_error(fmt::format("Hadronization: Can not hadronize W = {} MeV with charge {}",
+                                             W, charge));
+
+    const double extra = AverageMultiplicity(W) - 1;
+    const size_t nsampled = 1 + (extra > 0 ? Random::Instance().Poisson<size_t>(extra) : 0);
+    const size_t npions = std::min(nsampled, static_cast<size_t>(nmax));
+
+    // Assign the charges, where the last pion balances the charge
+    std::vector<PID> ids(npions + 1);
+    while(true) {
+        int total = charge;
+        ids[0] = Random::Instance().Uniform(0.0, 1.0) < 0.5 ? PID::proton() : PID::neutron();
+        if(ids[0] == PID::proton()) total--;
+        for(size_t i = 1; i < npions; ++i) {
+            const int pion_charge = static_cast<int>(Random::Instance().Uniform(0.0, 3.0)) - 1;
+            ids[i] = pion_charge == 0 ? PID::pion0() : PID{pion_charge*PID::pionp().AsInt()};
+            total -= pion_charge;
+        }
+        if(std::abs(total) > 1) continue;
+        ids[npions] = total == 0 ? PID::pion0() : PID{total*PID::pionp().AsInt()};
+        break;
+    }
+
+    std::vector<double> masses;
+    for(const auto &id : ids) masses.push_back(ParticleInfo(id).Mass());
+    const auto momenta = PhaseSpaceDecay(momentum, masses);
+
+    std::vector<Particle> hadrons;
+    for(size_t i = 0; i < ids.size(); ++i)
+        hadrons.emplace_back(ids[i], momenta[i], position, ParticleStatus::propagating);
+    return hadrons;
+}
+
+// The intermediate masses are sampled uniformly and unweighted against the product of the
+// two body momenta (GENBOD), and each two body decay is isotropic in its rest frame
+std::vector<achilles::FourVector> Hadronization::PhaseSpaceDecay(const FourVector &momentum,
+                                                                 const std::vector<double> &masses) {
+    const size_t n = masses.size();
+    const double W = momentum.M();
+    const double kinetic = W - std::accumulate(masses.begin(), masses.end(), 0.0);
+    if(kinetic < 0)
+        throw std::runtime_error("Hadronization: Decay products are heavier than the system");
+    if(n == 1) return {momentum};
+
+    // Maximum weight of the product of the two body momenta
+    double wgt_max = 1, emax = kinetic + masses[0], emin = 0;
+    for(size_t i = 1; i < n; ++i) {
+        emin += masses[i-1];
+        emax += masses[i];
+        wgt_max *= TwoBodyMomentum(emax, emin, masses[i]);
+    }
+
+    std::vector<double> invariant(n), pd(n-1);
+    while(true) {
+        std::vector<double> rans(n, 0);
+        rans[n-1] = 1;
+        for(size_t i = 1; i < n-1; ++i) rans[i] = Random::Instance().Uniform(0.0, 1.0);
+        std::sort(rans.begin(), rans.end());
+
+        double sum = 0, wgt = 1;
+        for(size_t i = 0; i < n; ++i) {
+            sum += masses[i];
+            invariant[i] = rans[i]*kinetic + sum;
+        }
+        for(size_t i = 0; i < n-1; ++i) {
+            pd[i] = TwoBodyMomentum(invariant[i+1], invariant[i], masses[i+1]);
+            wgt *= pd[i];
+        }
+        if(Random::Instance().Uniform(0.0, 1.0)*wgt_max <= wgt) break;
+    }
+
+    // Split off one particle at a time, starting from the full system
+    std::vector<FourVector> result(n);
+    FourVector system = momentum;
+    for(size_t i = n-1; i > 0; --i) {
+        const double cosT = Random::Instance().Uniform(-1.0, 1.0);
+        const double sinT = std::sqrt(1 - cosT*cosT);
+        const double phi = Random::Instance().Uniform(0.0, 2*M_PI);
+        const ThreeVector dir{sinT*std::cos(phi), sinT*std::sin(phi), cosT};
+        const auto boost = system.BoostVector();
+        const double p = pd[i-1];
+        result[i] = FourVector(-p*dir, std::sqrt(p*p + masses[i]*masses[i])).Boost(boost);
+        system = FourVector(p*dir, std::sqrt(p*p + invariant[i-1]*invariant[i-1])).Boost(boost);
+    }
+    result[0] = system;
+    return result;
+}
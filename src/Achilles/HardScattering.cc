@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
@@ -9,6 +10,7 @@
 #include "Achilles/HardScatteringFactory.hh"
 #include "Achilles/Event.hh"
 #include "Achilles/Random.hh"
+#include "Achilles/Utilities.hh"
 
 // Aliases for most common types
 using achilles::Particles;
@@ -148,6 +150,49 @@ achilles::Currents LeptonicCurrent::CalcCurrents(const std::vector<FourVector> &
     return currents;
 }
 
+achilles::Tensors LeptonicCurrent::CalcTensors(const std::vector<FourVector> &p,
+                                               const double&) const {
+    // Momenta entering the spin sums of the spinors in CalcCurrents
+    const FourVector &k = anti ? p.back() : p[1];
+    const FourVector &kbar = anti ? p[1] : p.back();
+    const double m = std::sqrt(std::max(k.M2(), 0.0));
+    const double mbar = std::sqrt(std::max(kbar.M2(), 0.0));
+
+    double q2 = (p[1] - p.back()).M2();
+    std::complex<double> prop = std::complex<double>(0, 1)/(q2-mass*mass-std::complex<double>(0, 1)*mass*width);
+
+    // Tr[(kbar + mbar) gamma^mu (cL PL + cR PR) (k + m) gamma^nu (cL* PL + cR* PR)]
+    const double cv = std::norm(coupl_left) + std::norm(coupl_right);
+    const double ca = std::norm(coupl_left) - std::norm(coupl_right);
+    const double cm = 4*mbar*m*std::real(coupl_left*std::conj(coupl_right));
+    const double kdot = kbar*k;
+    static constexpr std::array<double, 4> metric{1, -1, -1, -1};
+    std::array<double, 4> klow{}, kbarlow{};
+    for(size_t mu = 0; mu < 4; ++mu) {
+        klow[mu] = metric[mu]*k[mu];
+        kbarlow[mu] = metric[mu]*kbar[mu];
+    }
+
+    Tensor result{};
+    for(size_t mu = 0; mu < 4; ++mu) {
+        for(size_t nu = 0; nu < 4; ++nu) {
+            std::complex<double> value = 2*cv*(kbar[mu]*k[nu] + kbar[nu]*k[mu]);
+            if(mu == nu) value += metric[mu]*(cm - 2*cv*kdot);
+            // Antisymmetric part from the axial coupling
+            for(size_t alpha = 0; alpha < 4; ++alpha) {
+                for(size_t beta = 0; beta < 4; ++beta) {
+                    const double eps = LeviCivita(mu, nu, alpha, beta);
+                    if(eps == 0) continue;
+                    value -= std::complex<double>(0, 2*ca)*eps*kbarlow[alpha]*klow[beta];
+                }
+            }
+            result[4*mu+nu] = value*std::norm(prop);
+        }
+    }
+
+    return {{pid, result}};
+}
+
 void HardScattering::SetProcess(const Process_Info &process) {
     spdlog::debug("Adding Process: {}", process);
     m_leptonicProcess = process;
@@ -187,29 +232,63 @@ achilles::Currents HardScattering::LeptonicCurrents(const std::vector<FourVector
 }
 
 std::vector<double> HardScattering::CrossSection(Event &event) const {
-    // Calculate leptonic currents
-    auto leptonCurrent = LeptonicCurrents(event.Momentum(), 100);
+    return UseTensors() ? TensorCrossSection(event) : AmplitudeCrossSection(event);
+}
 
-    // Calculate the hadronic currents
+bool HardScattering::UseTensors() const {
+#ifdef ENABLE_BSM
+    // The currents from Sherpa may include several bosons and are only known numerically
+    return false;
+#else
+    return m_nuclear -> HasTensors();
+#endif
+}
+
+const std::vector<achilles::NuclearModel::FFInfoMap>&
+HardScattering::FFInfo(const std::vector<int> &bosons) const {
     // TODO: Clean this up and make generic for the nuclear model
     // TODO: Move this to initialization to remove check each time
     static std::vector<NuclearModel::FFInfoMap> ffInfo;
     if(ffInfo.empty()) {
         ffInfo.resize(3);
-        for(const auto &current : leptonCurrent) {
+        for(const auto &boson : bosons) {
 #ifdef ENABLE_BSM
-            ffInfo[0][current.first] = p_sherpa -> FormFactors(PID::proton(), current.first);
-            ffInfo[1][current.first] = p_sherpa -> FormFactors(PID::neutron(), current.first);
-            ffInfo[2][current.first] = p_sherpa -> FormFactors(PID::carbon(), current.first);
+            ffInfo[0][boson] = p_sherpa -> FormFactors(PID::proton(), boson);
+            ffInfo[1][boson] = p_sherpa -> FormFactors(PID::neutron(), boson);
+            ffInfo[2][boson] = p_sherpa -> FormFactors(PID::carbon(), boson);
 #else
             // TODO: Define values somewhere
-            ffInfo[0][current.first] = SMFormFactor.at({PID::proton(), current.first});
-            ffInfo[1][current.first] = SMFormFactor.at({PID::neutron(), current.first});
-            ffInfo[2][current.first] = SMFormFactor.at({PID::carbon(), current.first});
+            ffInfo[0][boson] = SMFormFactor.at({PID::proton(), boson});
+            ffInfo[1][boson] = SMFormFactor.at({PID::neutron(), boson});
+            ffInfo[2][boson] = SMFormFactor.at({PID::carbon(), boson});
 #endif
         }
     }
-    auto hadronCurrent = m_nuclear -> CalcCurrents(event, ffInfo);
+    return ffInfo;
+}
+
+double HardScattering::Normalization(const Event &event) const {
+    double spin_avg = 1;
+    if(!ParticleInfo(m_leptonicProcess.m_ids[0]).IsNeutrino()) spin_avg *= 2;
+    if(m_nuclear -> NSpins() > 1) spin_avg *= 2;
+
+    // TODO: Correct this flux
+    // double flux = 4*sqrt(pow(event.Momentum()[0]*event.Momentum()[1], 2) 
+    //                      - event.Momentum()[0].M2()*event.Momentum()[1].M2());
+    double mass = ParticleInfo(m_leptonicProcess.m_states.begin()->first[0]).Mass();
+    double flux = 2*event.Momentum()[1].E()*2*sqrt(event.Momentum()[0].P2() + mass*mass);
+    static constexpr double to_nb = 1e6;
+    return Constant::HBARC2/spin_avg/flux*to_nb;
+}
+
+std::vector<double> HardScattering::AmplitudeCrossSection(Event &event) const {
+    // Calculate leptonic currents
+    auto leptonCurrent = LeptonicCurrents(event.Momentum(), 100);
+
+    // Calculate the hadronic currents
+    std::vector<int> bosons;
+    for(const auto &current : leptonCurrent) bosons.push_back(current.first);
+    auto hadronCurrent = m_nuclear -> CalcCurrents(event, FFInfo(bosons));
 
     std::vector<double> amps2(hadronCurrent.size());
     const size_t nlep_spins = leptonCurrent.begin()->second.size();
@@ -233,19 +312,45 @@ std::vector<double> HardScattering::CrossSection(Event &event) const {
         }
     }
 
-    double spin_avg = 1;
-    if(!ParticleInfo(m_leptonicProcess.m_ids[0]).IsNeutrino()) spin_avg *= 2;
-    if(m_nuclear -> NSpins() > 1) spin_avg *= 2;
-
-    // TODO: Correct this flux
-    // double flux = 4*sqrt(pow(event.Momentum()[0]*event.Momentum()[1], 2) 
-    //                      - event.Momentum()[0].M2()*event.Momentum()[1].M2());
-    double mass = ParticleInfo(m_leptonicProcess.m_states.begin()->first[0]).Mass();
-    double flux = 2*event.Momentum()[1].E()*2*sqrt(event.Momentum()[0].P2() + mass*mass);
-    static constexpr double to_nb = 1e6;
+    const double norm = Normalization(event);
     std::vector<double> xsecs(hadronCurrent.size());
     for(size_t i = 0; i < hadronCurrent.size(); ++i) {
-        xsecs[i] = amps2[i]*Constant::HBARC2/spin_avg/flux*to_nb;
+        xsecs[i] = amps2[i]*norm;
+        spdlog::debug("Xsec[{}] = {}", i, xsecs[i]);
+    }
+
+    return xsecs;
+}
+
+std::vector<double> HardScattering::TensorCrossSection(Event &event) const {
+    // Calculate the leptonic and hadronic tensors
+    auto leptonTensor = m_current.CalcTensors(event.Momentum(), 100);
+    std::vector<int> bosons;
+    for(const auto &tensor : leptonTensor) bosons.push_back(tensor.first);
+    auto hadronTensor = m_nuclear -> CalcTensors(event, FFInfo(bosons));
+
+    // Contract L^{\mu\nu} W_{\mu\nu}, which is real for the spin summed tensors
+    static constexpr std::array<double, 4> metric{1, -1, -1, -1};
+    std::vector<double> amps2(hadronTensor.size());
+    for(const auto &ltensor : leptonTensor) {
+        const auto boson = ltensor.first;
+        for(size_t k = 0; k < hadronTensor.size(); ++k) {
+            if(hadronTensor[k].find(boson) == hadronTensor[k].end()) continue;
+            const auto &htensor = hadronTensor[k].at(boson);
+            std::complex<double> amp2{};
+            for(size_t mu = 0; mu < 4; ++mu) {
+                for(size_t nu = 0; nu < 4; ++nu) {
+                    amp2 += metric[mu]*metric[nu]*ltensor.second[4*mu+nu]*htensor[4*mu+nu];
+                }
+            }
+            amps2[k] += amp2.real();
+        }
+    }
+
+    const double norm = Normalization(event);
+    std::vector<double> xsecs(hadronTensor.size());
+    for(size_t i = 0; i < hadronTensor.size(); ++i) {
+        xsecs[i] = amps2[i]*norm;
         spdlog::debug("Xsec[{}] = {}", i, xsecs[i]);
     }
 
@@ -258,6 +363,8 @@ bool HardScattering::FillEvent(Event& event, const std::vector<double> &xsecs) c
    
     event.InitializeLeptons(m_leptonicProcess);
     event.InitializeHadrons(m_leptonicProcess);
+    m_nuclear -> Hadronize(event);
+    m_nuclear -> FillCorrelations(event);
 
     return true;
 }
@@ -0,0 +1,58 @@
+#include "Achilles/EventMerger.hh"
+#include "Achilles/Version.hh"
+#include "Achilles/Logging.hh"
+#ifdef ENABLE_HEPMC3
+#include "plugins/HepMC3/HepMC3EventMerger.hh"
+#endif
+
+#include "docopt.h"
+#include "fmt/format.h"
+
+static const std::string USAGE =
+R"(
+    Usage:
+      achilles-merge <output> <inputs>... [--format=<format>] [--keep-weights] [--unzipped] [-v | -vv]
+      achilles-merge (-h | --help)
+      achilles-merge --version
+
+    Options:
+      -f <format> --format=<format>   Format of the event files (Achilles or HepMC3) [default: Achilles].
+      --keep-weights                  Keep the event weights instead of unweighting to a common maximum.
+      --unzipped                      Do not compress the HepMC3 output.
+      -v[v]                           Increase verbosity level.
+      -h --help                       Show this screen.
+      --version                       Show version.
+)";
+
+int main(int argc, char *argv[]) {
+
+    std::map<std::string, docopt::value> args = docopt::docopt(USAGE,
+                                                    { argv + 1, argv + argc },
+                                                    true, // show help if requested
+                                                    fmt::format("achilles-merge {}", ACHILLES_VERSION)); //version string
+
+    auto verbosity = static_cast<int>(2 - args["-v"].asLong());
+    CreateLogger(verbosity, 5);
+
+    const auto inputs = args["<inputs>"].asStringList();
+    const bool reunweight = !args["--keep-weights"].asBool();
+    const auto format = args["--format"].asString();
+
+    std::unique_ptr<achilles::EventMerger> merger;
+    if(format == "Achilles") {
+        merger = std::make_unique<achilles::AchillesMerger>(inputs, reunweight);
+#ifdef ENABLE_HEPMC3
+    } else if(format == "HepMC3") {
+        merger = std::make_unique<achilles::HepMC3Merger>(inputs, reunweight,
+                                                          !args["--unzipped"].asBool());
+#endif
+    } else {
+        spdlog::error("achilles-merge: Invalid format {}", format);
+        return 1;
+    }
+
+    merger -> Initialize();
+    merger -> Merge(args["<output>"].asString());
+
+    return 0;
+}
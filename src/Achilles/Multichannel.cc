@@ -4,6 +4,7 @@ achilles::MultiChannel::MultiChannel(size_t dims, size_t nchannels, MultiChannel
                                     : ndims{std::move(dims)}, params{std::move(params_)} {
     for(size_t i = 0; i < nchannels; ++i) {
         channel_weights.push_back(1.0/static_cast<double>(nchannels));
+        channel_ids.push_back(i);
     }
 }
 
@@ -34,6 +35,17 @@ void achilles::MultiChannel::Adapt(const std::vector<double> &train) {
     channel_weights = new_weights;
 }
 
+// Select the channel by inverting the cumulative distribution of the channel weights
+size_t achilles::MultiChannel::SelectChannel(double ran) const {
+    const double total = std::accumulate(channel_weights.begin(), channel_weights.end(), 0.0);
+    double sum = 0;
+    for(size_t i = 0; i < channel_weights.size(); ++i) {
+        sum += channel_weights[i];
+        if(ran*total < sum) return i;
+    }
+    return channel_weights.size() - 1;
+}
+
 void achilles::MultiChannel::MaxDifference(const std::vector<double> &train) {
     double max = 0;
 
@@ -54,13 +66,23 @@ void achilles::MultiChannel::MaxDifference(const std::vector<double> &train) {
 
 achilles::MultiChannelSummary achilles::MultiChannel::Summary() {
     summary.best_weights = best_weights;
+    summary.channel_ids = channel_ids;
     std::cout << "Final integral = "
               << fmt::format("{:^8.5e} +/- {:^8.5e} ({:^8.5e} %)",
                              summary.Result().Mean(), summary.Result().Error(),
                              summary.Result().Error() / summary.Result().Mean()*100) << std::endl;
+    if(summary.Result().NegativeCalls() > 0) {
+        std::cout << fmt::format("  Positive = {:^8.5e}, Negative = {:^8.5e}",
+                                 summary.Result().PositiveMean(), summary.Result().NegativeMean()) << std::endl;
+    }
     std::cout << "Channel weights:\n";
     for(size_t i = 0; i < best_weights.size(); ++i) {
-        std::cout << "  alpha(" << i << ") = " << best_weights[i] << "\n";
+        std::cout << "  alpha(" << channel_ids[i] << ") = " << best_weights[i] << "\n";
+    }
+    if(!summary.pruned.empty()) std::cout << "Removed " << summary.pruned.size() << " channels\n";
+    for(size_t i = 0; i < control_coefficients.size(); ++i) {
+        if(i == 0) std::cout << "Control variate coefficients:\n";
+        std::cout << "  c(" << i << ") = " << control_coefficients[i] << "\n";
     }
     return summary;
 }
@@ -0,0 +1,254 @@
+#include "Achilles/NormalizingFlow.hh"
+#include "Achilles/Random.hh"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "spdlog/spdlog.h"
+
+achilles::NormalizingFlow::Parameter::Parameter(Eigen::MatrixXd val) : value{std::move(val)} {
+    grad = Eigen::MatrixXd::Zero(value.rows(), value.cols());
+    m = grad;
+    v = grad;
+}
+
+// Single step of the Adam optimizer (arXiv:1412.6980)
+void achilles::NormalizingFlow::Parameter::Step(double learning_rate, size_t step) {
+    static constexpr double beta1 = 0.9, beta2 = 0.999, eps = 1e-8;
+    const double t = static_cast<double>(step);
+    m = beta1*m + (1-beta1)*grad;
+    v = beta2*v + (1-beta2)*grad.cwiseAbs2();
+    const double mscale = 1.0/(1-std::pow(beta1, t));
+    const double vscale = 1.0/(1-std::pow(beta2, t));
+    value.array() -= learning_rate*mscale*m.array()/((vscale*v.array()).sqrt() + eps);
+    grad.setZero();
+}
+
+achilles::NormalizingFlow::NormalizingFlow(size_t dims, FlowParams params_)
+                                          : ndims{std::move(dims)}, params{std::move(params_)} {
+    if(ndims == 0) throw std::runtime_error("NormalizingFlow: Requires at least one dimension");
+    if(params.nlayers == 0 || params.nbins == 0 || params.nhidden == 0)
+        throw std::runtime_error("NormalizingFlow: Invalid parameters");
+    Initialize();
+}
+
+void achilles::NormalizingFlow::Initialize() {
+    // Alternate the transformed dimensions using the bits of the dimension index,
+    // so that every dimension is conditioned on every other one after a few layers
+    size_t nbits = 1;
+    while((size_t(1) << nbits) < ndims) ++nbits;
+
+    layers.resize(params.nlayers);
+    for(size_t i = 0; i < params.nlayers; ++i) {
+        auto &layer = layers[i];
+        if(ndims == 1) {
+            layer.trans.push_back(0);
+        } else {
+            const size_t bit = (i / 2) % nbits;
+            for(size_t j = 0; j < ndims; ++j) {
+                if(((j >> bit) & 1) == i % 2) layer.trans.push_back(j);
+                else layer.cond.push_back(j);
+            }
+        }
+
+        // The output layer starts at zero, which makes the flow the identity map
+        const auto ncond = static_cast<Eigen::Index>(layer.cond.size());
+        const auto ntrans = static_cast<Eigen::Index>(layer.trans.size());
+        const auto nhidden = static_cast<Eigen::Index>(params.nhidden);
+        const auto nbins = static_cast<Eigen::Index>(params.nbins);
+        const double scale = std::sqrt(6.0/static_cast<double>(ncond + nhidden));
+        Eigen::MatrixXd w1(nhidden, ncond);
+        for(Eigen::Index j = 0; j < w1.size(); ++j)
+            w1.data()[j] = Random::Instance().Uniform(-scale, scale);
+        layer.w1 = Parameter(w1);
+        layer.b1 = Parameter(Eigen::MatrixXd::Zero(nhidden, 1));
+        layer.w2 = Parameter(Eigen::MatrixXd::Zero(ntrans*nbins, nhidden));
+        layer.b2 = Parameter(Eigen::MatrixXd::Zero(ntrans*nbins, 1));
+    }
+}
+
+void achilles::NormalizingFlow::Conditioner(const Layer &layer, const std::vector<double> &point,
+                                            LayerCache &cache) const {
+    const auto nbins = static_cast<Eigen::Index>(params.nbins);
+    const auto ntrans = static_cast<Eigen::Index>(layer.trans.size());
+
+    cache.x_cond.resize(static_cast<Eigen::Index>(layer.cond.size()));
+    for(size_t i = 0; i < layer.cond.size(); ++i)
+        cache.x_cond(static_cast<Eigen::Index>(i)) = point[layer.cond[i]];
+    cache.pre = layer.w1.value*cache.x_cond + layer.b1.value;
+    cache.hidden = cache.pre.cwiseMax(0);
+    Eigen::VectorXd logits = layer.w2.value*cache.hidden + layer.b2.value;
+
+    // Softmax over the bins for each transformed dimension
+    cache.prob.resize(ntrans, nbins);
+    for(Eigen::Index j = 0; j < ntrans; ++j) {
+        auto segment = logits.segment(j*nbins, nbins);
+        cache.prob.row(j) = (segment.array() - segment.maxCoeff()).exp().transpose();
+        cache.prob.row(j) /= cache.prob.row(j).sum();
+    }
+    cache.bins.resize(layer.trans.size());
+}
+
+double achilles::NormalizingFlow::Forward(const std::vector<double> &rans,
+                                          std::vector<double> &point) const {
+    const auto nbins = static_cast<double>(params.nbins);
+    point = rans;
+    double density = 1;
+    LayerCache cache;
+    for(const auto &layer : layers) {
+        Conditioner(layer, point, cache);
+        for(size_t j = 0; j < layer.trans.size(); ++j) {
+            const auto row = static_cast<Eigen::Index>(j);
+            const double y = point[layer.trans[j]];
+            Eigen::Index bin = 0;
+            double cdf = 0;
+            while(bin < cache.prob.cols()-1 && cdf + cache.prob(row, bin) <= y)
+                cdf += cache.prob(row, bin++);
+            const double prob = cache.prob(row, bin);
+            const double x = (static_cast<double>(bin) + (y - cdf)/prob)/nbins;
+            point[layer.trans[j]] = std::min(std::max(x, 0.0), 1.0);
+            density *= nbins*prob;
+        }
+    }
+    return density;
+}
+
+double achilles::NormalizingFlow::Inverse(const std::vector<double> &point,
+                                          std::vector<double> &rans) const {
+    const auto nbins = static_cast<double>(params.nbins);
+    rans = point;
+    double density = 1;
+    LayerCache cache;
+    for(auto it = layers.rbegin(); it != layers.rend(); ++it) {
+        Conditioner(*it, rans, cache);
+        for(size_t j = 0; j < it -> trans.size(); ++j) {
+            const auto row = static_cast<Eigen::Index>(j);
+            const double x = rans[it -> trans[j]]*nbins;
+            const auto bin = std::min(std::max(static_cast<Eigen::Index>(x), Eigen::Index{0}),
+                                      cache.prob.cols()-1);
+            const double prob = cache.prob(row, bin);
+            const double cdf = cache.prob.row(row).head(bin).sum();
+            rans[it -> trans[j]] = std::min(cdf + (x - static_cast<double>(bin))*prob, 1.0);
+            density *= nbins*prob;
+        }
+    }
+    return density;
+}
+
+void achilles::NormalizingFlow::AddTrainData(const std::vector<double> &point, double density,
+                                             double val2) {
+    if(val2 == 0 || density == 0) return;
+    train_points.insert(train_points.end(), point.begin(), point.end());
+    train_densities.push_back(density);
+    train_weights.push_back(val2);
+}
+
+// Accumulate the gradient of the variance loss for a single point. The gradient of the
+// variance with respect to the flow parameters is given by E[(f/q)^2 * grad(-log q)], where
+// the point is held fixed and the dependence of q enters through the inverse of the flow.
+// Points from earlier optimizer steps are reweighted by the ratio of the density they were
+// sampled with to the current density.
+// Returns the weight of the point for normalizing the gradient
+double achilles::NormalizingFlow::Gradient(const std::vector<double> &point, double scale) {
+    const auto nbins = static_cast<double>(params.nbins);
+
+    // Run the inverse, keeping track of the intermediate values
+    std::vector<LayerCache> caches(layers.size());
+    std::vector<std::vector<double>> outputs(layers.size());
+    std::vector<double> x = point;
+    double density = 1;
+    for(size_t i = layers.size(); i-- > 0;) {
+        outputs[i] = x;
+        auto &cache = caches[i];
+        Conditioner(layers[i], x, cache);
+        for(size_t j = 0; j < layers[i].trans.size(); ++j) {
+            const auto row = static_cast<Eigen::Index>(j);
+            const double y = x[layers[i].trans[j]]*nbins;
+            const auto bin = std::min(std::max(static_cast<Eigen::Index>(y), Eigen::Index{0}),
+                                      cache.prob.cols()-1);
+            const double prob = cache.prob(row, bin);
+            x[layers[i].trans[j]] = cache.prob.row(row).head(bin).sum()
+                                  + (y - static_cast<double>(bin))*prob;
+            cache.bins[j] = static_cast<size_t>(bin);
+            density *= nbins*prob;
+        }
+    }
+    const double weight = scale/density;
+
+    // Backpropagate from the base distribution to the point
+    std::vector<double> grad(ndims, 0);
+    for(size_t i = 0; i < layers.size(); ++i) {
+        auto &layer = layers[i];
+        const auto &cache = caches[i];
+        const auto ntrans = static_cast<Eigen::Index>(layer.trans.size());
+        const auto nbin = cache.prob.cols();
+
+        Eigen::MatrixXd dprob = Eigen::MatrixXd::Zero(ntrans, nbin);
+        for(size_t j = 0; j < layer.trans.size(); ++j) {
+            const auto row = static_cast<Eigen::Index>(j);
+            const auto bin = static_cast<Eigen::Index>(cache.bins[j]);
+            const double prob = cache.prob(row, bin);
+            const double alpha = outputs[i][layer.trans[j]]*nbins - static_cast<double>(bin);
+            double &g = grad[layer.trans[j]];
+
+            dprob(row, bin) += g*alpha - weight/prob;
+            dprob.row(row).head(bin).array() += g;
+            g *= nbins*prob;
+        }
+
+        Eigen::VectorXd dlogits(ntrans*nbin);
+        for(Eigen::Index j = 0; j < ntrans; ++j) {
+            const double dot = cache.prob.row(j).dot(dprob.row(j));
+            dlogits.segment(j*nbin, nbin) = (cache.prob.row(j).array()
+                                          * (dprob.row(j).array() - dot)).transpose();
+        }
+        layer.w2.grad += dlogits*cache.hidden.transpose();
+        layer.b2.grad += dlogits;
+
+        Eigen::VectorXd dpre = layer.w2.value.transpose()*dlogits;
+        dpre.array() *= (cache.pre.array() > 0).cast<double>();
+        layer.w1.grad += dpre*cache.x_cond.transpose();
+        layer.b1.grad += dpre;
+
+        Eigen::VectorXd dcond = layer.w1.value.transpose()*dpre;
+        for(size_t j = 0; j < layer.cond.size(); ++j)
+            grad[layer.cond[j]] += dcond(static_cast<Eigen::Index>(j));
+    }
+
+    return weight;
+}
+
+void achilles::NormalizingFlow::Train() {
+    const size_t npoints = train_weights.size();
+    if(npoints == 0) return;
+
+    // Take one optimizer step per batch of points, running over all the points nepochs times
+    std::vector<double> point(ndims);
+    const size_t nbatch = std::min(params.batch_size, npoints);
+    for(size_t epoch = 0; epoch < params.nepochs; ++epoch) {
+        double sum_loss = 0;
+        for(size_t start = 0; start + nbatch <= npoints; start += nbatch) {
+            double sum_weights = 0;
+            for(size_t i = start; i < start + nbatch; ++i) {
+                auto it = train_points.begin() + static_cast<std::ptrdiff_t>(i*ndims);
+                std::copy(it, it + static_cast<std::ptrdiff_t>(ndims), point.begin());
+                sum_weights += Gradient(point, train_weights[i]*train_densities[i]);
+            }
+            sum_loss += sum_weights;
+
+            ++nsteps;
+            for(auto &layer : layers) {
+                for(auto *param : {&layer.w1, &layer.b1, &layer.w2, &layer.b2}) {
+                    param -> grad /= sum_weights;
+                    param -> Step(params.learning_rate, nsteps);
+                }
+            }
+        }
+        loss = sum_loss/static_cast<double>(npoints - npoints % nbatch);
+    }
+    spdlog::debug("NormalizingFlow::Train: loss = {} after {} steps", loss, nsteps);
+
+    train_points.clear();
+    train_densities.clear();
+    train_weights.clear();
+}
@@ -4,10 +4,16 @@
 #include "Achilles/Nucleus.hh"
 #include "Achilles/Spinor.hh"
 #include "Achilles/Particle.hh"
+#include "Achilles/Random.hh"
+#include "Achilles/Utilities.hh"
+
+#include <algorithm>
+#include <limits>
 
 using achilles::NuclearModel;
 using achilles::Coherent;
 using achilles::QESpectral;
+using achilles::InelasticSpectral;
 
 NuclearModel::NuclearModel(const YAML::Node& config,
                            FormFactorBuilder &ffbuilder = FormFactorBuilder::Instance()) {
@@ -52,6 +58,11 @@ NuclearModel::FormFactorArray NuclearModel::CouplingsFF(const FormFactor::Values
     return results;
 }
 
+std::vector<NuclearModel::Tensors> NuclearModel::CalcTensors(const Event&,
+                                                            const std::vector<FFInfoMap>&) const {
+    throw std::runtime_error(fmt::format("NuclearModel: {} does not provide hadronic tensors", PhaseSpace()));
+}
+
 YAML::Node NuclearModel::LoadFormFactor(const YAML::Node &config) {
     return YAML::LoadFile(config["NuclearModel"]["FormFactorFile"].as<std::string>());
 }
@@ -94,6 +105,26 @@ std::vector<achilles::NuclearModel::Currents> Coherent::CalcCurrents(const Event
     return results;
 }
 
+std::vector<NuclearModel::Tensors> Coherent::CalcTensors(const Event &event,
+                                                        const std::vector<FFInfoMap> &ff) const {
+    // Only a single spin state, so the tensor is the outer product of the current
+    const auto currents = CalcCurrents(event, ff);
+    std::vector<Tensors> results(currents.size());
+    for(size_t i = 0; i < currents.size(); ++i) {
+        for(const auto &current : currents[i]) {
+            const auto &subcur = current.second[0];
+            Tensor tensor{};
+            for(size_t mu = 0; mu < 4; ++mu) {
+                for(size_t nu = 0; nu < 4; ++nu) {
+                    tensor[4*mu+nu] = subcur[mu]*std::conj(subcur[nu]);
+                }
+            }
+            results[i][current.first] = tensor;
+        }
+    }
+    return results;
+}
+
 void Coherent::AllowedStates(Process_Info &info) const {
     // Check for charge conservation
     int charge = -ParticleInfo(info.m_ids[0]).IntCharge();
@@ -139,6 +170,20 @@ QESpectral::QESpectral(const YAML::Node &config, const YAML::Node &form_factor,
           spectral_proton{config["NuclearModel"]["SpectralP"].as<std::string>()},
           spectral_neutron{config["NuclearModel"]["SpectralN"].as<std::string>()} {
     b_ward = config["NuclearModel"]["Ward"].as<bool>();
+
+    const auto src = config["NuclearModel"]["SRC"];
+    if(src) {
+        m_src.enabled = true;
+        if(src["MomentumCut"]) m_src.momentum_cut = src["MomentumCut"].as<double>();
+        if(src["PairRatio"]) m_src.pair_ratio = src["PairRatio"].as<double>();
+        if(src["CMWidth"]) m_src.cm_width = src["CMWidth"].as<double>();
+        if(src["MeanFieldP"] && src["MeanFieldN"]) {
+            m_src.mean_field_proton = std::make_shared<SpectralFunction>(src["MeanFieldP"].as<std::string>());
+            m_src.mean_field_neutron = std::make_shared<SpectralFunction>(src["MeanFieldN"].as<std::string>());
+        }
+        if(m_src.pair_ratio < 0 || m_src.cm_width < 0)
+            throw std::runtime_error("QESpectral: SRC pair ratio and CM width must be non-negative");
+    }
 }
 
 std::vector<NuclearModel::Currents> QESpectral::CalcCurrents(const Event &event,
@@ -193,6 +238,60 @@ std::vector<NuclearModel::Currents> QESpectral::CalcCurrents(const Event &event,
     return results;
 }
 
+std::vector<NuclearModel::Tensors> QESpectral::CalcTensors(const Event &event,
+                                                          const std::vector<FFInfoMap> &ff) const {
+    auto pIn = event.Momentum().front();
+    auto pOut = event.Momentum()[2];
+    auto qVec = event.Momentum()[1];
+    for(size_t i = 3; i < event.Momentum().size(); ++i) {
+        qVec -= event.Momentum()[i];
+    }
+    auto removal_energy = Constant::mN - pIn.E();
+    auto free_energy = sqrt(pIn.P2() + Constant::mN2);
+    auto ffVals = EvalFormFactor(-qVec.M2()/1.0_GeV/1.0_GeV);
+    auto omega = qVec.E();
+    qVec.E() = qVec.E() + pIn.E() - free_energy;
+
+    std::vector<Tensors> results(2);
+    std::vector<double> spectral(2);
+    spectral[0] = spectral_proton(pIn.P(), removal_energy);
+    spectral[1] = spectral_neutron(pIn.P(), removal_energy);
+
+    // Spin sums of the spinors used in CalcCurrents
+    pIn.E() = free_energy;
+    const auto sumIn = SpinMatrix::Slashed(pIn) + std::sqrt(std::max(pIn.M2(), 0.0))*SpinMatrix::Identity();
+    const auto sumOut = SpinMatrix::Slashed(pOut) + std::sqrt(std::max(pOut.M2(), 0.0))*SpinMatrix::Identity();
+    const double ward = omega/qVec.P();
+
+    for(size_t i = 0; i < results.size(); ++i) {
+        for(const auto &formFactor : ff[i]) {
+            auto ffVal = CouplingsFF(ffVals, formFactor.second);
+            const auto gamma = Vertex(qVec, ffVal);
+
+            // W^{mu nu} = Tr[(pOut + m) Gamma^mu (pIn + m) gamma^0 Gamma^{nu dagger} gamma^0]
+            std::array<SpinMatrix, 4> lhs, rhs;
+            for(size_t mu = 0; mu < 4; ++mu) {
+                lhs[mu] = sumOut*gamma[mu];
+                rhs[mu] = sumIn*SpinMatrix::Gamma_0()*gamma[mu].Dagger()*SpinMatrix::Gamma_0();
+            }
+            Tensor tensor{};
+            for(size_t mu = 0; mu < 4; ++mu) {
+                for(size_t nu = 0; nu < 4; ++nu) {
+                    tensor[4*mu+nu] = SpinMatrix::Trace(lhs[mu], rhs[nu])*spectral[i]/6.0;
+                }
+            }
+
+            // Correct the Ward identity, which replaces J^3 with omega/|q| J^0
+            if(b_ward) {
+                for(size_t mu = 0; mu < 4; ++mu) tensor[12+mu] = ward*tensor[mu];
+                for(size_t mu = 0; mu < 4; ++mu) tensor[4*mu+3] = ward*tensor[4*mu];
+            }
+            results[i][formFactor.first] = tensor;
+        }
+    }
+    return results;
+}
+
 void QESpectral::AllowedStates(Process_Info &info) const {
     // Check for charge conservation
     int charge = -ParticleInfo(info.m_ids[0]).IntCharge();
@@ -233,16 +332,75 @@ bool QESpectral::FillNucleus(Event &event, const std::vector<double> &xsecs) con
     return true;
 }
 
+double QESpectral::CorrelatedProbability(const PID &pid, double p, double removal_energy) const {
+    if(!m_src.enabled) return 0;
+    if(!m_src.mean_field_proton) return p > m_src.momentum_cut ? 1 : 0;
+
+    const bool proton = pid == PID::proton();
+    const double total = proton ? spectral_proton(p, removal_energy) : spectral_neutron(p, removal_energy);
+    if(total <= 0) return 0;
+    const double mean_field = proton ? (*m_src.mean_field_proton)(p, removal_energy)
+                                     : (*m_src.mean_field_neutron)(p, removal_energy);
+    return std::clamp(1 - mean_field/total, 0.0, 1.0);
+}
+
+void QESpectral::FillCorrelations(Event &event) const {
+    if(!m_src.enabled) return;
+
+    auto &nucleons = event.CurrentNucleus() -> Nucleons();
+    auto struck = std::find_if(nucleons.begin(), nucleons.end(), [](const Particle &part) {
+        return part.Status() == ParticleStatus::initial_state;
+    });
+    if(struck == nucleons.end()) return;
+
+    const auto pIn = struck -> Momentum();
+    const double removal_energy = Constant::mN - pIn.E();
+    if(Random::Instance().Uniform(0.0, 1.0) >= CorrelatedProbability(struck -> ID(), pIn.P(), removal_energy))
+        return;
+
+    // Select the pair type. For a pair ratio r = np/pp (= np/nn), a struck proton sits
+    // in an np pair with probability r/(r+2), since each pp pair contains two protons
+    const PID struck_id = struck -> ID();
+    const bool np_pair = Random::Instance().Uniform(0.0, 1.0) < m_src.pair_ratio/(m_src.pair_ratio + 2);
+    const PID partner_id = np_pair ? (struck_id == PID::proton() ? PID::neutron() : PID::proton()) : struck_id;
+
+    // The partner is the closest spectator of the selected species
+    const auto position = struck -> Position();
+    size_t partner = nucleons.size();
+    double min_dist2 = std::numeric_limits<double>::max();
+    for(size_t i = 0; i < nucleons.size(); ++i) {
+        if(nucleons[i].Status() != ParticleStatus::background || nucleons[i].ID() != partner_id) continue;
+        const double dist2 = (nucleons[i].Position() - position).Magnitude2();
+        if(dist2 < min_dist2) {
+            min_dist2 = dist2;
+            partner = i;
+        }
+    }
+    if(partner == nucleons.size()) {
+        spdlog::debug("QESpectral: No spectator available for the correlated pair");
+        return;
+    }
+
+    // The partner recoils back-to-back against the struck nucleon, up to the pair CM motion
+    ThreeVector momentum = -pIn.Vec3();
+    if(m_src.cm_width > 0) {
+        momentum += ThreeVector{Random::Instance().Normal(0.0, m_src.cm_width),
+                                Random::Instance().Normal(0.0, m_src.cm_width),
+                                Random::Instance().Normal(0.0, m_src.cm_width)};
+    }
+    auto &correlated = nucleons[partner];
+    correlated.Momentum() = FourVector(momentum, std::sqrt(momentum.P2() + correlated.Mass()*correlated.Mass()));
+    correlated.Status() = ParticleStatus::propagating;
+    spdlog::debug("QESpectral: Correlated partner {}", correlated);
+}
+
 std::unique_ptr<NuclearModel> QESpectral::Construct(const YAML::Node &config) {
     auto form_factor = LoadFormFactor(config);
     return std::make_unique<QESpectral>(config, form_factor);
 }
 
-NuclearModel::Current QESpectral::HadronicCurrent(const std::array<Spinor, 2> &ubar,
-                                                  const std::array<Spinor, 2> &u,
-                                                  const FourVector &qVec,
-                                                  const FormFactorArray &ffVal) const {
-    Current result;
+std::array<achilles::SpinMatrix, 4> QESpectral::Vertex(const FourVector &qVec,
+                                                      const FormFactorArray &ffVal) const {
     std::array<SpinMatrix, 4> gamma{};
     for(size_t mu = 0; mu < 4; ++mu) {
         gamma[mu] = ffVal[0]*SpinMatrix::GammaMu(mu) + ffVal[2]*SpinMatrix::GammaMu(mu)*SpinMatrix::Gamma_5();
@@ -252,6 +410,15 @@ NuclearModel::Current QESpectral::HadronicCurrent(const std::array<Spinor, 2> &u
             sign = -1;
         }
     }
+    return gamma;
+}
+
+NuclearModel::Current QESpectral::HadronicCurrent(const std::array<Spinor, 2> &ubar,
+                                                  const std::array<Spinor, 2> &u,
+                                                  const FourVector &qVec,
+                                                  const FormFactorArray &ffVal) const {
+    Current result;
+    const auto gamma = Vertex(qVec, ffVal);
 
     for(size_t i = 0; i < 2; ++i) {
         for(size_t j = 0; j < 2; ++j) {
@@ -265,3 +432,151 @@ NuclearModel::Current QESpectral::HadronicCurrent(const std::array<Spinor, 2> &u
 
     return result;
 }
+
+InelasticSpectral::InelasticSpectral(const YAML::Node &config)
+        : m_structure{config["NuclearModel"]["StructureFunctions"]},
+          m_hadronization{config["NuclearModel"]["Hadronization"]},
+          spectral_proton{config["NuclearModel"]["SpectralP"].as<std::string>()},
+          spectral_neutron{config["NuclearModel"]["SpectralN"].as<std::string>()} {}
+
+std::vector<NuclearModel::Currents> InelasticSpectral::CalcCurrents(const Event&,
+                                                                    const std::vector<FFInfoMap>&) const {
+    throw std::runtime_error("InelasticSpectral: Only the hadronic tensor is available");
+}
+
+double InelasticSpectral::Coupling2(int boson) {
+    using namespace achilles::Constant;
+    switch(boson) {
+        case 22:
+            return ee*ee;
+        case 24:
+        case -24:
+            return ee*ee/(8*sw*sw);
+        default:
+            throw std::runtime_error(fmt::format("InelasticSpectral: Invalid boson {}", boson));
+    }
+}
+
+NuclearModel::Tensor InelasticSpectral::StructureTensor(const FourVector &p, const FourVector &q,
+                                                       const StructureFunctions::Values &sf,
+                                                       double coupling2) {
+    static constexpr std::array<double, 4> metric{1, -1, -1, -1};
+    const double pq = p*q;
+    const double q2 = q.M2();
+    const FourVector phat = p - (pq/q2)*q;
+    std::array<double, 4> plow{}, qlow{};
+    for(size_t mu = 0; mu < 4; ++mu) {
+        plow[mu] = metric[mu]*p[mu];
+        qlow[mu] = metric[mu]*q[mu];
+    }
+
+    Tensor tensor{};
+    for(size_t mu = 0; mu < 4; ++mu) {
+        for(size_t nu = 0; nu < 4; ++nu) {
+            std::complex<double> value = sf.F1*q[mu]*q[nu]/q2 + sf.F2*phat[mu]*phat[nu]/pq;
+            if(mu == nu) value -= sf.F1*metric[mu];
+            // Antisymmetric part from the interference of the vector and axial currents
+            for(size_t alpha = 0; alpha < 4; ++alpha) {
+                for(size_t beta = 0; beta < 4; ++beta) {
+                    const double eps = LeviCivita(mu, nu, alpha, beta);
+                    if(eps == 0) continue;
+                    value += std::complex<double>(0, sf.F3/(2*pq))*eps*plow[alpha]*qlow[beta];
+                }
+            }
+            tensor[4*mu+nu] = 2*coupling2*value;
+        }
+    }
+    return tensor;
+}
+
+std::vector<NuclearModel::Tensors> InelasticSpectral::CalcTensors(const Event &event,
+                                                                 const std::vector<FFInfoMap> &ff) const {
+    auto pIn = event.Momentum().front();
+    auto qVec = event.Momentum()[1];
+    for(size_t i = 3; i < event.Momentum().size(); ++i) {
+        qVec -= event.Momentum()[i];
+    }
+    auto removal_energy = Constant::mN - pIn.E();
+    auto free_energy = sqrt(pIn.P2() + Constant::mN2);
+    qVec.E() = qVec.E() + pIn.E() - free_energy;
+    pIn.E() = free_energy;
+
+    // Only the inelastic region that can be hadronized for any charge is included
+    std::vector<Tensors> results(2);
+    const double wmin = Hadronization::Threshold();
+    if(event.Momentum()[2].M2() < wmin*wmin) return results;
+    const double Q2 = -qVec.M2();
+    const double x = Q2/(2*(pIn*qVec));
+    if(Q2 <= 0 || x <= 0 || x >= 1) return results;
+
+    std::vector<double> spectral(2);
+    spectral[0] = spectral_proton(pIn.P(), removal_energy);
+    spectral[1] = spectral_neutron(pIn.P(), removal_energy);
+    spdlog::debug("Inelastic: x = {}, Q2 = {}, W = {}", x, Q2, event.Momentum()[2].M());
+
+    const std::array<PID, 2> nucleons{PID::proton(), PID::neutron()};
+    for(size_t i = 0; i < results.size(); ++i) {
+        for(const auto &formFactor : ff[i]) {
+            const auto boson = formFactor.first;
+            const auto sf = m_structure(nucleons[i], boson, x, Q2);
+            auto tensor = StructureTensor(pIn, qVec, sf, Coupling2(boson));
+            for(auto &elm : tensor) elm *= spectral[i]/6.0;
+            results[i][boson] = tensor;
+        }
+    }
+    return results;
+}
+
+void InelasticSpectral::AllowedStates(Process_Info &info) const {
+    // Check for charge conservation
+    int charge = -ParticleInfo(info.m_ids[0]).IntCharge();
+    for(size_t i = 1; i < info.m_ids.size(); ++i) {
+        charge += ParticleInfo(info.m_ids[i]).IntCharge();
+    }
+    charge /= 3;
+    if(std::abs(charge) > 1)
+        throw std::runtime_error(fmt::format("InelasticSpectral: Requires |charge| < 2, but found |charge| {}",
+                                             std::abs(charge)));
+    if(charge == 0 && ParticleInfo(info.m_ids[0]).IsNeutrino())
+        throw std::runtime_error("InelasticSpectral: Neutral current neutrino scattering is not implemented");
+
+    // Both nucleons contribute, and the outgoing nucleon stands for the hadronic system until
+    // it is hadronized
+    info.m_states[{PID::proton()}] = {PID::proton()}; 
+    info.m_states[{PID::neutron()}] = {PID::neutron()}; 
+}
+
+bool InelasticSpectral::FillNucleus(Event &event, const std::vector<double> &xsecs) const {
+    for(size_t i = 0; i < event.CurrentNucleus() -> Nucleons().size(); ++i) {
+        auto current_nucleon = event.CurrentNucleus() -> Nucleons()[i];
+        if(current_nucleon.ID() == PID::proton()) {
+            event.MatrixElementWgt(i) = xsecs[0];
+        } else {
+            event.MatrixElementWgt(i) = xsecs[1];
+        }
+    }
+    return event.TotalCrossSection();
+}
+
+void InelasticSpectral::Hadronize(Event &event) const {
+    auto &nucleons = event.CurrentNucleus() -> Nucleons();
+    auto struck = std::find_if(nucleons.begin(), nucleons.end(), [](const Particle &part) {
+        return part.Status() == ParticleStatus::initial_state;
+    });
+    if(struck == nucleons.end() || nucleons.back().Status() != ParticleStatus::propagating) return;
+
+    // The charge transferred by the leptons is added to the struck nucleon
+    const auto &leptons = event.Leptons();
+    int charge = struck -> ID() == PID::proton() ? 1 : 0;
+    charge += (ParticleInfo(leptons[0].ID()).IntCharge() - ParticleInfo(leptons[1].ID()).IntCharge())/3;
+
+    const auto system = nucleons.back();
+    nucleons.pop_back();
+    const auto hadrons = m_hadronization(system.Momentum(), charge, system.Position());
+    nucleons.insert(nucleons.end(), hadrons.begin(), hadrons.end());
+    spdlog::debug("InelasticSpectral: Hadronized W = {} into {} hadrons", system.Momentum().M(), hadrons.size());
+}
+
+std::unique_ptr<NuclearModel> InelasticSpectral::Construct(const YAML::Node &config) {
+    return std::make_unique<InelasticSpectral>(config);
+}
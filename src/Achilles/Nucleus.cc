@@ -3,6 +3,7 @@
 #include <regex>
 #include <fstream>
 #include <iostream>
+#include <limits>
 
 #include <cmath>
 #include "spdlog/spdlog.h"
@@ -152,6 +153,37 @@ void Nucleus::GenerateConfig() {
     SetNucleons(particles);
 }
 
+void Nucleus::ResampleConfig(const Particles &original) {
+    GenerateConfig();
+    Particles particles = nucleons;
+    const std::size_t nnucleons = particles.size();
+    if(original.size() < nnucleons)
+        throw std::runtime_error("Nucleus: Event has fewer nucleons than the nucleus");
+
+    std::vector<bool> replaced(nnucleons, false);
+    for(std::size_t i = 0; i < nnucleons; ++i) {
+        if(original[i].Status() == ParticleStatus::background) continue;
+        std::size_t closest = nnucleons;
+        double distance = std::numeric_limits<double>::max();
+        for(std::size_t j = 0; j < nnucleons; ++j) {
+            if(replaced[j] || particles[j].ID() != original[i].ID()) continue;
+            const double dist = (particles[j].Position() - original[i].Position()).Magnitude2();
+            if(dist < distance) {
+                distance = dist;
+                closest = j;
+            }
+        }
+        if(closest == nnucleons)
+            throw std::runtime_error("Nucleus: No nucleon left to replace in the new configuration");
+        particles[closest] = original[i];
+        replaced[closest] = true;
+    }
+    particles.insert(particles.end(), original.begin() + static_cast<std::ptrdiff_t>(nnucleons),
+                     original.end());
+
+    SetNucleons(particles);
+}
+
 const std::array<double, 3> Nucleus::GenerateMomentum(const double &position) noexcept {
     std::array<double, 3> momentum{};
     momentum[0] = Random::Instance().Uniform(0.0,FermiMomentum(position));
@@ -0,0 +1,49 @@
+#include "Achilles/OutputFilter.hh"
+#include "Achilles/Particle.hh"
+
+#include <map>
+#include <stdexcept>
+
+#include "fmt/format.h"
+
+using achilles::OutputFilter;
+
+OutputFilter::OutputFilter(std::set<ParticleStatus> status, std::set<PID> pids,
+                           double min_momentum, double min_kinetic)
+    : m_enabled{true}, m_status{std::move(status)}, m_pids{std::move(pids)},
+      m_min_momentum{min_momentum}, m_min_kinetic{min_kinetic} {
+    if(m_min_momentum < 0 || m_min_kinetic < 0)
+        throw std::runtime_error("OutputFilter: Kinematic thresholds must be non-negative");
+}
+
+achilles::ParticleStatus OutputFilter::StatusFromName(const std::string &name) {
+    static const std::map<std::string, ParticleStatus> names{
+        {"initial_state", ParticleStatus::initial_state},
+        {"final_state", ParticleStatus::final_state},
+        {"propagating", ParticleStatus::propagating},
+        {"escaped", ParticleStatus::escaped},
+        {"captured", ParticleStatus::captured}};
+    auto it = names.find(name);
+    if(it == names.end())
+        throw std::runtime_error(fmt::format("OutputFilter: Invalid particle status {}", name));
+    return it -> second;
+}
+
+bool OutputFilter::Keep(const Particle &particle) const {
+    if(!m_enabled || particle.Status() == ParticleStatus::initial_state) return true;
+    if(!m_status.empty() && m_status.find(particle.Status()) == m_status.end()) return false;
+    if(!m_pids.empty() && m_pids.find(particle.ID()) == m_pids.end()) return false;
+    if(particle.Momentum().P() < m_min_momentum) return false;
+    if(particle.Momentum().E() - particle.Mass() < m_min_kinetic) return false;
+    return true;
+}
+
+std::vector<achilles::Particle> OutputFilter::operator()(const std::vector<Particle> &particles) const {
+    if(!m_enabled) return particles;
+
+    std::vector<Particle> result;
+    for(const auto &particle : particles) {
+        if(Keep(particle)) result.push_back(particle);
+    }
+    return result;
+}
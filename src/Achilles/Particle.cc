@@ -7,7 +7,8 @@
 using namespace achilles;
 
 void Particle::SetFormationZone(const FourVector& p1, const FourVector& p2) noexcept {
-    formationZone = p1.E()/std::abs(Constant::mN*Constant::mN-p1*p2);
+    formationZone = formationTime = p1.E()/std::abs(Constant::mN*Constant::mN-p1*p2);
+    formationScale = 0;
 }
 
 void Particle::Propagate(const double& time) noexcept {
@@ -0,0 +1,60 @@
+#include "Achilles/PhaseSpaceBias.hh"
+#include "Achilles/Constants.hh"
+#include "Achilles/Event.hh"
+#include "Achilles/FourVector.hh"
+#include "Achilles/Particle.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+using achilles::PhaseSpaceBias;
+
+PhaseSpaceBias::PhaseSpaceBias(std::vector<Term> terms) : m_terms{std::move(terms)} {
+    for(const auto &term : m_terms) {
+        if(term.scale <= 0)
+            throw std::runtime_error("PhaseSpaceBias: Scale must be positive");
+    }
+}
+
+double PhaseSpaceBias::Evaluate(Variable variable, const FourVector &lep_in, const FourVector &lep_out) {
+    const FourVector q = lep_in - lep_out;
+    switch(variable) {
+        case Variable::Q2:
+            return -q.M2();
+        case Variable::Omega:
+            return q.E();
+        case Variable::ThetaLepton:
+            return lep_in.Angle(lep_out);
+        case Variable::W:
+            return std::sqrt(std::max(Constant::mN2 + 2*Constant::mN*q.E() + q.M2(), 0.0));
+    }
+    return 0;
+}
+
+double PhaseSpaceBias::operator()(const FourVector &lep_in, const FourVector &lep_out) const {
+    double bias = 1;
+    for(const auto &term : m_terms) {
+        const double x = Evaluate(term.variable, lep_in, lep_out)/term.scale;
+        switch(term.form) {
+            case Form::Power:
+                bias *= std::pow(1 + std::abs(x), term.exponent);
+                break;
+            case Form::Exponential:
+                bias *= std::exp(term.exponent*x);
+                break;
+        }
+    }
+    return bias;
+}
+
+double PhaseSpaceBias::operator()(const Event &event) const {
+    const Particle *lep_in = nullptr, *lep_out = nullptr;
+    for(const auto &lepton : event.Leptons()) {
+        if(!lep_in && lepton.Status() == ParticleStatus::initial_state) lep_in = &lepton;
+        else if(!lep_out && lepton.Status() == ParticleStatus::final_state) lep_out = &lepton;
+    }
+    if(!lep_in || !lep_out)
+        throw std::runtime_error("PhaseSpaceBias: Event requires an incoming and outgoing lepton");
+    return (*this)(lep_in -> Momentum(), lep_out -> Momentum());
+}
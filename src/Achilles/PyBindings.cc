@@ -17,4 +17,8 @@ PYBIND11_MODULE(_achilles, m) {
     // Calculation Objects
     InteractionsModule(m);
     CascadeModule(m);
+
+    // Event generation
+    py::module generator = m.def_submodule("generator", "achilles event generation");
+    EventGenModule(generator);
 }
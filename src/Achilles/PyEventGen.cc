@@ -0,0 +1,7 @@
+#include "Achilles/PyBindings.hh"
+
+// Standalone module providing in-process event generation
+PYBIND11_MODULE(_achilles_eventgen, m) {
+    m.doc() = "In-process event generation with Achilles";
+    EventGenModule(m);
+}
@@ -0,0 +1,166 @@
+#include "Achilles/QuasiRandom.hh"
+#include "Achilles/Random.hh"
+
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+using achilles::QuasiRandom;
+
+namespace {
+
+// Primitive polynomials and initial direction numbers of the Sobol sequence for dimensions
+// 2 to 32, from S. Joe and F. Y. Kuo, SIAM J. Sci. Comput. 30, 2635 (2008). The polynomial
+// of degree s is encoded by the coefficients a of the inner terms
+struct SobolPolynomial {
+    uint32_t degree, coefficients;
+    std::array<uint32_t, 7> m;
+};
+
+constexpr std::array<SobolPolynomial, 31> sobol_polynomials{{
+    {1, 0, {1}},
+    {2, 1, {1, 3}},
+    {3, 1, {1, 3, 1}},
+    {3, 2, {1, 1, 1}},
+    {4, 1, {1, 1, 3, 3}},
+    {4, 4, {1, 3, 5, 13}},
+    {5, 2, {1, 1, 5, 5, 17}},
+    {5, 4, {1, 1, 5, 5, 5}},
+    {5, 7, {1, 1, 7, 11, 19}},
+    {5, 11, {1, 1, 5, 1, 1}},
+    {5, 13, {1, 1, 1, 3, 11}},
+    {5, 14, {1, 3, 5, 5, 31}},
+    {6, 1, {1, 3, 3, 9, 7, 49}},
+    {6, 13, {1, 1, 1, 15, 21, 21}},
+    {6, 16, {1, 3, 1, 13, 27, 49}},
+    {6, 19, {1, 1, 1, 15, 7, 5}},
+    {6, 22, {1, 3, 1, 15, 13, 25}},
+    {6, 25, {1, 1, 5, 5, 19, 61}},
+    {7, 1, {1, 3, 7, 11, 23, 15, 103}},
+    {7, 4, {1, 3, 7, 13, 13, 15, 69}},
+    {7, 7, {1, 1, 3, 11, 27, 31, 73}},
+    {7, 8, {1, 1, 7, 7, 19, 25, 105}},
+    {7, 14, {1, 3, 1, 5, 21, 9, 7}},
+    {7, 19, {1, 1, 1, 15, 5, 49, 59}},
+    {7, 21, {1, 1, 1, 1, 1, 33, 65}},
+    {7, 28, {1, 3, 5, 15, 17, 19, 21}},
+    {7, 31, {1, 1, 7, 11, 13, 29, 3}},
+    {7, 32, {1, 3, 7, 5, 7, 11, 113}},
+    {7, 37, {1, 1, 5, 3, 15, 19, 61}},
+    {7, 41, {1, 3, 1, 1, 9, 27, 89}},
+    {7, 42, {1, 1, 1, 3, 3, 21, 25}},
+}};
+
+// Direction numbers with the most significant bit first
+std::array<uint32_t, QuasiRandom::bits> DirectionNumbers(size_t dim) {
+    static constexpr size_t nbits = QuasiRandom::bits;
+    std::array<uint32_t, nbits> v{};
+    if(dim == 0) {
+        for(size_t k = 0; k < nbits; ++k) v[k] = 1u << (nbits - 1 - k);
+        return v;
+    }
+
+    const auto &poly = sobol_polynomials[dim - 1];
+    const size_t s = poly.degree;
+    for(size_t k = 0; k < s; ++k) v[k] = poly.m[k] << (nbits - 1 - k);
+    for(size_t k = s; k < nbits; ++k) {
+        v[k] = v[k - s] ^ (v[k - s] >> s);
+        for(size_t l = 1; l < s; ++l)
+            if((poly.coefficients >> (s - 1 - l)) & 1u) v[k] ^= v[k - l];
+    }
+    return v;
+}
+
+uint32_t RandomBits() {
+    return achilles::Random::Instance().Uniform<uint32_t>(0, std::numeric_limits<uint32_t>::max());
+}
+
+// Multiply the direction number by a random lower triangular matrix with a unit diagonal
+// (Matousek's linear matrix scramble), with the matrix given by its rows
+uint32_t Scramble(const std::array<uint32_t, QuasiRandom::bits> &rows, uint32_t v) {
+    uint32_t result = 0;
+    for(size_t b = 0; b < QuasiRandom::bits; ++b) {
+        const bool bit = std::bitset<QuasiRandom::bits>(rows[b] & v).count() % 2;
+        if(bit) result |= 1u << (QuasiRandom::bits - 1 - b);
+    }
+    return result;
+}
+
+}
+
+QuasiRandom::QuasiRandom(Type type, size_t replicas) : m_type{type}, m_replicas{replicas} {
+    if(m_type == Type::Pseudo) m_replicas = 1;
+    else if(m_replicas < 2)
+        throw std::runtime_error("QuasiRandom: At least two replicas are needed to estimate the error");
+}
+
+void QuasiRandom::Start(size_t dims, size_t ncalls) {
+    m_dims = dims;
+    m_npoints = std::max<size_t>((ncalls + m_replicas - 1)/m_replicas, 1);
+    if(m_npoints > std::numeric_limits<uint32_t>::max())
+        throw std::runtime_error("QuasiRandom: Too many points for a replica");
+    m_index = 0;
+    m_means.clear();
+}
+
+void QuasiRandom::Randomize() {
+    const size_t ndirections = std::min(m_dims, maxdims);
+    m_directions.resize(ndirections);
+    m_state.resize(ndirections);
+    for(size_t i = 0; i < ndirections; ++i) {
+        std::array<uint32_t, bits> rows{};
+        for(size_t b = 0; b < bits; ++b) {
+            // Keep the bits left of the diagonal, and set the diagonal
+            const uint32_t diagonal = 1u << (bits - 1 - b);
+            rows[b] = (RandomBits() & ~(diagonal - 1) & ~diagonal) | diagonal;
+        }
+        m_directions[i] = DirectionNumbers(i);
+        for(auto &v : m_directions[i]) v = Scramble(rows, v);
+        // The digital shift is the first point of the replica
+        m_state[i] = RandomBits();
+    }
+    m_means.push_back(0);
+}
+
+void QuasiRandom::Generate(std::vector<double> &point) {
+    if(m_type == Type::Pseudo) {
+        Random::Instance().Generate(point);
+        return;
+    }
+
+    const size_t n = m_index++ % m_npoints;
+    if(n == 0) {
+        Randomize();
+    } else {
+        // Gray code ordering, only a single direction number changes between points
+        const auto c = static_cast<size_t>(__builtin_ctzl(n));
+        for(size_t i = 0; i < m_state.size(); ++i) m_state[i] ^= m_directions[i][c];
+    }
+
+    static constexpr double norm = 1.0/4294967296.0;
+    for(size_t i = 0; i < m_state.size(); ++i)
+        point[i] = (static_cast<double>(m_state[i]) + 0.5)*norm;
+    for(size_t i = m_state.size(); i < m_dims; ++i)
+        point[i] = Random::Instance().Uniform(0.0, 1.0);
+}
+
+double QuasiRandom::Error() const {
+    const auto nreplicas = static_cast<double>(m_means.size());
+    if(nreplicas < 2) return std::numeric_limits<double>::infinity();
+    const double mean = std::accumulate(m_means.begin(), m_means.end(), 0.0)/nreplicas;
+    double variance = 0;
+    for(const auto &replica : m_means) variance += (replica - mean)*(replica - mean);
+    return std::sqrt(variance/(nreplicas*(nreplicas - 1)));
+}
+
+std::string QuasiRandom::Name(Type type) {
+    switch(type) {
+        case Type::Pseudo:
+            return "Pseudo";
+        case Type::Sobol:
+            return "Sobol";
+    }
+    return "Unknown";
+}
@@ -0,0 +1,99 @@
+#include "Achilles/RadiativeCorrections.hh"
+#include "Achilles/Constants.hh"
+#include "Achilles/Event.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/Random.hh"
+
+#include <algorithm>
+#include <cmath>
+
+using achilles::ISRFlux;
+using achilles::RadiativeCorrections;
+
+double ISRFlux::MaxFraction(double min_energy) const {
+    return std::max(1 - min_energy/m_energy, 0.0);
+}
+
+// The photon carries y = ymax*r^(1/beta) of the beam energy, which maps the
+// integrable singularity at y = 0 to a flat distribution in r
+achilles::FourVector ISRFlux::Flux(const std::vector<double> &ran, double min_energy) const {
+    const double ymax = MaxFraction(min_energy);
+    const double energy = m_energy*(1 - ymax*std::pow(ran[0], 1/m_beta));
+    return {energy, 0, 0, energy};
+}
+
+double ISRFlux::GenerateWeight(const FourVector &beam, std::vector<double> &ran, double min_energy) const {
+    const double ymax = MaxFraction(min_energy);
+    const double y = 1 - beam.E()/m_energy;
+    // Without room for radiation the event is removed in RadiativeCorrections::Radiate
+    if(ymax <= 0) {
+        ran[0] = 0;
+        return 1;
+    }
+    ran[0] = std::pow(std::max(y, 0.0)/ymax, m_beta);
+    return std::pow(ymax, m_beta)*RadiativeCorrections::Radiator(y);
+}
+
+double RadiativeCorrections::Beta(double Q2) {
+    if(Q2 <= Constant::me*Constant::me) return 0;
+    return Constant::ALPHA0/M_PI*(std::log(Q2/(Constant::me*Constant::me)) - 1);
+}
+
+double RadiativeCorrections::VirtualFactor(double Q2) {
+    if(Q2 <= Constant::me*Constant::me) return 1;
+    const double L = std::log(Q2/(Constant::me*Constant::me));
+    const double vertex = Constant::ALPHA0/M_PI*(1.5*L - 2);
+    const double vacuum = Constant::ALPHA0/M_PI*(2.0/3.0*L - 10.0/9.0);
+    return 1 + vertex + vacuum;
+}
+
+std::shared_ptr<achilles::FluxType> RadiativeCorrections::MakeISRFlux(double energy) {
+    // The reference beta is evaluated at the largest scale available, Q^2 = E^2
+    m_flux = std::make_shared<ISRFlux>(energy, Beta(energy*energy));
+    return m_flux;
+}
+
+void RadiativeCorrections::Radiate(Event &event) const {
+    auto &leptons = event.Leptons();
+    if(leptons.size() < 2)
+        throw std::runtime_error("RadiativeCorrections: Requires an incoming and outgoing lepton");
+
+    // All corrections are evaluated at the momentum transfer of the hard interaction
+    const FourVector q = leptons[0].Momentum() - leptons[1].Momentum();
+    const double Q2 = -q.M2();
+    const double beta = Beta(Q2);
+    if(m_virtual) event.Weight() *= VirtualFactor(Q2);
+
+    vParticles photons;
+    if(m_isr && m_flux) {
+        // Correct the beta used for the generation to that of the event
+        const double energy = m_flux -> Energy();
+        const double y = 1 - leptons[0].Momentum().E()/energy;
+        if(y <= 0) {
+            event.Weight() = 0;
+            return;
+        }
+        event.Weight() *= beta/m_flux -> Beta()*std::pow(y, beta - m_flux -> Beta());
+        const FourVector beam{energy, 0, 0, energy};
+        photons.emplace_back(PID::photon(), beam - leptons[0].Momentum(),
+                             ThreeVector(), ParticleStatus::final_state);
+        leptons[0].Momentum() = beam;
+    }
+
+    if(m_fsr && beta > 0) {
+        // The outgoing lepton stays on shell, and the photon takes the remaining momentum
+        const FourVector mom = leptons[1].Momentum();
+        const double mass = leptons[1].Mass();
+        const double ymax = 1 - mass/mom.E();
+        const double y = ymax*std::pow(Random::Instance().Uniform(0.0, 1.0), 1/beta);
+        event.Weight() *= std::pow(ymax, beta)*Radiator(y);
+
+        const double energy = (1 - y)*mom.E();
+        const double pmag = std::sqrt(std::max(energy*energy - mass*mass, 0.0));
+        leptons[1].Momentum() = FourVector(mom.Vec3().Unit()*pmag, energy);
+        photons.emplace_back(PID::photon(), mom - leptons[1].Momentum(),
+                             ThreeVector(), ParticleStatus::final_state);
+    }
+
+    leptons.insert(leptons.end(), photons.begin(), photons.end());
+}
@@ -19,6 +19,7 @@ enum class CascadeMode {
     Transparency,
     CrossSectionMFP,
     TransparencyMFP,
+    Benchmark,
 };
 
 }
@@ -34,6 +35,7 @@ struct convert<achilles::CascadeMode> {
         else if(name == "Transparency") mode = achilles::CascadeMode::Transparency;
         else if(name == "CrossSectionMFP") mode = achilles::CascadeMode::CrossSectionMFP;
         else if(name == "TransparencyMFP") mode = achilles::CascadeMode::TransparencyMFP;
+        else if(name == "Benchmark") mode = achilles::CascadeMode::Benchmark;
         else return false;
 
         return true;
@@ -234,9 +236,10 @@ class CalcTransparency : public RunMode {
                             kick_mom*sintheta*sin(phi),
                             kick_mom*costheta,
                             sqrt(kick_mom*kick_mom + mass*mass)};
-            kicked_particle->SetFormationZone(kicked_particle->Momentum(), kick);
+            const FourVector initial = kicked_particle->Momentum();
             kicked_particle->Status() = ParticleStatus::internal_test;
             kicked_particle->SetMomentum(kick);
+            m_cascade.FormHadron(*kicked_particle, initial);
             m_nuc -> SetNucleons(particles);
 
             spdlog::debug("Initial Nucleons:");
@@ -301,9 +304,10 @@ class CalcTransparencyMFP : public RunMode {
                             kick_mom*sintheta*sin(phi),
                             kick_mom*costheta,
                             sqrt(kick_mom*kick_mom + mass*mass)};
-            kicked_particle->SetFormationZone(kicked_particle->Momentum(), kick);
+            const FourVector initial = kicked_particle->Momentum();
             kicked_particle->Status() = ParticleStatus::internal_test;
             kicked_particle->SetMomentum(kick);
+            m_cascade.FormHadron(*kicked_particle, initial);
             m_nuc -> SetNucleons(particles);
 
             spdlog::debug("Initial Nucleons:");
@@ -352,6 +356,97 @@ class CalcTransparencyMFP : public RunMode {
         double ncaptured{};
 };
 
+// Compare the cascade for several step sizes and collision criteria. All variants evolve the
+// same kicked nucleon in the same nuclear configuration, so that the differences are not
+// dominated by the statistical fluctuations of the configurations
+class CalcBenchmark : public RunMode {
+    public:
+        struct Variant {
+            std::string name;
+            Cascade cascade;
+        };
+
+        CalcBenchmark(std::shared_ptr<Nucleus> nuc, std::vector<Variant> variants)
+            : RunMode(nuc, Cascade()), m_variants{std::move(variants)},
+              m_results(m_variants.size()) {}
+
+        void GenerateEvent(double kick_mom) override {
+            double costheta = Random::Instance().Uniform(-1.0, 1.0);
+            double sintheta = sqrt(1-costheta*costheta);
+            double phi = Random::Instance().Uniform(0.0, 2*M_PI);
+            auto particles = m_nuc->Nucleons();
+            size_t idx = Random::Instance().Uniform(0ul, particles.size()-1);
+            auto kicked_particle = &particles[idx];
+            auto mass = kicked_particle -> Info().Mass();
+            FourVector kick{kick_mom*sintheta*cos(phi),
+                            kick_mom*sintheta*sin(phi),
+                            kick_mom*costheta,
+                            sqrt(kick_mom*kick_mom + mass*mass)};
+            const FourVector initial = kicked_particle->Momentum();
+            kicked_particle->Status() = ParticleStatus::propagating;
+            kicked_particle->SetMomentum(kick);
+
+            for(size_t i = 0; i < m_variants.size(); ++i) {
+                auto &result = m_results[i];
+                // Each variant forms the kicked nucleon with its own formation zone model
+                auto variant_particles = particles;
+                m_variants[i].cascade.FormHadron(variant_particles[idx], initial);
+                m_nuc -> SetNucleons(variant_particles);
+                m_variants[i].cascade.SetKicked(idx);
+                result.nevents++;
+                const auto start = std::chrono::steady_clock::now();
+                try {
+                    m_variants[i].cascade.Evolve(m_nuc);
+                } catch(const CascadeAbort &e) {
+                    result.naborted++;
+                    continue;
+                }
+                const std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+                result.time += elapsed.count();
+
+                if(m_variants[i].cascade.NHits() == 0) result.ntransparent++;
+                for(const auto &part : m_nuc -> Nucleons()) {
+                    if(part.Status() != ParticleStatus::final_state || part.ID() != PID::proton()) continue;
+                    const double energy = part.Momentum().E() - part.Mass();
+                    result.nprotons++;
+                    result.proton_energy += energy;
+                    result.spectrum.Fill(energy);
+                }
+            }
+        }
+        void PrintResults(std::ofstream &out) const override {
+            out << "\n";
+            for(size_t i = 0; i < m_variants.size(); ++i) {
+                const auto &result = m_results[i];
+                const double nevents = result.nevents - result.naborted;
+                const double transparency = result.ntransparent/nevents;
+                const double error = sqrt(transparency*(1-transparency)/nevents);
+                fmt::print("  {}: transparency = {} +/- {}, protons / event = {}, <T_p> = {} MeV, "
+                           "time / event = {} us, aborted = {}\n",
+                           m_variants[i].name, transparency, error, result.nprotons/nevents,
+                           result.proton_energy/result.nprotons, result.time/nevents, result.naborted);
+                out << fmt::format("{},{},{},{},{},{},{}\n", m_variants[i].name, transparency, error,
+                                   result.nprotons/nevents, result.proton_energy/result.nprotons,
+                                   result.time/nevents, result.naborted);
+                result.spectrum.Save(&out);
+            }
+        }
+        void Reset() override {
+            for(size_t i = 0; i < m_results.size(); ++i) m_results[i] = Result(m_variants[i].name);
+        }
+
+    private:
+        struct Result {
+            Result(const std::string &name="")
+                : spectrum(50, 0.0, 1000.0, fmt::format("proton_energy_{}", name)) {}
+            double nevents{}, naborted{}, ntransparent{}, nprotons{}, proton_energy{}, time{};
+            Histogram spectrum;
+        };
+
+        std::vector<Variant> m_variants;
+        std::vector<Result> m_results;
+};
+
 }
 
 void achilles::RunCascade(const std::string &runcard) {
@@ -376,7 +471,8 @@ void achilles::RunCascade(const std::string &runcard) {
     // Initialize Cascade parameters
     spdlog::debug("Cascade mode: {}", config["Cascade"]["Mode"].as<std::string>());
     auto mode = config["Cascade"]["Mode"].as<CascadeMode>();
-    auto cascade = config["Cascade"].as<Cascade>();
+    Cascade cascade;
+    if(mode != CascadeMode::Benchmark) cascade = config["Cascade"].as<Cascade>();
     std::unique_ptr<RunMode> generator = nullptr; 
     switch(mode) {
         case CascadeMode::CrossSection:
@@ -397,6 +493,23 @@ void achilles::RunCascade(const std::string &runcard) {
         case CascadeMode::TransparencyMFP:
             generator = std::make_unique<CalcTransparencyMFP>(nucleus, std::move(cascade)); 
             break;
+        case CascadeMode::Benchmark: {
+            // Every combination of the step sizes and criteria is run with the remaining settings
+            const auto benchmark = config["Cascade"]["Benchmark"];
+            const auto steps = benchmark["Steps"].as<std::vector<double>>();
+            const auto criteria = benchmark["Criteria"].as<std::vector<std::string>>();
+            std::vector<CalcBenchmark::Variant> variants;
+            for(const auto &criterion : criteria) {
+                for(const auto &step : steps) {
+                    auto node = YAML::Clone(config["Cascade"]);
+                    node["Step"] = step;
+                    node["Criterion"] = criterion;
+                    variants.push_back({fmt::format("{}_{}", criterion, step), node.as<Cascade>()});
+                }
+            }
+            generator = std::make_unique<CalcBenchmark>(nucleus, std::move(variants));
+            break;
+        }
     }
 
     // Open results file
@@ -49,8 +49,11 @@ void RunPropagation(std::shared_ptr<achilles::Potential> potential,
 
     double current_mom = kick_mom[0];
     constexpr double omega = 20;
-    constexpr size_t time_steps = 10000;
-    constexpr double step_size = 0.01;
+    // Higher order schemes allow for fewer and larger steps at the same accuracy
+    auto scheme = achilles::SymplecticIntegrator::Scheme::Order2;
+    if(config["Integrator"]) scheme = config["Integrator"].as<achilles::SymplecticIntegrator::Scheme>();
+    const size_t time_steps = config["TimeSteps"] ? config["TimeSteps"].as<size_t>() : 10000;
+    const double step_size = config["StepSize"] ? config["StepSize"].as<double>() : 0.01;
     double r0 = config["r0"].as<double>();
 
     auto mom = potential -> BindingMomentum(r0);
@@ -71,9 +74,9 @@ void RunPropagation(std::shared_ptr<achilles::Potential> potential,
             double phi = achilles::Random::Instance().Uniform(0.0, 2*M_PI);
             achilles::ThreeVector q{r0, 0, 0};
             achilles::ThreeVector p{current_mom*sintheta*cos(phi), current_mom*sintheta*sin(phi), current_mom*costheta};
-            achilles::SymplecticIntegrator si(q, p, potential, dHamiltonian_dr, dHamiltonian_dp, omega); 
+            achilles::SymplecticIntegrator si(q, p, potential, dHamiltonian_dr, dHamiltonian_dp, omega, scheme); 
             for(size_t j = 0; j < time_steps; ++j) {
-                si.Step<2>(step_size);
+                si.Step(step_size);
                 if(si.Q().Magnitude() > 6.0) {
                     escaped++;
                     average_steps += j;
@@ -0,0 +1,110 @@
+#include "Achilles/StructureFunctions.hh"
+#include "Achilles/Constants.hh"
+#include "Achilles/Units.hh"
+
+#include <cmath>
+#include <stdexcept>
+
+#include "fmt/format.h"
+#include "yaml-cpp/yaml.h"
+
+using achilles::StructureFunctions;
+
+namespace {
+
+StructureFunctions::Parameters ParseParameters(const YAML::Node &node) {
+    StructureFunctions::Parameters params;
+    if(!node) return params;
+    if(node["ValenceAlpha"]) params.alpha_valence = node["ValenceAlpha"].as<double>();
+    if(node["UValenceBeta"]) params.beta_u = node["UValenceBeta"].as<double>();
+    if(node["DValenceBeta"]) params.beta_d = node["DValenceBeta"].as<double>();
+    if(node["SeaMomentum"]) params.sea_momentum = node["SeaMomentum"].as<double>();
+    if(node["SeaBeta"]) params.beta_sea = node["SeaBeta"].as<double>();
+    if(node["A"]) params.A = node["A"].as<double>();
+    if(node["B"]) params.B = node["B"].as<double>();
+    if(node["CSea"]) params.C_sea = node["CSea"].as<double>();
+    if(node["CValence1"]) params.C_valence1 = node["CValence1"].as<double>();
+    if(node["CValence2"]) params.C_valence2 = node["CValence2"].as<double>();
+    if(node["R"]) params.R = node["R"].as<double>();
+    return params;
+}
+
+}
+
+StructureFunctions::StructureFunctions(const Parameters &params) : m_params{params} {
+    if(m_params.alpha_valence <= 0 || m_params.beta_u <= -1 || m_params.beta_d <= -1
+       || m_params.beta_sea <= -1 || m_params.sea_momentum < 0)
+        throw std::runtime_error("StructureFunctions: Invalid parton distribution parameters");
+
+    // Normalize to two up and one down valence quarks, and to the sea momentum fraction
+    m_norm_u = 2/std::beta(m_params.alpha_valence, m_params.beta_u + 1);
+    m_norm_d = 1/std::beta(m_params.alpha_valence, m_params.beta_d + 1);
+    m_norm_sea = m_params.sea_momentum*(m_params.beta_sea + 1);
+}
+
+StructureFunctions::StructureFunctions(const YAML::Node &node)
+    : StructureFunctions(ParseParameters(node)) {}
+
+double StructureFunctions::UValence(double x) const {
+    if(x <= 0 || x >= 1) return 0;
+    return m_norm_u*std::pow(x, m_params.alpha_valence - 1)*std::pow(1 - x, m_params.beta_u);
+}
+
+double StructureFunctions::DValence(double x) const {
+    if(x <= 0 || x >= 1) return 0;
+    return m_norm_d*std::pow(x, m_params.alpha_valence - 1)*std::pow(1 - x, m_params.beta_d);
+}
+
+double StructureFunctions::Sea(double x) const {
+    if(x <= 0 || x >= 1) return 0;
+    return m_norm_sea*std::pow(1 - x, m_params.beta_sea)/x;
+}
+
+double StructureFunctions::Xi(double x, double Q2) const {
+    static constexpr double mass = Constant::mN/1.0_GeV;
+    const double denom = Q2*(1 + std::sqrt(1 + 4*mass*mass*x*x/Q2)) + 2*m_params.A*x;
+    return 2*x*(Q2 + m_params.B)/denom;
+}
+
+StructureFunctions::Values StructureFunctions::operator()(PID nucleon, int boson,
+                                                          double x, double Q2) const {
+    Values result;
+    if(x <= 0 || x >= 1 || Q2 <= 0) return result;
+
+    const double Q2GeV = Q2/1.0_GeV/1.0_GeV;
+    const double xi = Xi(x, Q2GeV);
+    const double dipole = 1/std::pow(1 + Q2GeV/0.71, 2);
+    const double k_valence = (1 - dipole*dipole)*(Q2GeV + m_params.C_valence2)
+                             /(Q2GeV + m_params.C_valence1);
+    const double k_sea = Q2GeV/(Q2GeV + m_params.C_sea);
+
+    // Isospin symmetry relates the neutron to the proton
+    double up = UValence(xi), down = DValence(xi);
+    if(nucleon == PID::neutron()) std::swap(up, down);
+    else if(nucleon != PID::proton())
+        throw std::runtime_error(fmt::format("StructureFunctions: Invalid nucleon {}", nucleon.AsInt()));
+    // Each of the u, d, s quarks and antiquarks of the sea carries S/6
+    const double sea = Sea(xi);
+
+    double xF3 = 0;
+    switch(boson) {
+        case 22:
+            result.F2 = xi*(k_valence*(4*up + down)/9 + k_sea*2*sea/9);
+            break;
+        case -24: // d, s, ubar -> u, c, dbar
+            result.F2 = 2*xi*(k_valence*down + k_sea*sea/2);
+            xF3 = 2*xi*(k_valence*down + k_sea*sea/6);
+            break;
+        case 24: // u, dbar, sbar -> d, ubar, cbar
+            result.F2 = 2*xi*(k_valence*up + k_sea*sea/2);
+            xF3 = 2*xi*(k_valence*up - k_sea*sea/6);
+            break;
+        default:
+            throw std::runtime_error(fmt::format("StructureFunctions: Invalid boson {}", boson));
+    }
+
+    static constexpr double mass = Constant::mN/1.0_GeV;
+    result.F1 = result.F2*(1 + 4*mass*mass*x*x/Q2GeV)/(2*x*(1 + m_params.R));
+    result.F3 = xF3/x;
+    return result;
+}
@@ -1,7 +1,51 @@
 #include "Achilles/SymplecticIntegrator.hh"
 
+#include <cmath>
+
 using SI = achilles::SymplecticIntegrator;
 
+size_t SI::Order(Scheme scheme) {
+    switch(scheme) {
+        case Scheme::Order2:
+            return 2;
+        case Scheme::ForestRuth:
+        case Scheme::Suzuki:
+            return 4;
+        case Scheme::Yoshida6:
+            return 6;
+    }
+    return 2;
+}
+
+const std::vector<double>& SI::Stages(Scheme scheme) {
+    static const double gamma = 1/(2 - std::cbrt(2.0));
+    static const double suzuki = 1/(4 - std::cbrt(4.0));
+    // Yoshida, Phys. Lett. A 150, 262 (1990), table 1
+    static constexpr double w1 = -1.17767998417887, w2 = 0.235573213359357, w3 = 0.784513610477560;
+    static constexpr double w0 = 1 - 2*(w1 + w2 + w3);
+
+    static const std::vector<double> order2{1};
+    static const std::vector<double> forest_ruth{gamma, 1 - 2*gamma, gamma};
+    static const std::vector<double> suzuki_stages{suzuki, suzuki, 1 - 4*suzuki, suzuki, suzuki};
+    static const std::vector<double> yoshida6{w3, w2, w1, w0, w1, w2, w3};
+
+    switch(scheme) {
+        case Scheme::ForestRuth:
+            return forest_ruth;
+        case Scheme::Suzuki:
+            return suzuki_stages;
+        case Scheme::Yoshida6:
+            return yoshida6;
+        case Scheme::Order2:
+            break;
+    }
+    return order2;
+}
+
+void SI::Step(double time_step) {
+    for(const auto &weight : Stages(m_scheme)) Step<2>(weight*time_step);
+}
+
 void SI::Initialize(const ThreeVector &q, const ThreeVector &p) {
     m_state = PSState(q, p);
 }
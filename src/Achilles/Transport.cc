@@ -0,0 +1,221 @@
+#include "Achilles/Transport.hh"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+using achilles::DensityLattice;
+using achilles::ThreeVector;
+
+namespace achilles {
+
+/// Threads that wait for tasks until the pool is destroyed. A task is run once on every thread,
+/// with the calling thread as thread 0, and Run returns when all threads are done with it
+class WorkerPool {
+    public:
+        WorkerPool(size_t nthreads) {
+            m_workers.reserve(nthreads - 1);
+            for(size_t t = 1; t < nthreads; ++t) m_workers.emplace_back(&WorkerPool::Work, this, t);
+        }
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+        ~WorkerPool() {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_start.notify_all();
+            for(auto &worker : m_workers) worker.join();
+        }
+
+        void Run(const std::function<void(size_t)> &task) {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_task = &task;
+                m_pending = m_workers.size();
+                ++m_generation;
+            }
+            m_start.notify_all();
+            task(0);
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait(lock, [this] { return m_pending == 0; });
+            m_task = nullptr;
+        }
+
+    private:
+        void Work(size_t thread) {
+            size_t generation = 0;
+            std::unique_lock<std::mutex> lock(m_mutex);
+            while(true) {
+                m_start.wait(lock, [&] { return m_stop || m_generation != generation; });
+                if(m_stop) return;
+                generation = m_generation;
+                const auto *task = m_task;
+                lock.unlock();
+                (*task)(thread);
+                lock.lock();
+                if(--m_pending == 0) m_done.notify_one();
+            }
+        }
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_mutex;
+        std::condition_variable m_start, m_done;
+        const std::function<void(size_t)> *m_task{};
+        size_t m_generation{}, m_pending{};
+        bool m_stop{false};
+};
+
+}
+
+DensityLattice::DensityLattice() = default;
+DensityLattice::DensityLattice(DensityLattice&&) noexcept = default;
+DensityLattice& DensityLattice::operator=(DensityLattice&&) noexcept = default;
+DensityLattice::~DensityLattice() = default;
+
+DensityLattice::DensityLattice(double spacing, double size, size_t threads)
+    : m_spacing{spacing}, m_size{size}, m_threads{threads} {
+    if(m_spacing <= 0 || m_size < 2*m_spacing)
+        throw std::runtime_error("DensityLattice: The lattice needs at least two cells in each direction");
+    if(m_threads == 0) throw std::runtime_error("DensityLattice: At least one thread is required");
+    m_npoints = static_cast<size_t>(std::floor(2*m_size/m_spacing)) + 1;
+    const size_t total = m_npoints*m_npoints*m_npoints;
+    m_density.assign(total, 0);
+    m_fx.assign(total, 0);
+    m_fy.assign(total, 0);
+    m_fz.assign(total, 0);
+    m_values.assign(total, 0);
+    if(m_threads > 1) {
+        m_pool = std::make_unique<WorkerPool>(m_threads);
+        m_partial.assign(m_threads, std::vector<double>(total));
+    }
+}
+
+// Split [0, n) into one contiguous chunk per thread of the pool. The function receives the
+// thread number and the range of its chunk, which is empty if there are more threads than items
+void DensityLattice::ParallelFor(size_t n, const std::function<void(size_t, size_t, size_t)> &func) const {
+    if(!m_pool) {
+        func(0, 0, n);
+        return;
+    }
+
+    const size_t chunk = (n + m_threads - 1)/m_threads;
+    m_pool -> Run([&](size_t thread) {
+        const size_t begin = std::min(thread*chunk, n), end = std::min(begin + chunk, n);
+        func(thread, begin, end);
+    });
+}
+
+// Lower lattice point of the cell containing the position, with the fractional distances to
+// it. The upper points of the cell must be on the lattice as well
+bool DensityLattice::Locate(double x, double y, double z, Cell &cell) const {
+    const double ux = (x + m_size)/m_spacing, uy = (y + m_size)/m_spacing, uz = (z + m_size)/m_spacing;
+    const double upper = static_cast<double>(m_npoints - 1);
+    if(!(ux >= 0 && uy >= 0 && uz >= 0 && ux < upper && uy < upper && uz < upper)) return false;
+    const auto i = static_cast<size_t>(ux), j = static_cast<size_t>(uy), k = static_cast<size_t>(uz);
+    cell = {Index(i, j, k), ux - static_cast<double>(i), uy - static_cast<double>(j), uz - static_cast<double>(k)};
+    return true;
+}
+
+double DensityLattice::Interpolate(const std::vector<double> &field, const Cell &cell) const {
+    const size_t di = m_npoints*m_npoints, dj = m_npoints;
+    const double gx = 1 - cell.fx, gy = 1 - cell.fy, gz = 1 - cell.fz;
+    const size_t idx = cell.index;
+    return gx*(gy*(gz*field[idx] + cell.fz*field[idx + 1])
+               + cell.fy*(gz*field[idx + dj] + cell.fz*field[idx + dj + 1]))
+         + cell.fx*(gy*(gz*field[idx + di] + cell.fz*field[idx + di + 1])
+                    + cell.fy*(gz*field[idx + di + dj] + cell.fz*field[idx + di + dj + 1]));
+}
+
+// With several threads, every thread deposits its share of the particles on its own lattice,
+// and the lattices are summed afterwards, split by lattice points. This avoids atomic updates
+// of shared points. A single thread deposits directly on the density
+void DensityLattice::Deposit(const std::vector<ThreeVector> &positions, double weight) {
+    const size_t nparticles = positions.size();
+    m_xs.resize(nparticles);
+    m_ys.resize(nparticles);
+    m_zs.resize(nparticles);
+    for(size_t i = 0; i < nparticles; ++i) {
+        m_xs[i] = positions[i][0];
+        m_ys[i] = positions[i][1];
+        m_zs[i] = positions[i][2];
+    }
+
+    const double norm = weight/(m_spacing*m_spacing*m_spacing);
+    const size_t di = m_npoints*m_npoints, dj = m_npoints;
+    const auto &xs = m_xs, &ys = m_ys, &zs = m_zs;
+    ParallelFor(nparticles, [&](size_t thread, size_t begin, size_t end) {
+        auto &grid = m_pool ? m_partial[thread] : m_density;
+        std::fill(grid.begin(), grid.end(), 0);
+        Cell cell{};
+        for(size_t i = begin; i < end; ++i) {
+            if(!Locate(xs[i], ys[i], zs[i], cell)) continue;
+            const double gx = 1 - cell.fx, gy = 1 - cell.fy, gz = 1 - cell.fz;
+            const size_t idx = cell.index;
+            grid[idx] += norm*gx*gy*gz;
+            grid[idx + 1] += norm*gx*gy*cell.fz;
+            grid[idx + dj] += norm*gx*cell.fy*gz;
+            grid[idx + dj + 1] += norm*gx*cell.fy*cell.fz;
+            grid[idx + di] += norm*cell.fx*gy*gz;
+            grid[idx + di + 1] += norm*cell.fx*gy*cell.fz;
+            grid[idx + di + dj] += norm*cell.fx*cell.fy*gz;
+            grid[idx + di + dj + 1] += norm*cell.fx*cell.fy*cell.fz;
+        }
+    });
+    if(!m_pool) return;
+
+    ParallelFor(m_density.size(), [&](size_t, size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) m_density[i] = 0;
+        for(const auto &grid : m_partial)
+            for(size_t i = begin; i < end; ++i) m_density[i] += grid[i];
+    });
+}
+
+double DensityLattice::Density(const ThreeVector &position) const {
+    Cell cell{};
+    if(!Locate(position[0], position[1], position[2], cell)) return 0;
+    return Interpolate(m_density, cell);
+}
+
+// The force vanishes on the boundary of the lattice, where the central differences are not defined
+void DensityLattice::ComputeForces(const std::function<double(double)> &potential) {
+    auto &values = m_values;
+    ParallelFor(m_density.size(), [&](size_t, size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) values[i] = potential(m_density[i]);
+    });
+
+    const double scale = -1/(2*m_spacing);
+    const size_t di = m_npoints*m_npoints, dj = m_npoints;
+    ParallelFor(m_npoints, [&](size_t, size_t begin, size_t end) {
+        for(size_t i = begin; i < end; ++i) {
+            for(size_t j = 0; j < m_npoints; ++j) {
+                const size_t row = Index(i, j, 0);
+                const bool interior = i > 0 && i + 1 < m_npoints && j > 0 && j + 1 < m_npoints;
+                for(size_t k = 0; k < m_npoints; ++k) {
+                    const size_t idx = row + k;
+                    if(!interior || k == 0 || k + 1 == m_npoints) {
+                        m_fx[idx] = m_fy[idx] = m_fz[idx] = 0;
+                        continue;
+                    }
+                    m_fx[idx] = scale*(values[idx + di] - values[idx - di]);
+                    m_fy[idx] = scale*(values[idx + dj] - values[idx - dj]);
+                    m_fz[idx] = scale*(values[idx + 1] - values[idx - 1]);
+                }
+            }
+        }
+    });
+}
+
+std::vector<ThreeVector> DensityLattice::Forces(const std::vector<ThreeVector> &positions) const {
+    std::vector<ThreeVector> forces(positions.size());
+    ParallelFor(positions.size(), [&](size_t, size_t begin, size_t end) {
+        Cell cell{};
+        for(size_t i = begin; i < end; ++i) {
+            if(!Locate(positions[i][0], positions[i][1], positions[i][2], cell)) continue;
+            forces[i] = ThreeVector(Interpolate(m_fx, cell), Interpolate(m_fy, cell), Interpolate(m_fz, cell));
+        }
+    });
+    return forces;
+}
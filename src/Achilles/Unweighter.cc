@@ -3,18 +3,28 @@
 #include "Achilles/Particle.hh"
 #include "Achilles/Random.hh"
 
+using achilles::NoUnweighter;
 using achilles::PercentileUnweighter;
 
+bool NoUnweighter::AcceptEvent(achilles::Event &event) {
+    m_total++;
+    Accept(event.Weight());
+    return true;
+}
+
 PercentileUnweighter::PercentileUnweighter(const YAML::Node &node)
     : m_percentile{node["percentile"].as<double>()/100} {}
 
+// The unweighting is done on the absolute value of the weight, and the sign is kept
+// for the accepted events. This results in events with weights of +/- max_wgt
 void PercentileUnweighter::AddEvent(const achilles::Event &event) {
-    m_percentile.Add(event.Weight());
+    m_percentile.Add(std::abs(event.Weight()));
 }
 
 bool PercentileUnweighter::AcceptEvent(achilles::Event &event) {
     double max_wgt = m_percentile.Get(); 
-    double prob = event.Weight() / max_wgt;
+    double abs_wgt = std::abs(event.Weight());
+    double prob = abs_wgt / max_wgt;
     m_total++;
 
     if(prob < achilles::Random::Instance().Uniform(0.0, 1.0)) {
@@ -22,8 +32,8 @@ bool PercentileUnweighter::AcceptEvent(achilles::Event &event) {
         return false;
     }
 
-    m_accepted++;
-    event.Weight() = event.Weight() > max_wgt ? event.Weight() : max_wgt;
+    Accept(event.Weight());
+    event.Weight() = std::copysign(abs_wgt > max_wgt ? abs_wgt : max_wgt, event.Weight());
     return true;
 }
 
@@ -18,21 +18,30 @@ void achilles::Vegas::operator()(const Func<double> &func) {
     std::vector<double> train_data(grid.Dims()*grid.Bins());
 
     StatsData results;
+    size_t ncalls = params.ncalls;
+    if(sampling.Enabled()) {
+        sampling.Start(grid.Dims(), params.ncalls);
+        ncalls = sampling.Calls();
+    }
 
-    for(size_t i = 0; i < params.ncalls; ++i) {
-        Random::Instance().Generate(rans);
+    for(size_t i = 0; i < ncalls; ++i) {
+        sampling.Generate(rans);
 
         double wgt = grid(rans);
         double val = func(rans, wgt);
         double val2 = val * val;
 
         results += val;
+        if(sampling.Enabled()) sampling.Add(val);
 
         for(size_t j = 0; j < grid.Dims(); ++j) {
             train_data[j * grid.Bins() + grid.FindBin(j, rans[j])] += val2; 
         }
     }
 
+    // The points of a quasi-random point set are not independent
+    if(sampling.Enabled()) results.SetError(sampling.Error());
+
     grid.Adapt(params.alpha, train_data);
     summary.results.push_back(results);
     summary.sum_results += results;
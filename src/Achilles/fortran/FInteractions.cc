@@ -1,4 +1,6 @@
 #include "Achilles/FInteractions.hh"
 #include "Achilles/Particle.hh"
 
+using namespace achilles;
+
 REGISTER_INTERACTION(FortranInteraction);
@@ -25,24 +25,24 @@ module libinteraction
     abstract interface
         function gen_cross_section(self, part1, part2)
             use iso_c_binding
-            use libparticle
+            use libinterop
             import :: interaction
             implicit none
             class(interaction), intent(in) :: self
-            type(particle), intent(in), value :: part1, part2
+            type(c_particle), intent(in) :: part1, part2
             real(c_double) :: gen_cross_section
         end function
 
         function gen_make_momentum(self, sameid, pcm, rans)
             use iso_c_binding
-            use libvectors
+            use libinterop
             import :: interaction
             implicit none
             class(interaction), intent(in) :: self
             logical, intent(in) :: sameid
             real(c_double), intent(in) :: pcm
             real(c_double), dimension(2), intent(in) :: rans
-            type(threevector) :: gen_make_momentum
+            type(c_threevector) :: gen_make_momentum
         end function
     end interface
 
@@ -81,9 +81,9 @@ contains
     end function create_interaction
 
     function constant_xsec(self, part1, part2)
-        use libparticle
+        use libinterop
         class(ConstantInteraction), intent(in) :: self
-        type(particle), intent(in), value :: part1, part2
+        type(c_particle), intent(in) :: part1, part2
         real(c_double) :: constant_xsec
 
         constant_xsec = 10
@@ -91,18 +91,19 @@ contains
 
     function constant_momentum(self, sameid, pcm, rans)
         use iso_c_binding
-        use libvectors
+        use libinterop
         class(ConstantInteraction), intent(in) :: self
         logical, intent(in) :: sameid
         real(c_double), intent(in) :: pcm
         real(c_double), dimension(2), intent(in) :: rans
+        real(c_double), parameter :: pi = 4d0*atan(1d0)
         real(c_double) :: ctheta, stheta, phi
-        type(threevector) :: constant_momentum
+        type(c_threevector) :: constant_momentum
 
         ctheta = 2*rans(1)-1
         stheta = dsqrt(1-ctheta*ctheta)
         phi = 2*pi*rans(2)
-        constant_momentum = threevector(pcm*stheta*dcos(phi), pcm*stheta*dsin(phi), pcm*ctheta)
+        constant_momentum = c_threevector(pcm*stheta*dcos(phi), pcm*stheta*dsin(phi), pcm*ctheta)
     end function
 
     subroutine init_interaction(name) bind(C, name="InitializeInteraction")
@@ -121,32 +122,24 @@ contains
 
     function cross_section(part1, part2) bind(C, name="CrossSectionFortran")
         use iso_c_binding
-        use libparticle
-        use liblogging
+        use libinterop
         implicit none
-        type(c_ptr), intent(in), value :: part1, part2
-        type(particle) :: fpart1, fpart2
+        type(c_particle), intent(in) :: part1, part2
         real(c_double) :: cross_section
 
-        fpart1 = particle(part1)
-        fpart2 = particle(part2)
-
-        cross_section = model%cross_section(fpart1, fpart2)
+        cross_section = model%cross_section(part1, part2)
     end function
 
-    function make_momentum(sameid, pcm, rans) bind(C, name="MakeMomentumFortran")
+    subroutine make_momentum(sameid, pcm, rans, mom) bind(C, name="MakeMomentumFortran")
         use iso_c_binding
-        use liblogging
-        use libvectors
+        use libinterop
         implicit none
-        logical, intent(in), value :: sameid
+        logical(c_bool), intent(in), value :: sameid
         real(c_double), intent(in), value :: pcm
         real(c_double), intent(in), dimension(2) :: rans
-        type(threevector) :: mom
-        type(c_ptr) :: make_momentum
+        type(c_threevector), intent(out) :: mom
 
-        mom = model%make_momentum(sameid, pcm, rans)
-        make_momentum = mom%copy()
-    end function
+        mom = model%make_momentum(logical(sameid), pcm, rans)
+    end subroutine
 
 end module
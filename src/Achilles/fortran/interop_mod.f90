@@ -0,0 +1,28 @@
+module libinterop
+    use iso_c_binding
+
+    implicit none
+
+    private
+    public :: c_threevector, c_fourvector, c_particle
+
+    ! Plain-data types shared with C++. The layouts must match the structs
+    ! defined in include/Achilles/FTypes.hh. Unlike the opaque pointer wrappers
+    ! in libvectors and libparticle, these live on the stack and are passed by
+    ! reference across the language boundary without any allocations.
+    type, bind(C) :: c_threevector
+        real(c_double) :: x, y, z
+    end type c_threevector
+
+    type, bind(C) :: c_fourvector
+        real(c_double) :: e, px, py, pz
+    end type c_fourvector
+
+    type, bind(C) :: c_particle
+        integer(c_long) :: pid
+        integer(c_long) :: status
+        type(c_fourvector) :: momentum
+        type(c_threevector) :: position
+    end type c_particle
+
+end module
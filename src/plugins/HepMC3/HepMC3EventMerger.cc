@@ -0,0 +1,145 @@
+#include "plugins/HepMC3/HepMC3EventMerger.hh"
+#include "gzstream/gzstream.h"
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wsign-conversion"
+#pragma GCC diagnostic ignored "-Wdouble-promotion"
+#pragma GCC diagnostic ignored "-Wconversion"
+#include "HepMC3/GenEvent.h"
+#include "HepMC3/GenCrossSection.h"
+#include "HepMC3/ReaderAscii.h"
+#pragma GCC diagnostic pop
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+using achilles::HepMC3Merger;
+using achilles::SampleSummary;
+using namespace HepMC3;
+
+namespace {
+
+std::shared_ptr<std::istream> OpenInput(const std::string &filename) {
+    std::shared_ptr<std::istream> input = nullptr;
+    if(filename.size() > 3 && filename.substr(filename.size() - 3) == ".gz")
+        input = std::make_shared<igzstream>(filename.c_str());
+    else
+        input = std::make_shared<std::ifstream>(filename);
+    if(!input -> good())
+        throw std::runtime_error(fmt::format("HepMC3Merger: Could not open {}", filename));
+    return input;
+}
+
+}
+
+// The realizations of an oversampled event share the event number of their primary event
+SampleSummary HepMC3Merger::Scan(const std::string &filename) const {
+    ReaderAscii reader(OpenInput(filename));
+    SampleSummary summary;
+    summary.filename = filename;
+
+    GenEvent evt;
+    bool started = false;
+    int primary = 0;
+    double primary_weight = 0;
+    while(reader.read_event(evt) && !reader.failed()) {
+        if(started && evt.event_number() != primary) {
+            ++summary.nevents;
+            summary.max_weight = std::max(summary.max_weight, std::abs(primary_weight));
+            primary_weight = 0;
+        }
+        started = true;
+        primary = evt.event_number();
+        primary_weight += evt.weight();
+        // The cross section is cumulative, so only the last event is needed
+        if(auto xsec = evt.cross_section()) {
+            summary.xsec = xsec -> xsec();
+            summary.error = xsec -> xsec_err();
+            summary.trials = static_cast<size_t>(xsec -> get_attempted_events());
+        }
+    }
+    reader.close();
+    if(started) {
+        ++summary.nevents;
+        summary.max_weight = std::max(summary.max_weight, std::abs(primary_weight));
+    }
+
+    if(summary.trials == 0) {
+        spdlog::warn("HepMC3Merger: No cross section found in {}, using the number of events",
+                     filename);
+        summary.trials = summary.nevents;
+    }
+    return summary;
+}
+
+void HepMC3Merger::Open(const std::string &filename) {
+    std::shared_ptr<std::ostream> output = nullptr;
+    if(m_zipped) {
+        std::string zipname = filename;
+        if(filename.size() < 3 || filename.substr(filename.size() - 3) != ".gz")
+            zipname += std::string(".gz");
+        output = std::make_shared<ogzstream>(zipname.c_str());
+    } else {
+        output = std::make_shared<std::ofstream>(filename);
+    }
+    m_nevents = 0;
+
+    // Reuse the run information of the first sample
+    ReaderAscii reader(OpenInput(Summaries().front().filename));
+    GenEvent evt;
+    reader.read_event(evt);
+    auto run = reader.run_info() ? reader.run_info() : std::make_shared<GenRunInfo>();
+    reader.close();
+
+    m_writer = std::make_unique<WriterAscii>(output, run);
+}
+
+void HepMC3Merger::Copy(const SampleSummary &summary) {
+    ReaderAscii reader(OpenInput(summary.filename));
+    const auto &combined = Combined();
+    auto cross_section = std::make_shared<GenCrossSection>();
+    cross_section -> set_cross_section(combined.xsec, combined.error,
+                                       static_cast<long>(combined.nevents),
+                                       static_cast<long>(combined.trials));
+
+    // The realizations of a primary event are unweighted together, and keep sharing a number
+    auto write = [&](std::vector<GenEvent> &primary) {
+        std::vector<double> wgts;
+        for(const auto &realization : primary) wgts.push_back(realization.weight());
+        wgts = NewWeights(wgts);
+        if(std::all_of(wgts.begin(), wgts.end(), [](double wgt) { return wgt == 0; })) return;
+
+        ++m_nevents;
+        for(size_t i = 0; i < primary.size(); ++i) {
+            if(wgts[i] == 0) continue;
+            auto &evt = primary[i];
+            evt.set_run_info(m_writer -> run_info());
+            evt.set_event_number(m_nevents);
+            evt.weight() = wgts[i];
+            evt.set_cross_section(cross_section);
+            m_writer -> write_event(evt);
+        }
+    };
+
+    GenEvent evt;
+    std::vector<GenEvent> primary;
+    while(reader.read_event(evt) && !reader.failed()) {
+        if(!primary.empty() && evt.event_number() != primary.front().event_number()) {
+            write(primary);
+            primary.clear();
+        }
+        primary.push_back(evt);
+    }
+    if(!primary.empty()) write(primary);
+    reader.close();
+}
+
+void HepMC3Merger::Close() {
+    m_writer -> close();
+    m_writer.reset();
+}
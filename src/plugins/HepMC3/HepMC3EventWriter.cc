@@ -49,8 +49,14 @@ void HepMC3Writer::Write(const achilles::Event &event) {
     constexpr double to_mm = 1e-12;
     constexpr double nb_to_pb = 1000;
 
-    // Update cumulative results, but skip writing if weight is zero
-    results += event.Weight()*nb_to_pb;
+    // Update cumulative results, but skip writing if weight is zero. The realizations of an
+    // oversampled event count as a single call with the sum of their weights
+    primaryWeight += event.Weight()*nb_to_pb;
+    const bool lastRealization = event.Realization() + 1 == event.NRealizations();
+    if(lastRealization) {
+        results += primaryWeight;
+        primaryWeight = 0;
+    }
     spdlog::trace("Event weight = {}", event.Weight());
     if(event.Weight() == 0) {
         return;
@@ -60,7 +66,7 @@ void HepMC3Writer::Write(const achilles::Event &event) {
     spdlog::trace("Setting up units");
     GenEvent evt(Units::MEV, Units::MM);
     evt.set_run_info(file.run_info());
-    evt.set_event_number(results.Calls());
+    evt.set_event_number(results.Calls() + (lastRealization ? 0 : 1));
 
     // Interaction type
     // TODO: Add interaction type to the event, and have ids for different modes
@@ -72,6 +78,14 @@ void HepMC3Writer::Write(const achilles::Event &event) {
     cross_section->set_cross_section(results.Mean(), results.Error(), results.FiniteCalls(), results.Calls());
     evt.add_attribute("GenCrossSection", cross_section);
     evt.add_attribute("Flux", std::make_shared<DoubleAttribute>(event.Flux()));
+    if(event.BiasWeight() != 1)
+        evt.add_attribute("BiasWeight", std::make_shared<DoubleAttribute>(event.BiasWeight()));
+    if(event.CascadeFlag() != 0)
+        evt.add_attribute("CascadeFlag", std::make_shared<IntAttribute>(event.CascadeFlag()));
+    if(event.NRealizations() > 1) {
+        evt.add_attribute("Realization", std::make_shared<IntAttribute>(static_cast<int>(event.Realization())));
+        evt.add_attribute("NRealizations", std::make_shared<IntAttribute>(static_cast<int>(event.NRealizations())));
+    }
     evt.weight("Default") = event.Weight()*nb_to_pb;
 
     // TODO: once we have a detector to simulate interaction location
@@ -80,9 +94,9 @@ void HepMC3Writer::Write(const achilles::Event &event) {
     // evt.shift_position_to(position);
 
     // Load in particle information
-    const std::vector<achilles::Particle> hadrons = event.Hadrons();
+    const std::vector<achilles::Particle> hadrons = Filter()(event.Hadrons());
     // spdlog::info("nhadrons = {}" , hadrons.size());
-    const std::vector<achilles::Particle> leptons = event.Leptons();
+    const std::vector<achilles::Particle> leptons = Filter()(event.Leptons());
     // TODO: Clean this up
     const auto nuc_mass = achilles::ParticleInfo(event.CurrentNucleus() -> ID()).Mass();
     const HepMC3::FourVector initMass{0, 0, 0, nuc_mass};
@@ -151,9 +165,10 @@ void HepMC3Writer::Write(const achilles::Event &event) {
     // Add in remnant Nucleus
     // TODO: Get recoil momentum for the nucleus
     // TODO: Move remnant to last cascade vertex???
-    if(event.Remnant().PID() != int(achilles::PID::dummyNucleus())) {
+    const auto remnant = event.Remnant();
+    if(remnant.PID() != int(achilles::PID::dummyNucleus())) {
         const HepMC3::FourVector recoil{recoilMom.Px(), recoilMom.Py(), recoilMom.Pz(), recoilMom.E()};
-        GenParticlePtr pRemnant = std::make_shared<GenParticle>(recoil, event.Remnant().PID(), 1);
+        GenParticlePtr pRemnant = std::make_shared<GenParticle>(recoil, remnant.PID(), 1);
         v2->add_particle_out(pRemnant);
     }
     evt.add_vertex(v2);
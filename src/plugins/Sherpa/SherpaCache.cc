@@ -0,0 +1,111 @@
+#include "plugins/Sherpa/SherpaCache.hh"
+#include "plugins/Sherpa/Channels.hh"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+#include "yaml-cpp/yaml.h"
+
+using achilles::SherpaCache;
+using PHASIC::ChannelNode;
+
+namespace {
+
+YAML::Node EncodeNode(const ChannelNode &node) {
+    YAML::Node result;
+    result["PID"] = node.m_pid;
+    result["Idx"] = node.m_idx;
+    if(node.m_left) result["Left"] = EncodeNode(*node.m_left);
+    if(node.m_right) result["Right"] = EncodeNode(*node.m_right);
+    return result;
+}
+
+std::shared_ptr<ChannelNode> DecodeNode(const YAML::Node &node) {
+    auto result = std::make_shared<ChannelNode>();
+    result -> m_pid = node["PID"].as<long int>();
+    result -> m_idx = node["Idx"].as<unsigned int>();
+    if(node["Left"]) result -> m_left = DecodeNode(node["Left"]);
+    if(node["Right"]) result -> m_right = DecodeNode(node["Right"]);
+    return result;
+}
+
+}
+
+SherpaCache::SherpaCache(std::string directory, std::vector<std::string> inputs)
+    : m_directory{std::move(directory)}, m_inputs{std::move(inputs)} {
+    m_inputs.insert(m_inputs.begin(), std::to_string(version));
+    m_key = Hash(m_inputs);
+}
+
+std::string SherpaCache::Filename() const {
+    return fmt::format("{}/achilles_process_{:016x}.yml", m_directory, m_key);
+}
+
+uint64_t SherpaCache::Hash(const std::vector<std::string> &inputs) {
+    static constexpr uint64_t offset = 14695981039346656037ull, prime = 1099511628211ull;
+    uint64_t hash = offset;
+    for(const auto &input : inputs) {
+        for(const auto c : input) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= prime;
+        }
+        // Separate the inputs, so that moving characters between them changes the hash
+        hash ^= 0xff;
+        hash *= prime;
+    }
+    return hash;
+}
+
+std::string SherpaCache::FileContents(const std::string &filename) {
+    std::ifstream file(filename);
+    if(!file.is_open())
+        throw std::runtime_error(fmt::format("SherpaCache: Could not open {}", filename));
+    std::stringstream contents;
+    contents << file.rdbuf();
+    return contents.str();
+}
+
+bool SherpaCache::Load() {
+    if(!std::filesystem::exists(Filename())) {
+        spdlog::info("SherpaCache: No cached process found in {}", m_directory);
+        return false;
+    }
+
+    try {
+        auto node = YAML::LoadFile(Filename());
+        // Guard against hash collisions
+        if(node["Inputs"].as<std::vector<std::string>>() != m_inputs) {
+            spdlog::warn("SherpaCache: Inputs of {} do not match, ignoring the cache", Filename());
+            return false;
+        }
+        momentum_map = node["MomentumMap"].as<std::map<size_t, long>>();
+        masses = node["Masses"].as<std::vector<double>>();
+        topologies.clear();
+        for(const auto &topology : node["Topologies"])
+            topologies.push_back(DecodeNode(topology));
+    } catch(const YAML::Exception &e) {
+        spdlog::warn("SherpaCache: Could not read {}: {}", Filename(), e.what());
+        return false;
+    }
+
+    spdlog::info("SherpaCache: Loaded process with {} channels from {}", topologies.size(), Filename());
+    return true;
+}
+
+void SherpaCache::Save() const {
+    YAML::Node node;
+    node["Inputs"] = m_inputs;
+    node["MomentumMap"] = momentum_map;
+    node["Masses"] = masses;
+    for(const auto &topology : topologies)
+        node["Topologies"].push_back(EncodeNode(*topology));
+
+    std::filesystem::create_directories(m_directory);
+    std::ofstream out(Filename());
+    out << node;
+    spdlog::info("SherpaCache: Saved process to {}", Filename());
+}
@@ -207,6 +207,26 @@ std::map<size_t, long> SherpaMEs::MomentumMap(const std::vector<long> &_fl) cons
 }
 
 std::vector<std::unique_ptr<PHASIC::Channels>> SherpaMEs::GenerateChannels(const std::vector<long> &_fl) const {
+    std::vector<double> s;
+    auto topologies = GenerateTopologies(_fl, s);
+    return BuildChannels(topologies, s);
+}
+
+std::vector<std::unique_ptr<PHASIC::Channels>> SherpaMEs::BuildChannels
+(const std::vector<std::shared_ptr<ChannelNode>> &topologies, const std::vector<double> &s) {
+    std::vector<std::unique_ptr<PHASIC::Channels>> channels;
+    for(const auto &cur : topologies) {
+      auto channel = std::make_unique<GenChannel>(s.size(), s);
+      channel -> InitializeChannel(cur);
+      spdlog::debug("{}", channel -> ToString());
+      channels.push_back(std::move(channel));
+    }
+
+    return channels;
+}
+
+std::vector<std::shared_ptr<ChannelNode>> SherpaMEs::GenerateTopologies(const std::vector<long> &_fl,
+                                                                        std::vector<double> &s) const {
     Cluster_Amplitude *ampl(Cluster_Amplitude::New());
     for (size_t i(0);i<_fl.size();++i) {
       Flavour fl(Flavour((long int)(_fl[i])));
@@ -227,7 +247,7 @@ std::vector<std::unique_ptr<PHASIC::Channels>> SherpaMEs::GenerateChannels(const
 
     // Setup external particle channel components
     std::map<int, std::vector<std::shared_ptr<ChannelNode>>> channelComponents;
-    std::vector<double> s;
+    s.clear();
     const auto flavs = singleProcess -> Flavours();
     for(size_t i = 0; i < flavs.size(); ++i) {
         auto node = std::make_shared<ChannelNode>();
@@ -285,15 +305,7 @@ std::vector<std::unique_ptr<PHASIC::Channels>> SherpaMEs::GenerateChannels(const
 
     size_t lid = (1 << _fl.size()) - 2, rid = 2;
     if(channelComponents.find(lid) == channelComponents.end()) throw;
-    std::vector<std::unique_ptr<PHASIC::Channels>> channels;
-    for(const auto &cur : channelComponents[lid]) {
-      auto channel = std::make_unique<GenChannel>(_fl.size(), s);
-      channel -> InitializeChannel(cur);
-      spdlog::debug("{}", channel -> ToString());
-      channels.push_back(std::move(channel));
-    }
-
-    return channels;
+    return channelComponents[lid];
 }
 
 achilles::SherpaMEs::LeptonCurrents SherpaMEs::Calc
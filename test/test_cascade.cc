@@ -1,11 +1,18 @@
 #include "catch2/catch.hpp"
 #include "mock_classes.hh"
+#include "catch_utils.hh"
 
 #include "Achilles/Cascade.hh"
 #include "Achilles/Nucleus.hh"
 #include "Achilles/Particle.hh"
 #include "Achilles/Interactions.hh"
 #include "Achilles/Event.hh"
+#include "Achilles/FormationZone.hh"
+#include "Achilles/Random.hh"
+#include "Achilles/Statistics.hh"
+
+#include <cmath>
+#include <limits>
 
 TEST_CASE("Initialize Cascade", "[Cascade]") {
     achilles::Particles particles = {{achilles::PID::proton()}, {achilles::PID::neutron()}};
@@ -387,4 +394,579 @@ TEST_CASE("Cascade YAML", "[Cascade]") {
     CHECK(cascade.InMediumSetting() == in_medium);
     CHECK(cascade.UsePotentialProp() == false);
     CHECK(cascade.StepSize() == 0.04);
+    CHECK_FALSE(cascade.Biasing().Enabled());
+    CHECK(cascade.Criterion() == "Lab");
+
+    node["Criterion"] = "Covariant";
+    CHECK(node.as<achilles::Cascade>().Criterion() == "Covariant");
+    node["Criterion"] = "Invariant";
+    CHECK_THROWS(node.as<achilles::Cascade>());
+    node.remove("Criterion");
+
+    CHECK(cascade.FormationZoneModel() == "Default");
+    node["FormationZone"]["Name"] = "QuantumDiffusion";
+    CHECK(node.as<achilles::Cascade>().FormationZoneModel() == "QuantumDiffusion");
+    node["FormationZone"]["Name"] = "Instant";
+    CHECK_THROWS(node.as<achilles::Cascade>());
+    node.remove("FormationZone");
+
+    CHECK(cascade.ClusterCoalescence() == nullptr);
+    node["Coalescence"]["Surface"] = 1;
+    CHECK(node.as<achilles::Cascade>().ClusterCoalescence() -> Params().surface == 1);
+    node["Coalescence"]["MaxSize"] = 5;
+    CHECK_THROWS(node.as<achilles::Cascade>());
+}
+
+TEST_CASE("Covariant closest approach", "[Cascade]") {
+    const double mass = achilles::Constant::mN;
+    const double pz = 500, energy = sqrt(pz*pz + mass*mass);
+    achilles::Particle projectile{achilles::PID::proton(), {energy, 0, 0, pz}, {0, 0, -5}};
+    achilles::Particle target{achilles::PID::neutron(), {mass, 0, 0, 0}, {1, 2, 0}};
+
+    SECTION("Matches the lab frame for a target at rest") {
+        const auto approach = achilles::CovariantClosestApproach(projectile, target);
+        CHECK(approach.b2 == Approx(5));
+        CHECK(approach.time == Approx(5*energy/pz));
+    }
+
+    SECTION("Impact parameter is Lorentz invariant") {
+        const auto approach = achilles::CovariantClosestApproach(projectile, target);
+
+        // Boost the configuration along the beam and transverse to it. The positions are moved
+        // back along the trajectories to a common time in the new frame
+        const achilles::ThreeVector beta = GENERATE(achilles::ThreeVector{0, 0, 0.5},
+                                                    achilles::ThreeVector{0.3, -0.4, 0.1});
+        auto boost = [&](const achilles::Particle &particle) {
+            const auto x = achilles::FourVector(particle.Position(), 0).Boost(beta);
+            const auto p = particle.Momentum().Boost(beta);
+            const auto position = x.Vec3() - p.Vec3()/p.E()*x.E();
+            return achilles::Particle{particle.ID(), p, position};
+        };
+        const auto boosted = achilles::CovariantClosestApproach(boost(projectile), boost(target));
+        CHECK(boosted.b2 == Approx(approach.b2));
+    }
+
+    SECTION("Parallel particles never reach the closest approach") {
+        target.SetMomentum(projectile.Momentum());
+        target.SetPosition({1, 2, -5});
+        const auto approach = achilles::CovariantClosestApproach(projectile, target);
+        CHECK(approach.b2 == Approx(5));
+        CHECK(std::isinf(approach.time));
+    }
+}
+
+TEST_CASE("Cascade Biasing YAML", "[Cascade]") {
+    YAML::Node node = YAML::Load(R"node(
+    Scale: 2
+    Channels:
+      - Particles: [2212, 2112]
+        Scale: 5
+    ForceFirst: 0.5
+    RouletteThreshold: 0.1
+    )node");
+
+    auto biasing = node.as<achilles::CascadeBiasing>();
+    CHECK(biasing.Enabled());
+    CHECK(biasing.scale == 2);
+    CHECK(biasing.Scale(achilles::PID::neutron(), achilles::PID::proton()) == 5);
+    CHECK(biasing.Scale(achilles::PID::neutron(), achilles::PID::neutron()) == 2);
+    CHECK(biasing.force_first == 0.5);
+    CHECK(biasing.roulette == 0.1);
+
+    node["ForceFirst"] = 1;
+    CHECK_THROWS(node.as<achilles::CascadeBiasing>());
+}
+
+TEST_CASE("Cascade biasing is unbiased", "[Cascade]") {
+    // A particle crossing a row of targets, stopping at the first interaction
+    static constexpr size_t ntargets = 5, ntrials = 200000;
+    static constexpr double prob = 0.05;
+    const achilles::PID proton = achilles::PID::proton(), neutron = achilles::PID::neutron();
+    const std::vector<achilles::PID> targets{proton, neutron, proton, neutron, proton};
+
+    achilles::CascadeBiasing biasing;
+    biasing.scale = 4;
+    biasing.channel_scales[{neutron, proton}] = 8;
+    biasing.force_first = GENERATE(0.0, 0.5);
+    biasing.roulette = GENERATE(0.0, 0.5);
+    CHECK(biasing.Scale(proton, neutron) == 8);
+    CHECK(biasing.Scale(proton, proton) == 4);
+
+    // Weighted probability of interacting with each target, and of not interacting at all
+    std::vector<achilles::StatsData> analog(ntargets+1), biased(ntargets+1);
+    size_t nhits_analog = 0, nhits_biased = 0;
+    for(size_t i = 0; i < ntrials; ++i) {
+        size_t hit_analog = ntargets, hit_biased = ntargets;
+        double weight = 1;
+        for(size_t j = 0; j < ntargets; ++j) {
+            if(achilles::Random::Instance().Uniform(0.0, 1.0) < prob) {
+                hit_analog = j;
+                break;
+            }
+        }
+        for(size_t j = 0; j < ntargets; ++j) {
+            if(biasing.Accept(prob, proton, targets[j], true, weight)) {
+                hit_biased = j;
+                break;
+            }
+            if(biasing.roulette > 0 && !biasing.Roulette(weight)) break;
+        }
+        if(hit_analog < ntargets) ++nhits_analog;
+        if(hit_biased < ntargets) ++nhits_biased;
+        for(size_t j = 0; j <= ntargets; ++j) {
+            analog[j] += j == hit_analog ? 1.0 : 0.0;
+            biased[j] += j == hit_biased ? weight : 0.0;
+        }
+    }
+
+    for(size_t j = 0; j <= ntargets; ++j) {
+        const double expected = j < ntargets ? prob*std::pow(1-prob, j) : std::pow(1-prob, ntargets);
+        CHECK(std::abs(analog[j].Mean() - expected) < nsigma*analog[j].Error());
+        CHECK(std::abs(biased[j].Mean() - expected) < nsigma*biased[j].Error());
+    }
+
+    // The interactions are oversampled
+    CHECK(nhits_biased > 2*nhits_analog);
+}
+
+TEST_CASE("Biased cascade matches the analog cascade", "[Cascade]") {
+    // A proton passing a row of spectators. The outgoing momenta are kept along the beam, so
+    // the struck nucleons can interact with the remaining spectators as well
+    static constexpr size_t ntrials = 20000;
+    static constexpr double radius = 10;
+    const double mass = achilles::Constant::mN, p = 1000;
+    achilles::Particles initial{{achilles::PID::proton(), {std::sqrt(p*p + mass*mass), 0, 0, p}, {0, 0, 0},
+                                 achilles::ParticleStatus::propagating}};
+    for(size_t i = 0; i < 4; ++i) {
+        initial.push_back({i % 2 ? achilles::PID::proton() : achilles::PID::neutron(), {mass, 0, 0, 0},
+                           {1, 0, 1.5*static_cast<double>(i + 1)}, achilles::ParticleStatus::background});
+    }
+
+    achilles::CascadeBiasing biasing;
+    biasing.scale = 3;
+    biasing.force_first = 0.5;
+
+    achilles::Particles hadrons;
+    auto nucleus = std::make_shared<MockNucleus>();
+    ALLOW_CALL(*nucleus, Nucleons())
+        .LR_RETURN((hadrons));
+    ALLOW_CALL(*nucleus, GetPotential())
+        .RETURN(nullptr);
+    ALLOW_CALL(*nucleus, Radius())
+        .RETURN(radius);
+    ALLOW_CALL(*nucleus, Rho(trompeloeil::_))
+        .RETURN(0);
+
+    // Weighted probability of no interaction, and weighted number of interactions
+    std::array<achilles::StatsData, 2> transparency, hits;
+    std::array<size_t, 2> ninteracted{};
+    for(size_t biased = 0; biased < 2; ++biased) {
+        auto interaction = std::make_unique<MockInteraction>();
+        ALLOW_CALL(*interaction, CrossSection(trompeloeil::_, trompeloeil::_))
+            .RETURN(10);
+        ALLOW_CALL(*interaction, FinalizeMomentum(trompeloeil::_, trompeloeil::_, trompeloeil::_))
+            .RETURN(std::make_pair(_1.Momentum(), _1.Momentum()));
+
+        achilles::Cascade cascade(std::move(interaction), achilles::Cascade::ProbabilityType::Gaussian,
+                                  achilles::Cascade::InMedium::None);
+        if(biased) cascade.SetBiasing(biasing);
+        for(size_t i = 0; i < ntrials; ++i) {
+            hadrons = initial;
+            cascade.SetKicked(0);
+            cascade.Evolve(nucleus);
+            const double weight = cascade.BiasWeight();
+            transparency[biased] += cascade.NHits() == 0 ? weight : 0;
+            hits[biased] += weight*static_cast<double>(cascade.NHits());
+            if(cascade.NHits() > 0) ++ninteracted[biased];
+        }
+    }
+
+    CHECK(std::abs(transparency[1].Mean() - transparency[0].Mean())
+          < nsigma*std::hypot(transparency[0].Error(), transparency[1].Error()));
+    CHECK(std::abs(hits[1].Mean() - hits[0].Mean()) < nsigma*std::hypot(hits[0].Error(), hits[1].Error()));
+    // The interactions are oversampled
+    CHECK(ninteracted[1] > 2*ninteracted[0]);
+}
+
+TEST_CASE("Formation of the kicked nucleon", "[Cascade]") {
+    // With the default model, forming the nucleon through the cascade gives the transparency of
+    // the formation zone set directly on the nucleon. The first spectator is within the formation zone
+    static constexpr size_t ntrials = 10000;
+    static constexpr unsigned int seed = 123456789;
+    static constexpr double radius = 10;
+    const double mass = achilles::Constant::mN, p = 1000;
+    const achilles::FourVector kick{std::sqrt(p*p + mass*mass), 0, 0, p};
+    achilles::Particles initial{{achilles::PID::proton(), {mass, 0, 0, 0}, {0, 0, 0},
+                                 achilles::ParticleStatus::propagating}};
+    for(size_t i = 0; i < 4; ++i) {
+        initial.push_back({i % 2 ? achilles::PID::proton() : achilles::PID::neutron(), {mass, 0, 0, 0},
+                           {1, 0, 0.3 + 1.5*static_cast<double>(i)}, achilles::ParticleStatus::background});
+    }
+
+    achilles::Particles hadrons;
+    auto nucleus = std::make_shared<MockNucleus>();
+    ALLOW_CALL(*nucleus, Nucleons())
+        .LR_RETURN((hadrons));
+    ALLOW_CALL(*nucleus, GetPotential())
+        .RETURN(nullptr);
+    ALLOW_CALL(*nucleus, Radius())
+        .RETURN(radius);
+    ALLOW_CALL(*nucleus, Rho(trompeloeil::_))
+        .RETURN(0);
+
+    // Formed by the cascade, formed directly on the nucleon, and not formed at all
+    std::array<size_t, 3> ntransparent{};
+    for(size_t mode = 0; mode < ntransparent.size(); ++mode) {
+        auto interaction = std::make_unique<MockInteraction>();
+        ALLOW_CALL(*interaction, CrossSection(trompeloeil::_, trompeloeil::_))
+            .RETURN(10);
+        ALLOW_CALL(*interaction, FinalizeMomentum(trompeloeil::_, trompeloeil::_, trompeloeil::_))
+            .RETURN(std::make_pair(_1.Momentum(), _1.Momentum()));
+
+        achilles::Cascade cascade(std::move(interaction), achilles::Cascade::ProbabilityType::Gaussian,
+                                  achilles::Cascade::InMedium::None);
+        achilles::Random::Instance().Seed(seed);
+        for(size_t i = 0; i < ntrials; ++i) {
+            hadrons = initial;
+            if(mode == 1) hadrons[0].SetFormationZone(initial[0].Momentum(), kick);
+            hadrons[0].SetMomentum(kick);
+            if(mode == 0) cascade.FormHadron(hadrons[0], initial[0].Momentum());
+            cascade.SetKicked(0);
+            cascade.Evolve(nucleus);
+            if(cascade.NHits() == 0) ++ntransparent[mode];
+        }
+    }
+
+    CHECK(ntransparent[0] == ntransparent[1]);
+    CHECK(ntransparent[2] < ntransparent[0]);
+}
+
+TEST_CASE("Formation of the hadrons from the hard scattering", "[Cascade]") {
+    static constexpr double radius = 10;
+    const double mass = achilles::Constant::mN, p = 1000;
+    const achilles::FourVector pin{mass - 20, 0, 0, 0}, pout{std::sqrt(p*p + mass*mass), 0, 0, p};
+    achilles::Particles hadrons{{achilles::PID::proton(), pin, {0, 0, 0}, achilles::ParticleStatus::initial_state},
+                                {achilles::PID::proton(), pout, {0, 0, 0}, achilles::ParticleStatus::propagating}};
+    auto nucleus = std::make_shared<MockNucleus>();
+    ALLOW_CALL(*nucleus, Nucleons())
+        .LR_RETURN((hadrons));
+    ALLOW_CALL(*nucleus, GetPotential())
+        .RETURN(nullptr);
+    ALLOW_CALL(*nucleus, Radius())
+        .RETURN(radius);
+    ALLOW_CALL(*nucleus, Rho(trompeloeil::_))
+        .RETURN(0);
+
+    achilles::Event event;
+    event.CurrentNucleus() = nucleus;
+    achilles::Cascade cascade(std::make_unique<MockInteraction>(), achilles::Cascade::ProbabilityType::Gaussian,
+                              achilles::Cascade::InMedium::None);
+
+    SECTION("The default model leaves them unformed") {
+        cascade.Evolve(&event);
+        CHECK(hadrons[1].Status() == achilles::ParticleStatus::final_state);
+        CHECK(hadrons[1].FormationTime() == 0);
+    }
+
+    SECTION("Other models form them") {
+        cascade.SetFormationZone(std::make_unique<achilles::ConstantFormationZone>(YAML::Load("Tau: 1")));
+        cascade.Evolve(&event);
+        const achilles::Particle expected{achilles::PID::proton(), pout};
+        CHECK(hadrons[1].Status() == achilles::ParticleStatus::final_state);
+        CHECK(hadrons[1].FormationTime() == Approx(pout.E()/expected.Mass()/achilles::Constant::HBARC));
+    }
+}
+
+TEST_CASE("Default cascade of the hadrons from the hard scattering", "[Cascade]") {
+    // Under the default model, the cascade of an event gives the transparency of the hadrons
+    // kicked without any formation zone. The first spectator is within the default formation zone
+    static constexpr size_t ntrials = 10000;
+    static constexpr unsigned int seed = 123456789;
+    static constexpr double radius = 10;
+    const double mass = achilles::Constant::mN, p = 1000;
+    const achilles::FourVector pin{mass - 20, 0, 0, 0}, pout{std::sqrt(p*p + mass*mass), 0, 0, p};
+    achilles::Particles initial{{achilles::PID::proton(), pin, {0, 0, 0}, achilles::ParticleStatus::initial_state},
+                                {achilles::PID::proton(), pout, {0, 0, 0}, achilles::ParticleStatus::propagating}};
+    for(size_t i = 0; i < 4; ++i) {
+        initial.push_back({i % 2 ? achilles::PID::proton() : achilles::PID::neutron(), {mass, 0, 0, 0},
+                           {1, 0, 0.3 + 1.5*static_cast<double>(i)}, achilles::ParticleStatus::background});
+    }
+
+    achilles::Particles hadrons;
+    auto nucleus = std::make_shared<MockNucleus>();
+    ALLOW_CALL(*nucleus, Nucleons())
+        .LR_RETURN((hadrons));
+    ALLOW_CALL(*nucleus, GetPotential())
+        .RETURN(nullptr);
+    ALLOW_CALL(*nucleus, Radius())
+        .RETURN(radius);
+    ALLOW_CALL(*nucleus, Rho(trompeloeil::_))
+        .RETURN(0);
+
+    // Cascade of the event, and of the kicked hadron
+    std::array<size_t, 2> ntransparent{};
+    for(size_t mode = 0; mode < ntransparent.size(); ++mode) {
+        auto interaction = std::make_unique<MockInteraction>();
+        ALLOW_CALL(*interaction, CrossSection(trompeloeil::_, trompeloeil::_))
+            .RETURN(10);
+        ALLOW_CALL(*interaction, FinalizeMomentum(trompeloeil::_, trompeloeil::_, trompeloeil::_))
+            .RETURN(std::make_pair(_1.Momentum(), _1.Momentum()));
+
+        achilles::Cascade cascade(std::move(interaction), achilles::Cascade::ProbabilityType::Gaussian,
+                                  achilles::Cascade::InMedium::None);
+        achilles::Random::Instance().Seed(seed);
+        for(size_t i = 0; i < ntrials; ++i) {
+            hadrons = initial;
+            if(mode == 0) {
+                achilles::Event event;
+                event.CurrentNucleus() = nucleus;
+                cascade.Evolve(&event);
+            } else {
+                cascade.SetKicked(1);
+                cascade.Evolve(nucleus);
+            }
+            if(cascade.NHits() == 0) ++ntransparent[mode];
+        }
+    }
+
+    CHECK(ntransparent[0] == ntransparent[1]);
+    CHECK(ntransparent[0] < ntrials);
+}
+
+TEST_CASE("Cascade biasing probabilities", "[Cascade]") {
+    achilles::CascadeBiasing biasing;
+    CHECK_FALSE(biasing.Enabled());
+    CHECK(biasing.Probability(0.3, achilles::PID::proton(), achilles::PID::proton(), true) == 0.3);
+
+    biasing.scale = 100;
+    biasing.force_first = 0.5;
+    CHECK(biasing.Enabled());
+    // Capped below one, unless the interaction is certain
+    CHECK(biasing.Probability(0.3, achilles::PID::proton(), achilles::PID::proton(), false)
+          == achilles::CascadeBiasing::max_prob);
+    CHECK(biasing.Probability(1, achilles::PID::proton(), achilles::PID::proton(), false) == 1);
+    CHECK(biasing.Probability(0, achilles::PID::proton(), achilles::PID::proton(), true) == 0);
+    // Forcing the first interaction moves the probability towards one
+    biasing.scale = 1;
+    CHECK(biasing.Probability(0.2, achilles::PID::proton(), achilles::PID::proton(), true)
+          == Approx(0.6));
+}
+
+TEST_CASE("Cascade watchdog", "[Cascade]") {
+    using Reason = achilles::CascadeWatchdog::Reason;
+    constexpr double radius = 1;
+
+    SECTION("Record aborted events") {
+        achilles::CascadeWatchdog watchdog;
+        for(size_t i = 0; i < 2*achilles::CascadeWatchdog::max_examples; ++i)
+            watchdog.Record(Reason::MaxSteps, i);
+        watchdog.Record(Reason::NaN, 42);
+        CHECK(watchdog.Total() == 2*achilles::CascadeWatchdog::max_examples + 1);
+        CHECK(watchdog.Count(Reason::MaxSteps) == 2*achilles::CascadeWatchdog::max_examples);
+        CHECK(watchdog.Count(Reason::WallTime) == 0);
+        CHECK(watchdog.Examples(Reason::MaxSteps).size() == achilles::CascadeWatchdog::max_examples);
+        CHECK(watchdog.Examples(Reason::NaN) == std::vector<size_t>{42});
+    }
+
+    SECTION("YAML settings") {
+        YAML::Node node = YAML::Load(R"node(
+        MaxSteps: 1000
+        MaxTime: 0.5
+        EnergyTolerance: 10
+        Policy: Retry
+        MaxRetries: 2
+        )node");
+        auto watchdog = node.as<achilles::CascadeWatchdog>();
+        CHECK(watchdog.max_steps == 1000);
+        CHECK(watchdog.max_time == 0.5);
+        CHECK(watchdog.energy_tolerance == 10);
+        CHECK(watchdog.policy == achilles::CascadeWatchdog::Policy::Retry);
+        CHECK(watchdog.max_retries == 2);
+        CHECK_THROWS(YAML::Load("Policy: Ignore").as<achilles::CascadeWatchdog>());
+    }
+
+    SECTION("Abort on the step budget") {
+        achilles::Particles hadrons = {{achilles::PID::proton(), {1000, 100, 0, 0},
+                                       {0, 0, 0}, achilles::ParticleStatus::propagating}};
+        hadrons[0].SetFormationZone({10000, 0, 0, 0}, {88.2, 0, 0, 0});
+        const auto original = hadrons;
+
+        auto interaction = std::make_unique<MockInteraction>();
+        auto nucleus = std::make_shared<MockNucleus>();
+        REQUIRE_CALL(*nucleus, Nucleons())
+            .TIMES(1)
+            .LR_RETURN((hadrons));
+        REQUIRE_CALL(*nucleus, GetPotential())
+            .TIMES(1)
+            .RETURN(nullptr);
+        ALLOW_CALL(*nucleus, Radius())
+            .RETURN(radius);
+
+        achilles::Cascade cascade(std::move(interaction), achilles::Cascade::ProbabilityType::Gaussian,
+                                  achilles::Cascade::InMedium::None);
+        achilles::CascadeWatchdog watchdog;
+        watchdog.max_steps = 1;
+        cascade.SetWatchdog(watchdog);
+        cascade.SetKicked(0);
+        try {
+            cascade.Evolve(nucleus);
+            FAIL("Cascade should have been aborted");
+        } catch(const achilles::CascadeAbort &abort) {
+            CHECK(abort.Reason() == Reason::MaxSteps);
+        }
+
+        // The nucleus is left untouched
+        CHECK(hadrons == original);
+    }
+
+    SECTION("Abort on non-finite momenta") {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        achilles::Particles hadrons = {{achilles::PID::proton(), {1000, nan, 0, 0},
+                                       {0, 0, 0}, achilles::ParticleStatus::propagating}};
+        hadrons[0].SetFormationZone({10000, 0, 0, 0}, {88.2, 0, 0, 0});
+
+        auto interaction = std::make_unique<MockInteraction>();
+        auto nucleus = std::make_shared<MockNucleus>();
+        REQUIRE_CALL(*nucleus, Nucleons())
+            .TIMES(1)
+            .LR_RETURN((hadrons));
+        REQUIRE_CALL(*nucleus, GetPotential())
+            .TIMES(1)
+            .RETURN(nullptr);
+        ALLOW_CALL(*nucleus, Radius())
+            .RETURN(radius);
+
+        achilles::Cascade cascade(std::move(interaction), achilles::Cascade::ProbabilityType::Gaussian,
+                                  achilles::Cascade::InMedium::None);
+        cascade.SetKicked(0);
+        try {
+            cascade.Evolve(nucleus);
+            FAIL("Cascade should have been aborted");
+        } catch(const achilles::CascadeAbort &abort) {
+            CHECK(abort.Reason() == Reason::NaN);
+        }
+    }
+}
+
+TEST_CASE("Transport mode keeps the collisions within each copy", "[Cascade]") {
+    // A proton passing a row of spectators, which are in its path in the other copies. Without
+    // a mean field, the energy of the kept copy is conserved by the elastic collisions
+    static constexpr size_t ntrials = 2000;
+    static constexpr double radius = 7;
+    const double mass = achilles::ParticleInfo(achilles::PID::proton()).Mass(), p = 1000;
+    achilles::Particles initial{{achilles::PID::proton(), {std::sqrt(p*p + mass*mass), 0, 0, p}, {0, 0, 0},
+                                 achilles::ParticleStatus::propagating}};
+    for(size_t i = 0; i < 4; ++i) {
+        const auto pid = i % 2 ? achilles::PID::proton() : achilles::PID::neutron();
+        initial.push_back({pid, {achilles::ParticleInfo(pid).Mass(), 0, 0, 0},
+                           {1, 0, 1.5*static_cast<double>(i + 1)}, achilles::ParticleStatus::background});
+    }
+    double initial_energy = 0;
+    for(const auto &part : initial) initial_energy += part.Momentum().E();
+
+    achilles::Particles hadrons;
+    auto nucleus = std::make_shared<MockNucleus>();
+    ALLOW_CALL(*nucleus, Nucleons())
+        .LR_RETURN((hadrons));
+    ALLOW_CALL(*nucleus, GetPotential())
+        .RETURN(nullptr);
+    ALLOW_CALL(*nucleus, Radius())
+        .RETURN(radius);
+    ALLOW_CALL(*nucleus, Rho(trompeloeil::_))
+        .RETURN(0);
+    ALLOW_CALL(*nucleus, GenerateConfig())
+        .LR_SIDE_EFFECT(for(auto &part : hadrons) {
+            if(part.Status() == achilles::ParticleStatus::background)
+                part.SetPosition({0, 0, part.Position().Z()});
+        });
+
+    // Elastic scattering by 90 degrees in the center of mass frame
+    auto elastic = [](const achilles::Particle &part1, const achilles::Particle &part2) {
+        const auto beta = (part1.Momentum() + part2.Momentum()).BoostVector();
+        const auto k1 = part1.Momentum().Boost(-beta), k2 = part2.Momentum().Boost(-beta);
+        return std::make_pair(achilles::FourVector{k1.E(), k1.P(), 0, 0}.Boost(beta),
+                              achilles::FourVector{k2.E(), -k1.P(), 0, 0}.Boost(beta));
+    };
+
+    achilles::TransportParams transport;
+    transport.ensembles = 4;
+    transport.alpha = transport.beta = 0;
+    transport.size = 3;
+    achilles::CascadeWatchdog watchdog;
+    watchdog.energy_tolerance = 1e-6;
+
+    // The kept copy of the transport mode interacts like the cascade without copies
+    std::array<achilles::StatsData, 2> transparency;
+    for(size_t mode = 0; mode < transparency.size(); ++mode) {
+        auto interaction = std::make_unique<MockInteraction>();
+        ALLOW_CALL(*interaction, CrossSection(trompeloeil::_, trompeloeil::_))
+            .RETURN(10);
+        ALLOW_CALL(*interaction, FinalizeMomentum(trompeloeil::_, trompeloeil::_, trompeloeil::_))
+            .LR_RETURN(elastic(_1, _2));
+
+        achilles::Cascade cascade(std::move(interaction), achilles::Cascade::ProbabilityType::Gaussian,
+                                  achilles::Cascade::InMedium::None);
+        cascade.SetWatchdog(watchdog);
+        if(mode == 1) cascade.SetTransport(transport);
+        for(size_t i = 0; i < ntrials; ++i) {
+            hadrons = initial;
+            cascade.SetKicked(0);
+            REQUIRE_NOTHROW(cascade.Evolve(nucleus));
+            REQUIRE(hadrons.size() == initial.size());
+            double energy = 0;
+            for(const auto &part : hadrons) energy += part.Momentum().E();
+            CHECK(energy == Approx(initial_energy));
+            transparency[mode] += cascade.NHits() == 0 ? 1 : 0;
+        }
+    }
+
+    CHECK(std::abs(transparency[1].Mean() - transparency[0].Mean())
+          < nsigma*std::hypot(transparency[0].Error(), transparency[1].Error()));
+}
+
+TEST_CASE("Potential propagation conserves the energy", "[Cascade]") {
+    static constexpr double radius = 6;
+    const double mass = achilles::ParticleInfo(achilles::PID::proton()).Mass();
+    const achilles::ThreeVector momentum{0, 300, 400};
+    achilles::Particles hadrons{{achilles::PID::proton(), {momentum, std::sqrt(momentum.P2() + mass*mass)},
+                                 {1, 0, 0}, achilles::ParticleStatus::propagating}};
+
+    // Attractive scalar and repulsive vector fields with a Woods-Saxon shape
+    auto field = [](double r) {
+        const double shape = 1/(1 + std::exp((r - 3)/0.5));
+        achilles::PotentialVals vals{};
+        vals.rscalar = -60*shape;
+        vals.rvector = 30*shape;
+        return vals;
+    };
+    auto hamiltonian = [&](double p, double r) {
+        const auto vals = field(r);
+        return std::sqrt(p*p + std::pow(achilles::Constant::mN + vals.rscalar, 2)) + vals.rvector;
+    };
+
+    auto interaction = std::make_unique<MockInteraction>();
+    auto nucleus = std::make_shared<MockNucleus>();
+    auto potential = std::make_shared<MockPotential>();
+    ALLOW_CALL(*nucleus, Nucleons())
+        .LR_RETURN((hadrons));
+    ALLOW_CALL(*nucleus, GetPotential())
+        .LR_RETURN((potential));
+    ALLOW_CALL(*nucleus, Radius())
+        .RETURN(radius);
+    ALLOW_CALL(*potential, call_op(trompeloeil::_, trompeloeil::_))
+        .LR_RETURN(field(_2));
+    ALLOW_CALL(*potential, Hamiltonian(trompeloeil::_, trompeloeil::_))
+        .LR_RETURN(hamiltonian(_1, _2));
+
+    achilles::Cascade cascade(std::move(interaction), achilles::Cascade::ProbabilityType::Gaussian,
+                              achilles::Cascade::InMedium::None, true);
+    cascade.SetKicked(0);
+    cascade.NuWro(nucleus);
+
+    // The proton climbs out of the field, and loses momentum at a fixed energy
+    REQUIRE(hadrons[0].Status() == achilles::ParticleStatus::final_state);
+    CHECK(hadrons[0].Radius() > radius);
+    CHECK(hadrons[0].Momentum().P() < momentum.P());
+    CHECK(hamiltonian(hadrons[0].Momentum().P(), hadrons[0].Radius())
+          == Approx(hamiltonian(momentum.P(), 1)).margin(0.1));
 }
@@ -0,0 +1,156 @@
+#include "catch2/catch.hpp"
+
+#include "Achilles/Coalescence.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/Random.hh"
+
+#include <cmath>
+
+achilles::Particle Nucleon(achilles::PID pid, const achilles::ThreeVector &momentum,
+                           const achilles::ThreeVector &position,
+                           achilles::ParticleStatus status = achilles::ParticleStatus::final_state) {
+    const double mass = achilles::ParticleInfo(pid).Mass();
+    return {pid, {momentum, std::sqrt(momentum.P2() + mass*mass)}, position, status};
+}
+
+TEST_CASE("Cluster species", "[Coalescence]") {
+    CHECK(achilles::Coalescence::Cluster(1, 1) == achilles::PID::deuteron());
+    CHECK(achilles::Coalescence::Cluster(1, 2) == achilles::PID::triton());
+    CHECK(achilles::Coalescence::Cluster(2, 1) == achilles::PID::helium3());
+    CHECK(achilles::Coalescence::Cluster(2, 2) == achilles::PID::alpha());
+    CHECK(achilles::Coalescence::Cluster(2, 0) == achilles::PID::undefined());
+    CHECK(achilles::Coalescence::Cluster(0, 3) == achilles::PID::undefined());
+}
+
+TEST_CASE("Coalescence of light clusters", "[Coalescence]") {
+    static constexpr double radius = 3;
+    achilles::Coalescence coalescence{};
+    const achilles::ThreeVector momentum{0, 100, 400};
+
+    SECTION("A close proton-neutron pair forms a deuteron") {
+        achilles::Particles particles{Nucleon(achilles::PID::proton(), momentum + achilles::ThreeVector{50, 0, 0}, {0, 0, 4}),
+                                      Nucleon(achilles::PID::neutron(), momentum - achilles::ThreeVector{50, 0, 0}, {1, 0, 4}),
+                                      Nucleon(achilles::PID::proton(), {0, 0, 100}, {0, 0, 0},
+                                              achilles::ParticleStatus::background)};
+        CHECK(coalescence.Form(particles, radius) == 1);
+        REQUIRE(particles.size() == 2);
+        CHECK(particles[0].Status() == achilles::ParticleStatus::background);
+
+        const auto &deuteron = particles[1];
+        CHECK(deuteron.ID() == achilles::PID::deuteron());
+        CHECK(deuteron.Status() == achilles::ParticleStatus::final_state);
+        CHECK((deuteron.Momentum().Vec3() - 2*momentum).Magnitude() == Approx(0).margin(1e-8));
+        CHECK(deuteron.Momentum().M() == Approx(achilles::ParticleInfo(achilles::PID::deuteron()).Mass()));
+        CHECK((deuteron.Position() - achilles::ThreeVector{0.5, 0, 4}).Magnitude() == Approx(0).margin(1e-12));
+    }
+
+    SECTION("Pairs apart in phase space or not bound do not coalesce") {
+        achilles::Particles far{Nucleon(achilles::PID::proton(), momentum, {0, 0, 4}),
+                                Nucleon(achilles::PID::neutron(), momentum, {0, 0, -4})};
+        achilles::Particles fast{Nucleon(achilles::PID::proton(), momentum, {0, 0, 4}),
+                                 Nucleon(achilles::PID::neutron(), -momentum, {0, 0, 4})};
+        achilles::Particles protons{Nucleon(achilles::PID::proton(), momentum, {0, 0, 4}),
+                                    Nucleon(achilles::PID::proton(), momentum, {0, 0, 4.5})};
+        for(auto *particles : {&far, &fast, &protons}) {
+            CHECK(coalescence.Form(*particles, radius) == 0);
+            CHECK(particles -> size() == 2);
+        }
+    }
+
+    SECTION("Four nucleons form an alpha") {
+        achilles::Particles particles;
+        for(const auto &pid : {achilles::PID::proton(), achilles::PID::neutron()}) {
+            particles.push_back(Nucleon(pid, momentum, {0, 0, 4}));
+            particles.push_back(Nucleon(pid, momentum, {0, 1, 4}));
+        }
+        // Beyond the largest cluster
+        particles.push_back(Nucleon(achilles::PID::neutron(), momentum, {0, 0.5, 4}));
+        CHECK(coalescence.Form(particles, radius) == 1);
+        REQUIRE(particles.size() == 2);
+        CHECK(particles[0].ID() == achilles::PID::neutron());
+        CHECK(particles[1].ID() == achilles::PID::alpha());
+        CHECK(particles[1].Momentum().Vec3().P() == Approx(4*momentum.P()));
+
+        particles = {Nucleon(achilles::PID::proton(), momentum, {0, 0, 4}),
+                     Nucleon(achilles::PID::neutron(), momentum, {0, 1, 4}),
+                     Nucleon(achilles::PID::neutron(), momentum, {1, 0, 4})};
+        CHECK(coalescence.Form(particles, radius) == 1);
+        CHECK(particles.back().ID() == achilles::PID::triton());
+    }
+
+    SECTION("Spectators near the surface join the clusters") {
+        achilles::Particles particles{Nucleon(achilles::PID::proton(), {0, 0, 200}, {0, 0, 3.5}),
+                                      Nucleon(achilles::PID::neutron(), {0, 0, 100}, {0, 0, 2.5},
+                                              achilles::ParticleStatus::background)};
+        CHECK(coalescence.Form(particles, radius) == 0);
+
+        achilles::Coalescence surface{{3.5, 300, 1}};
+        CHECK(surface.Form(particles, radius) == 1);
+        CHECK(particles.back().ID() == achilles::PID::deuteron());
+    }
+
+    SECTION("Spectators do not coalesce on their own") {
+        achilles::Particles particles{Nucleon(achilles::PID::proton(), {0, 0, 100}, {0, 0, 2.5},
+                                              achilles::ParticleStatus::background),
+                                      Nucleon(achilles::PID::neutron(), {0, 0, 100}, {0, 0.5, 2.5},
+                                              achilles::ParticleStatus::background),
+                                      Nucleon(achilles::PID::proton(), {0, 0, 100}, {0, 0, 0},
+                                              achilles::ParticleStatus::background)};
+        achilles::Coalescence surface{{3.5, 300, 1}};
+        CHECK(surface.Form(particles, radius) == 0);
+        CHECK(particles.size() == 3);
+
+        // An outgoing nucleon seeds the cluster, and picks up the spectators
+        particles.push_back(Nucleon(achilles::PID::neutron(), {0, 0, 200}, {0, 0, 3.5}));
+        CHECK(surface.Form(particles, radius) == 1);
+        REQUIRE(particles.size() == 2);
+        CHECK(particles[0].Status() == achilles::ParticleStatus::background);
+        CHECK(particles[1].ID() == achilles::PID::triton());
+    }
+
+    SECTION("Clusters are found in large events") {
+        achilles::Particles particles;
+        for(size_t i = 0; i < 1000; ++i) {
+            const auto pid = i % 2 == 0 ? achilles::PID::proton() : achilles::PID::neutron();
+            achilles::ThreeVector position{achilles::Random::Instance().Uniform(-50.0, 50.0),
+                                           achilles::Random::Instance().Uniform(-50.0, 50.0),
+                                           achilles::Random::Instance().Uniform(-50.0, 50.0)};
+            particles.push_back(Nucleon(pid, momentum, position));
+        }
+        const size_t nclusters = coalescence.Form(particles, radius);
+        CHECK(nclusters > 0);
+
+        size_t nbaryons = 0;
+        for(const auto &particle : particles) {
+            const auto id = particle.ID().AsInt();
+            nbaryons += id > 1000000000 ? static_cast<size_t>((id/10) % 1000) : 1;
+        }
+        CHECK(nbaryons == 1000);
+    }
+}
+
+TEST_CASE("Coalescence settings", "[Coalescence]") {
+    YAML::Node node = YAML::Load(R"node(
+    Radius: 4
+    Momentum: 250
+    Surface: 1
+    MaxSize: 2
+    )node");
+
+    auto params = node.as<achilles::CoalescenceParams>();
+    CHECK(params.radius == 4);
+    CHECK(params.momentum == 250);
+    CHECK(params.surface == 1);
+    CHECK(params.max_size == 2);
+
+    achilles::Coalescence coalescence{params};
+    achilles::Particles particles;
+    for(const auto &pid : {achilles::PID::proton(), achilles::PID::neutron(), achilles::PID::neutron()})
+        particles.push_back(Nucleon(pid, {0, 0, 300}, {0, 0, 5}));
+    CHECK(coalescence.Form(particles, 3) == 1);
+    CHECK(particles.back().ID() == achilles::PID::deuteron());
+
+    node["Momentum"] = -1;
+    CHECK_THROWS(node.as<achilles::CoalescenceParams>());
+    CHECK_THROWS(achilles::Coalescence({3.5, 300, 0, 5}));
+}
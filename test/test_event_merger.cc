@@ -0,0 +1,188 @@
+#include "catch2/catch.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "Achilles/EventMerger.hh"
+#include "Achilles/Random.hh"
+#include "Achilles/Statistics.hh"
+#include "Achilles/Version.hh"
+
+#include "fmt/format.h"
+
+using achilles::EventMerger;
+using achilles::SampleSummary;
+
+namespace {
+
+// The lines written after the weight of each event are optional
+void WriteSample(const std::string &filename, const std::vector<double> &weights,
+                 const std::vector<std::string> &extras = {}) {
+    std::ofstream out(filename);
+    out << fmt::format("Achilles Version: {0}\n{1:-^40}\n\nRun: {2}\n{1:-^40}\n\n",
+                       ACHILLES_VERSION, "", filename);
+    for(size_t i = 0; i < weights.size(); ++i) {
+        out << fmt::format("Event: {}\n  Particles:\n  - dummy\n  Weight: {}\n", i+1, weights[i]);
+        if(i < extras.size()) out << extras[i];
+    }
+}
+
+std::string ReadFile(const std::string &filename) {
+    std::ifstream in(filename);
+    std::stringstream contents;
+    contents << in.rdbuf();
+    return contents.str();
+}
+
+}
+
+TEST_CASE("Combine samples", "[EventMerger]") {
+    SampleSummary sample1, sample2;
+    sample1.xsec = 10; sample1.error = 1; sample1.trials = 100; sample1.nevents = 10; sample1.max_weight = 2;
+    sample2.xsec = 13; sample2.error = 2; sample2.trials = 200; sample2.nevents = 20; sample2.max_weight = 3;
+
+    auto combined = EventMerger::Combine({sample1, sample2});
+    CHECK(combined.xsec == Approx(12));
+    CHECK(combined.error == Approx(std::sqrt(100.0*100 + 400.0*400)/300));
+    CHECK(combined.trials == 300);
+    CHECK(combined.nevents == 30);
+    CHECK(combined.max_weight == 3);
+
+    SECTION("Empty samples") {
+        auto empty = EventMerger::Combine({});
+        CHECK(empty.xsec == 0);
+        CHECK(empty.trials == 0);
+    }
+}
+
+TEST_CASE("Reunweighting is unbiased", "[EventMerger]") {
+    achilles::Random::Instance().Seed(123456789);
+    static constexpr double max_wgt = 4;
+    static constexpr size_t ntrials = 100000;
+    for(const double wgt : {1.0, -3.0, 5.0}) {
+        achilles::StatsData results;
+        size_t nbelow = 0;
+        for(size_t i = 0; i < ntrials; ++i) {
+            const double new_wgt = EventMerger::Reunweight(wgt, max_wgt);
+            if(new_wgt != 0 && std::abs(new_wgt) < max_wgt) ++nbelow;
+            results += new_wgt;
+        }
+        CHECK(nbelow == 0);
+        CHECK(std::abs(results.Mean() - wgt) <= 5*results.Error());
+    }
+}
+
+TEST_CASE("Merging Achilles samples", "[EventMerger]") {
+    const std::string file1 = "merger_test1.txt", file2 = "merger_test2.txt", output = "merger_out.txt";
+    WriteSample(file1, {0, 2, 0, 2});
+    WriteSample(file2, {0, 0, 4, 0});
+
+    SECTION("Keep weights") {
+        achilles::AchillesMerger merger({file1, file2}, false);
+        merger.Initialize();
+        REQUIRE(merger.Summaries().size() == 2);
+        CHECK(merger.Summaries()[0].xsec == Approx(1));
+        CHECK(merger.Summaries()[0].trials == 4);
+        CHECK(merger.Summaries()[0].max_weight == 2);
+        CHECK(merger.Combined().xsec == Approx(1));
+        CHECK(merger.Combined().trials == 8);
+        CHECK(merger.Combined().max_weight == 4);
+        merger.Merge(output);
+
+        achilles::AchillesMerger check({output}, false);
+        check.Initialize();
+        CHECK(check.Combined().xsec == Approx(1));
+        CHECK(check.Combined().trials == 8);
+
+        const auto contents = ReadFile(output);
+        CHECK(contents.find("Run: merger_test1.txt") != std::string::npos);
+        CHECK(contents.find("Event: 8") != std::string::npos);
+        CHECK(contents.find("  CrossSection: 1") != std::string::npos);
+    }
+
+    SECTION("Lines after the weight are kept") {
+        WriteSample(file1, {0, 2, 0, 2}, {"", "  BiasWeight: 0.5\n"});
+        WriteSample(file2, {0, 0, 4, 0}, {"", "", "  CascadeFlag: 3\n"});
+        achilles::AchillesMerger merger({file1, file2}, false);
+        merger.Merge(output);
+
+        const auto contents = ReadFile(output);
+        CHECK(contents.find("Event: 2\n  Particles:\n  - dummy\n  Weight: 2\n  BiasWeight: 0.5\nEvent: 3\n")
+              != std::string::npos);
+        CHECK(contents.find("Event: 7\n  Particles:\n  - dummy\n  Weight: 4\n  CascadeFlag: 3\nEvent: 8\n")
+              != std::string::npos);
+    }
+
+    SECTION("Reunweight") {
+        achilles::AchillesMerger merger({file1, file2});
+        merger.Merge(output);
+
+        achilles::AchillesMerger check({output}, false);
+        check.Initialize();
+        CHECK(check.Combined().trials == 8);
+        CHECK((check.Combined().max_weight == 0 || check.Combined().max_weight == 4));
+    }
+
+    std::remove(file1.c_str());
+    std::remove(file2.c_str());
+    std::remove(output.c_str());
+}
+
+TEST_CASE("Merging oversampled Achilles samples", "[EventMerger]") {
+    const std::string file1 = "merger_test1.txt", file2 = "merger_test2.txt", output = "merger_out.txt";
+    // Three primary events, the second one is rejected before the cascade
+    WriteSample(file1, {1, 1, 0, 0.5, 1.5}, {"  Realization: 1 / 2 (Primary: 1)\n",
+                                             "  Realization: 2 / 2 (Primary: 1)\n", "",
+                                             "  Realization: 1 / 2 (Primary: 3)\n",
+                                             "  Realization: 2 / 2 (Primary: 3)\n"});
+    WriteSample(file2, {0, 0, 4, 0});
+
+    achilles::AchillesMerger merger({file1, file2}, false);
+    merger.Initialize();
+    CHECK(merger.Summaries()[0].trials == 3);
+    CHECK(merger.Summaries()[0].nevents == 2);
+    CHECK(merger.Summaries()[0].xsec == Approx(4.0/3.0));
+    CHECK(merger.Summaries()[0].max_weight == 2);
+    CHECK(merger.Combined().trials == 7);
+    CHECK(merger.Combined().xsec == Approx(8.0/7.0));
+
+    SECTION("Keep weights") {
+        merger.Merge(output);
+        const auto contents = ReadFile(output);
+        CHECK(contents.find("  Weight: 1.5\n  Realization: 2 / 2 (Primary: 3)\nEvent: 6\n") != std::string::npos);
+
+        achilles::AchillesMerger check({output}, false);
+        check.Initialize();
+        CHECK(check.Combined().trials == 7);
+        CHECK(check.Combined().xsec == Approx(8.0/7.0));
+    }
+
+    SECTION("Reunweight the primary events") {
+        for(size_t i = 0; i < 20; ++i) {
+            achilles::AchillesMerger reunweight({file1, file2});
+            reunweight.Merge(output);
+
+            // The weight of 4 of an accepted primary event keeps its split over the realizations
+            std::ifstream in(output);
+            std::string line;
+            std::vector<double> wgts;
+            while(std::getline(in, line)) {
+                if(line.rfind("  Weight: ", 0) == 0) wgts.push_back(std::stod(line.substr(10)));
+            }
+            REQUIRE(wgts.size() == 9);
+            CHECK(wgts[0] == wgts[1]);
+            CHECK((wgts[0] == 0 || wgts[0] == Approx(2)));
+            CHECK(wgts[3] == Approx(wgts[4]/3));
+            CHECK((wgts[3] == 0 || wgts[3] == Approx(1)));
+
+            achilles::AchillesMerger check({output}, false);
+            check.Initialize();
+            CHECK(check.Combined().trials == 7);
+        }
+    }
+
+    std::remove(file1.c_str());
+    std::remove(file2.c_str());
+    std::remove(output.c_str());
+}
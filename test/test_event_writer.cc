@@ -60,3 +60,61 @@ TEST_CASE("Builtin", "[EventWriter]") {
         CHECK(ss.str() == expected);
     }
 }
+
+TEST_CASE("BufferWriter", "[EventWriter]") {
+    static constexpr achilles::FourVector hadron0{65.4247, 26.8702, -30.5306, -10.9449};
+    static constexpr achilles::FourVector hadron1{1560.42, -78.4858, -204.738, 1226.89};
+    achilles::Particles particles = {
+        {achilles::PID::proton(), hadron0, {}, achilles::ParticleStatus::initial_state},
+        {achilles::PID::proton(), hadron1, {}, achilles::ParticleStatus::final_state}};
+    achilles::NuclearRemnant remnant(11, 5);
+
+    achilles::BufferWriter writer;
+    MockEvent event;
+    event.Flux() = 2.0;
+    const MockEvent &cevent = event;
+
+    SECTION("Zero weight events are only counted") {
+        double wgt = 0.0;
+        REQUIRE_CALL(cevent, Weight())
+            .TIMES(1)
+            .LR_RETURN((wgt));
+
+        writer.Write(event);
+        CHECK(writer.Trials() == 1);
+        CHECK(writer.Events().empty());
+        CHECK(writer.Particles().empty());
+    }
+
+    SECTION("Events are flattened") {
+        double wgt = 1.5;
+        REQUIRE_CALL(cevent, Particles())
+            .TIMES(2)
+            .LR_RETURN((particles));
+        REQUIRE_CALL(cevent, Remnant())
+            .TIMES(2)
+            .LR_RETURN((remnant));
+        REQUIRE_CALL(cevent, Weight())
+            .TIMES(4)
+            .LR_RETURN((wgt));
+
+        writer.Write(event);
+        writer.Write(event);
+        CHECK(writer.Trials() == 2);
+        REQUIRE(writer.Events().size() == 2);
+        REQUIRE(writer.Particles().size() == 4);
+        CHECK(writer.Events()[1].weight == 1.5);
+        CHECK(writer.Events()[1].flux == 2.0);
+        CHECK(writer.Events()[1].nparticles == 2);
+        CHECK(writer.Events()[1].remnant_pid == remnant.PID());
+        CHECK(writer.Particles()[3].event == 1);
+        CHECK(writer.Particles()[3].pid == 2212);
+        CHECK(writer.Particles()[3].status == static_cast<int>(achilles::ParticleStatus::final_state));
+        CHECK(writer.Particles()[3].E == hadron1.E());
+        CHECK(writer.Particles()[3].pz == hadron1.Pz());
+
+        writer.Clear();
+        CHECK(writer.Trials() == 0);
+        CHECK(writer.Events().empty());
+    }
+}
@@ -0,0 +1,165 @@
+#include "catch2/catch.hpp"
+#include "Achilles/Foam.hh"
+#include "Achilles/MultiChannel.hh"
+#include "Achilles/Vegas.hh"
+#include "catch_utils.hh"
+
+// Narrow ridge along the diagonal, which can not be described by a product of 1D maps
+double test_func_ridge(const std::vector<double> &x, double wgt) {
+    static constexpr double width = 0.02;
+    const double dx = x[0] - x[1];
+    return std::exp(-dx*dx/(2*width*width))*wgt;
+}
+
+// Ratio of the maximum to the mean weight when sampling with the given map
+template<typename Map>
+double MaxOverMean(Map map, size_t npoints) {
+    std::vector<double> rans(2);
+    double sum = 0, max = 0;
+    for(size_t i = 0; i < npoints; ++i) {
+        achilles::Random::Instance().Generate(rans);
+        const double jac = map(rans);
+        const double wgt = test_func_ridge(rans, jac);
+        sum += wgt;
+        max = std::max(max, wgt);
+    }
+    return max*static_cast<double>(npoints)/sum;
+}
+
+void TrainFoam(achilles::Foam &foam, size_t niterations, size_t npoints) {
+    std::vector<double> rans(2);
+    for(size_t i = 0; i < niterations; ++i) {
+        for(size_t j = 0; j < npoints; ++j) {
+            achilles::Random::Instance().Generate(rans);
+            const double jac = foam(rans);
+            const double wgt = test_func_ridge(rans, jac);
+            foam.AddTrainData(rans, wgt*wgt);
+        }
+        foam.Adapt();
+    }
+}
+
+class FoamUnitMapper : public achilles::Mapper<double> {
+    public:
+        void GeneratePoint(std::vector<double> &point, const std::vector<double> &rans) override {
+            point = rans;
+        }
+        double GenerateWeight(const std::vector<double> &point, std::vector<double> &rans) override {
+            rans = point;
+            return 1.0;
+        }
+        size_t NDims() const override { return 2; }
+        YAML::Node ToYAML() const override { return YAML::Node(); }
+};
+
+TEST_CASE("Foam mapping", "[foam]") {
+    achilles::FoamParams params;
+    params.objective = GENERATE(achilles::FoamObjective::Variance, achilles::FoamObjective::MaxWeight);
+    achilles::Foam foam(2, params);
+    TrainFoam(foam, 10, 10000);
+    REQUIRE(foam.NCells() > 1);
+
+    SECTION("The jacobian matches the density at the point") {
+        std::vector<double> rans(2);
+        for(size_t i = 0; i < 100; ++i) {
+            achilles::Random::Instance().Generate(rans);
+            const double jac = foam(rans);
+            CHECK(rans[0] >= 0);
+            CHECK(rans[0] <= 1);
+            CHECK(foam.GenerateWeight(rans) == Approx(jac));
+        }
+
+        double probability = 0, volume = 0;
+        for(size_t i = 0; i < foam.NCells(); ++i) {
+            probability += foam.Cell(i).probability;
+            volume += foam.Cell(i).Volume();
+        }
+        CHECK(probability == Approx(1));
+        CHECK(volume == Approx(1));
+    }
+
+    SECTION("The integral is unchanged") {
+        static constexpr size_t npoints = 100000;
+        static constexpr double expected = 0.02*2.5066282746310002*(1 - 0.02*0.7978845608028654);
+        std::vector<double> rans(2);
+        achilles::StatsData result;
+        for(size_t i = 0; i < npoints; ++i) {
+            achilles::Random::Instance().Generate(rans);
+            const double jac = foam(rans);
+            result += test_func_ridge(rans, jac);
+        }
+        CHECK(std::abs(result.Mean() - expected) < nsigma*result.Error());
+    }
+}
+
+TEST_CASE("Foam reduces the maximum weight", "[foam]") {
+    static constexpr size_t npoints = 100000;
+    achilles::FoamParams params;
+    params.objective = achilles::FoamObjective::MaxWeight;
+    params.max_cells = 200;
+    achilles::Foam foam(2, params);
+    TrainFoam(foam, 20, 10000);
+
+    achilles::AdaptiveMap map(2, 50);
+    achilles::Vegas vegas(map, achilles::VegasParams{10000, 20, 1e-2, 1e-2, 1.5, 10});
+    vegas.Optimize(test_func_ridge);
+    const auto grid = vegas.Grid();
+
+    const double foam_ratio = MaxOverMean(foam, npoints);
+    const double vegas_ratio = MaxOverMean(grid, npoints);
+    CHECK(foam_ratio < 0.5*vegas_ratio);
+    CHECK(foam.Efficiency() > 0);
+    CHECK(foam.NCells() <= params.max_cells);
+}
+
+TEST_CASE("Foam stops splitting at the target efficiency", "[foam]") {
+    achilles::FoamParams params;
+    params.efficiency = 0.1;
+    achilles::Foam foam(2, params);
+    achilles::Foam unlimited(2);
+    TrainFoam(foam, 20, 10000);
+    TrainFoam(unlimited, 20, 10000);
+
+    CHECK(foam.Efficiency() > 0.5*params.efficiency);
+    CHECK(foam.NCells() < unlimited.NCells());
+}
+
+TEST_CASE("Foam in a multi-channel integration", "[foam]") {
+    achilles::Integrand<double> integrand(test_func_ridge);
+    achilles::Channel<double> channel;
+    channel.mapping = std::make_unique<FoamUnitMapper>();
+    channel.integrator = achilles::Vegas(achilles::AdaptiveMap(2, 50), achilles::VegasParams{});
+    channel.foam = std::make_unique<achilles::Foam>(2);
+    integrand.AddChannel(std::move(channel));
+
+    static constexpr double expected = 0.02*2.5066282746310002*(1 - 0.02*0.7978845608028654);
+    achilles::MultiChannel integrator(2, 1, achilles::MultiChannelParams{10000, 10, 1e-3});
+    integrator.Optimize(integrand);
+    auto results = integrator.Summary();
+
+    CHECK(std::abs(results.sum_results.Mean() - expected) < nsigma*results.sum_results.Error());
+    CHECK(integrand.GetChannel(0).foam -> NCells() > 1);
+}
+
+TEST_CASE("YAML encoding / decoding Foam", "[foam]") {
+    achilles::FoamParams params;
+    params.objective = achilles::FoamObjective::Variance;
+    params.max_cells = 50;
+    achilles::Foam foam(2, params);
+    TrainFoam(foam, 5, 10000);
+
+    YAML::Node node;
+    node["Foam"] = foam;
+    auto foam2 = node["Foam"].as<achilles::Foam>();
+
+    CHECK(foam2.NDims() == foam.NDims());
+    CHECK(foam2.NCells() == foam.NCells());
+    CHECK(foam2.Parameters().objective == achilles::FoamObjective::Variance);
+    CHECK(foam2.Parameters().max_cells == params.max_cells);
+    CHECK(foam2.Efficiency() == Approx(foam.Efficiency()));
+    std::vector<double> rans(2);
+    for(size_t i = 0; i < 100; ++i) {
+        achilles::Random::Instance().Generate(rans);
+        CHECK(foam2.GenerateWeight(rans) == Approx(foam.GenerateWeight(rans)));
+    }
+}
@@ -0,0 +1,77 @@
+#include "catch2/catch.hpp"
+
+#include "Achilles/Constants.hh"
+#include "Achilles/FormationZone.hh"
+#include "Achilles/Particle.hh"
+
+TEST_CASE("Formation zone models are registered", "[FormationZone]") {
+    for(const auto &name : {"Default", "Constant", "QuantumDiffusion"})
+        CHECK(achilles::FormationZoneFactory::IsRegistered(name));
+
+    YAML::Node node = YAML::Load("Name: QuantumDiffusion");
+    auto model = achilles::FormationZoneFactory::Initialize("QuantumDiffusion", node);
+    CHECK(model -> GetName() == "QuantumDiffusion");
+}
+
+TEST_CASE("Default formation zone", "[FormationZone]") {
+    const achilles::FourVector initial{1000, 0, 0, 300}, final{1100, 200, 0, 600};
+    achilles::Particle expected{achilles::PID::proton(), final};
+    expected.SetFormationZone(initial, final);
+
+    achilles::DefaultFormationZone model{YAML::Node()};
+    achilles::Particle particle{achilles::PID::proton(), final};
+    model.Form(particle, initial);
+    CHECK(particle.FormationZone() == expected.FormationZone());
+    CHECK(particle.FormationTime() == expected.FormationZone());
+    CHECK(particle.InFormationZone());
+    // No interactions during the formation
+    CHECK(model.Suppression(particle) == 0);
+}
+
+TEST_CASE("Constant formation zone", "[FormationZone]") {
+    YAML::Node node = YAML::Load(R"node(
+    Tau: 1.5
+    Suppression: 0.2
+    )node");
+    achilles::ConstantFormationZone model{node};
+
+    const double mass = achilles::ParticleInfo(achilles::PID::proton()).Mass();
+    const double p = 1000, energy = sqrt(p*p + mass*mass);
+    achilles::Particle particle{achilles::PID::proton(), {energy, 0, 0, p}};
+    model.Form(particle, {mass, 0, 0, 0});
+    CHECK(particle.FormationZone() == Approx(energy/mass*1.5/achilles::Constant::HBARC));
+    CHECK(model.Suppression(particle) == 0.2);
+
+    node["Suppression"] = 2;
+    CHECK_THROWS(achilles::ConstantFormationZone(node));
+}
+
+TEST_CASE("Quantum diffusion", "[FormationZone]") {
+    static constexpr double kt2 = 350*350, deltam2 = 0.7e6;
+    achilles::QuantumDiffusion model{YAML::Node()};
+    const double mass = achilles::ParticleInfo(achilles::PID::proton()).Mass();
+
+    SECTION("The cross section grows linearly over the formation length") {
+        const achilles::FourVector initial{mass, 0, 0, 0};
+        const double p = 3000, energy = sqrt(p*p + mass*mass);
+        achilles::Particle particle{achilles::PID::proton(), {energy, 0, 0, p}};
+        model.Form(particle, initial);
+
+        const achilles::FourVector q = particle.Momentum() - initial;
+        const double scale = 9*kt2/(-q.M2());
+        CHECK(particle.FormationTime() == Approx(2*energy/deltam2));
+        CHECK(particle.FormationScale() == Approx(scale));
+        CHECK(model.Suppression(particle) == Approx(scale));
+
+        particle.UpdateFormationZone(particle.FormationTime()/2);
+        CHECK(model.Suppression(particle) == Approx((1 + scale)/2));
+    }
+
+    SECTION("No suppression at small momentum transfer") {
+        const double p = 200, energy = sqrt(p*p + mass*mass);
+        achilles::Particle particle{achilles::PID::proton(), {energy, 0, 0, p}};
+        model.Form(particle, {energy, 0, 0, p - 10});
+        CHECK(particle.FormationScale() == 1);
+        CHECK(model.Suppression(particle) == 1);
+    }
+}
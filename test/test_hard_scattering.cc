@@ -1,5 +1,7 @@
 #include "catch2/catch.hpp"
 
+#include <algorithm>
+
 #include "mock_classes.hh"
 #include "Achilles/HardScattering.hh"
 
@@ -82,3 +84,35 @@ TEST_CASE("FillEvent", "[HardScattering]") {
 }
 
 #endif
+
+TEST_CASE("LeptonicTensor", "[HardScattering]") {
+    std::vector<achilles::FourVector> momentum = {{938, 0, 0, 0}, {1000, 0, 0, 1000},
+                                                {900, 0, 0, 0}, {1038, 300, 200, 950}};
+    // Fix the outgoing lepton to be on shell
+    momentum[3].E() = momentum[3].P();
+
+    auto process = GENERATE(std::make_pair(achilles::PID::electron(), achilles::PID::electron()),
+                            std::make_pair(achilles::PID::nu_muon(), achilles::PID::nu_muon()),
+                            std::make_pair(achilles::PID::nu_muon(), achilles::PID::muon()));
+    achilles::Process_Info info;
+    info.m_ids = {process.first, process.second};
+    achilles::LeptonicCurrent current;
+    current.Initialize(info);
+
+    auto currents = current.CalcCurrents(momentum, 100);
+    auto tensors = current.CalcTensors(momentum, 100);
+    REQUIRE(tensors.size() == currents.size());
+    for(const auto &lcurrent : currents) {
+        const auto &tensor = tensors.at(lcurrent.first);
+        double scale{};
+        for(const auto &elm : tensor) scale = std::max(scale, std::abs(elm));
+        for(size_t mu = 0; mu < 4; ++mu) {
+            for(size_t nu = 0; nu < 4; ++nu) {
+                std::complex<double> expected{};
+                for(const auto &subcur : lcurrent.second) expected += subcur[mu]*std::conj(subcur[nu]);
+                CHECK(tensor[4*mu+nu].real() == Approx(expected.real()).margin(1e-8*scale));
+                CHECK(tensor[4*mu+nu].imag() == Approx(expected.imag()).margin(1e-8*scale));
+            }
+        }
+    }
+}
@@ -79,7 +79,17 @@ TEST_CASE("YAML encoding / decoding Multichannel Parameters", "[multichannel]")
     CHECK(params.nrefine == params2.nrefine);
     CHECK(params.beta == params2.beta);
     CHECK(params.min_alpha == params2.min_alpha);
+    CHECK(params.prune_threshold == params2.prune_threshold);
     CHECK(params.iteration == params2.iteration);
+
+    // Results saved before the pruning was added
+    node["Params"].remove("prune_threshold");
+    node["Params"]["NCalls"] = 5000;
+    auto params3 = node["Params"].as<achilles::MultiChannelParams>();
+    CHECK(params3.ncalls == 5000);
+    CHECK(params3.prune_threshold == achilles::MultiChannelParams::prune_threshold_default);
+    node["Params"]["extra"] = 1;
+    CHECK_THROWS(node["Params"].as<achilles::MultiChannelParams>());
 }
 
 TEST_CASE("Multi-Channel Integration", "[multichannel]") {
@@ -117,6 +127,153 @@ TEST_CASE("Multi-Channel Integration", "[multichannel]") {
         CHECK(std::abs(results.sum_results.Mean() - 1.0) < nsigma*results.sum_results.Error());
         CHECK(results.sum_results.Error()/results.sum_results.Mean() < rtol);
     }
+
+    SECTION("Sampling keeps the channels and grids fixed") {
+        achilles::MultiChannel integrator(1, integrand.NChannels(),
+                                          achilles::MultiChannelParams{1000, 2, 1e-2});
+        integrator.Optimize(integrand);
+        const auto summary = integrator.Summary();
+        const auto grid = integrand.GetChannel(0).integrator.Grid().Hist();
+
+        integrator.Parameters().ncalls = 10000;
+        for(size_t i = 0; i < 3; ++i) {
+            const auto result = integrator.Sample(integrand);
+            CHECK(result.Calls() == 10000);
+            CHECK(std::abs(result.Mean() - 1.0) < nsigma*result.Error());
+        }
+        CHECK(integrator.Summary().results.size() == summary.results.size());
+        CHECK(integrator.Summary().best_weights == summary.best_weights);
+        CHECK(integrand.GetChannel(0).integrator.Grid().Hist() == grid);
+    }
+
+    SECTION("Runs to desired precision with quasi-random points") {
+        static constexpr size_t nitn_min = 2;
+        static constexpr double rtol = 1e-3;
+        achilles::MultiChannel integrator(1, integrand.NChannels(),
+                                          achilles::MultiChannelParams{1000, nitn_min, rtol});
+        integrator.SetSampling(achilles::QuasiRandom(achilles::QuasiRandom::Type::Sobol));
+        integrator.Optimize(integrand);
+        auto results = integrator.Summary();
+
+        CHECK(std::abs(results.sum_results.Mean() - 1.0) < nsigma*results.sum_results.Error());
+        CHECK(results.sum_results.Error()/results.sum_results.Mean() < rtol);
+        CHECK(results.results.front().Calls() == 1000);
+    }
+
+    SECTION("Control variates reduce the error") {
+        // Approximation of the integrand with only the larger peak, using a wider Gaussian
+        static constexpr double width = 1.2;
+        auto approximation = [](const std::vector<double> &x, double wgt) {
+            const double sms0 = x[0] - s0;
+            return 2.0 * std::exp(-sms0 * sms0 / width) / std::sqrt(std::acos(-1.0) * width) / 3.0 * wgt;
+        };
+        static constexpr size_t ncalls = 10000;
+        achilles::MultiChannel plain(1, integrand.NChannels(), achilles::MultiChannelParams{ncalls, 1});
+        plain(integrand);
+        const auto plain_result = plain.Summary().results.back();
+
+        integrand.AddControlVariate({"Gaussian", approximation, 2.0/3.0});
+        achilles::MultiChannel integrator(1, integrand.NChannels(), achilles::MultiChannelParams{ncalls, 1});
+        integrator(integrand);
+        const auto result = integrator.Summary().results.back();
+
+        REQUIRE(integrator.ControlCoefficients().size() == 1);
+        CHECK(integrator.ControlCoefficients()[0] > 0);
+        CHECK(std::abs(result.Mean() - 1.0) < nsigma*result.Error());
+        CHECK(result.Error() < 0.8*plain_result.Error());
+        CHECK(result.Calls() == ncalls);
+    }
+
+    SECTION("Channel densities as control variates") {
+        // Mixture of the channel densities with other fractions than the channel weights, which
+        // the control variates describe, and a small peak which they do not
+        achilles::Integrand<double> mixture([](const std::vector<double> &x, double wgt) {
+            const double sms0 = x[0] - s0;
+            const double sms1 = x[0] - s1;
+            const double cauchy = (2.0/(1.0 + sms0*sms0) + 1.0/(1.0 + sms1*sms1))/std::acos(-1.0)/3.0;
+            return (0.9*cauchy + 0.1*std::exp(-sms0*sms0)/std::sqrt(std::acos(-1.0)))*wgt;
+        });
+        for(size_t i = 0; i < 2; ++i) {
+            achilles::Channel<double> channel;
+            channel.mapping = std::make_unique<DoubleMapper>(i);
+            achilles::AdaptiveMap map(channel.mapping -> NDims(), 50);
+            channel.integrator = achilles::Vegas(map, achilles::VegasParams{});
+            mixture.AddChannel(std::move(channel));
+        }
+
+        static constexpr size_t ncalls = 10000;
+        achilles::MultiChannel integrator(1, mixture.NChannels(), achilles::MultiChannelParams{ncalls, 1});
+        const auto plain_result = integrator.Sample(mixture);
+        CHECK(integrator.ControlCoefficients().empty());
+
+        mixture.SetChannelControlVariates(true);
+        REQUIRE(mixture.ControlVariateIntegrals() == std::vector<double>{1.0, 1.0});
+        const auto result = integrator.Sample(mixture);
+        CHECK(integrator.ControlCoefficients().size() == 2);
+        CHECK(std::abs(result.Mean() - 1.0) < nsigma*result.Error());
+        CHECK(result.Error() < 0.5*plain_result.Error());
+
+        // The error of quasi-random points is estimated from the replicas
+        integrator.SetSampling(achilles::QuasiRandom(achilles::QuasiRandom::Type::Sobol, 40));
+        const auto quasi_result = integrator.Sample(mixture);
+        CHECK(std::abs(quasi_result.Mean() - 1.0) < nsigma*quasi_result.Error());
+        CHECK(quasi_result.Error() < 0.5*plain_result.Error());
+        CHECK(quasi_result.Calls() == ncalls);
+    }
+}
+
+// Channel peaked far away from the function, which should be removed during training
+class FarMapper : public achilles::Mapper<double> {
+    public:
+        static constexpr double s2 = 100.0;
+        void GeneratePoint(std::vector<double> &point, const std::vector<double> &rans) override {
+            point[0] = std::tan(std::acos(-1.0) * (rans[0] - 0.5)) + s2;
+        }
+        double GenerateWeight(const std::vector<double> &point, std::vector<double> &rans) override {
+            const double sms2 = point[0] - s2;
+            rans.resize(1);
+            rans[0] = std::atan(sms2)/std::acos(-1.0) + 0.5;
+            return 1.0 / (1.0 + sms2 * sms2) / std::acos(-1.0);
+        }
+        size_t NDims() const override { return 1; }
+        YAML::Node ToYAML() const override { return YAML::Node(); }
+};
+
+TEST_CASE("Multi-Channel pruning", "[multichannel]") {
+    achilles::Integrand<double> integrand(test_func_exp);
+    for(size_t i = 0; i < 3; ++i) {
+        achilles::Channel<double> channel;
+        if(i < 2) channel.mapping = std::make_unique<DoubleMapper>(i);
+        else channel.mapping = std::make_unique<FarMapper>();
+        achilles::AdaptiveMap map(channel.mapping -> NDims(), 50);
+        channel.integrator = achilles::Vegas(map, achilles::VegasParams{});
+        integrand.AddChannel(std::move(channel));
+    }
+
+    static constexpr size_t nitn_min = 10;
+    static constexpr double rtol = 2e-2;
+    achilles::MultiChannelParams params{1000, nitn_min, rtol};
+    params.prune_threshold = 1e-2;
+    achilles::MultiChannel integrator(1, integrand.NChannels(), params);
+    integrator.Optimize(integrand);
+    auto results = integrator.Summary();
+
+    CHECK(integrator.NChannels() == 2);
+    CHECK(integrand.NChannels() == 2);
+    CHECK(integrator.ChannelIDs() == std::vector<size_t>{0, 1});
+    REQUIRE(results.pruned.size() == 1);
+    CHECK(results.pruned[0].id == 2);
+    CHECK(results.pruned[0].weight < params.prune_threshold);
+    CHECK(results.best_weights[0] + results.best_weights[1] == Approx(1.0));
+    CHECK(std::abs(results.sum_results.Mean() - 1.0) < nsigma*results.sum_results.Error());
+
+    YAML::Node node;
+    node["Summary"] = results;
+    auto results2 = node["Summary"].as<achilles::MultiChannelSummary>();
+    CHECK(results2.channel_ids == results.channel_ids);
+    REQUIRE(results2.pruned.size() == 1);
+    CHECK(results2.pruned[0].id == results.pruned[0].id);
+    CHECK(results2.pruned[0].iteration == results.pruned[0].iteration);
 }
 
 TEST_CASE("YAML encoding / decoding Multichannel", "[multichannel]") {
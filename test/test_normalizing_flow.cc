@@ -0,0 +1,124 @@
+#include "catch2/catch.hpp"
+#include "Achilles/FlowMapper.hh"
+#include "Achilles/MultiChannel.hh"
+#include "Achilles/NormalizingFlow.hh"
+#include "catch_utils.hh"
+
+// Narrow gaussian along the diagonal of the unit square, which can not be factorized
+double test_func_diagonal(const std::vector<double> &x, double wgt) {
+    static constexpr double width = 0.05;
+    const double diff = (x[0] - x[1]) / width;
+    return std::exp(-diff * diff) * wgt;
+}
+
+class UnitMapper : public achilles::Mapper<double> {
+    public:
+        void GeneratePoint(std::vector<double> &point, const std::vector<double> &rans) override {
+            point = rans;
+        }
+        double GenerateWeight(const std::vector<double> &point, std::vector<double> &rans) override {
+            rans = point;
+            return 1.0;
+        }
+        size_t NDims() const override { return 2; }
+        YAML::Node ToYAML() const override { return YAML::Node(); }
+};
+
+TEST_CASE("Normalizing flow is invertible", "[flow]") {
+    achilles::NormalizingFlow flow(3);
+    std::vector<double> point(3), point2;
+
+    // Train once so that the flow is no longer the identity
+    for(size_t i = 0; i < 100; ++i) {
+        std::vector<double> rans(3);
+        achilles::Random::Instance().Generate(rans);
+        double density = flow.Forward(rans, point);
+        flow.AddTrainData(point, density, test_func_diagonal(point, 1.0/density));
+    }
+    flow.Train();
+
+    auto rans = GENERATE(take(30, randomVector(3)));
+    double density = flow.Forward(rans, point);
+    double density2 = flow.Inverse(point, point2);
+
+    CHECK(density == Approx(density2));
+    for(size_t i = 0; i < rans.size(); ++i)
+        CHECK(point2[i] == Approx(rans[i]).margin(1e-12));
+}
+
+TEST_CASE("Normalizing flow reduces variance", "[flow]") {
+    static constexpr size_t ncalls = 2000, niterations = 10;
+    achilles::NormalizingFlow flow(2);
+
+    auto run = [&]() {
+        achilles::StatsData results;
+        std::vector<double> rans(2), point(2);
+        for(size_t i = 0; i < ncalls; ++i) {
+            achilles::Random::Instance().Generate(rans);
+            double density = flow.Forward(rans, point);
+            double val = test_func_diagonal(point, 1.0/density);
+            flow.AddTrainData(point, density, val*val);
+            results += val;
+        }
+        flow.Train();
+        return results;
+    };
+
+    auto initial = run();
+    for(size_t i = 0; i < niterations; ++i) run();
+    auto final = run();
+
+    CHECK(final.Variance() < 0.5*initial.Variance());
+    CHECK(std::abs(final.Mean() - initial.Mean()) < nsigma*(final.Error() + initial.Error()));
+}
+
+TEST_CASE("YAML encoding / decoding NormalizingFlow", "[flow]") {
+    achilles::FlowParams params{2, 8, 4, 1, 50, 0.1};
+    achilles::NormalizingFlow flow(2, params);
+    std::vector<double> rans(2), point(2);
+    for(size_t i = 0; i < 100; ++i) {
+        achilles::Random::Instance().Generate(rans);
+        double density = flow.Forward(rans, point);
+        flow.AddTrainData(point, density, test_func_diagonal(point, 1.0/density));
+    }
+    flow.Train();
+
+    YAML::Node node;
+    node["Flow"] = flow;
+    auto flow2 = node["Flow"].as<achilles::NormalizingFlow>();
+
+    CHECK(flow2.NDims() == flow.NDims());
+    CHECK(flow2.Parameters().nbins == params.nbins);
+    CHECK(flow2.Parameters().learning_rate == params.learning_rate);
+
+    std::vector<double> point2(2);
+    rans = {0.25, 0.6};
+    CHECK(flow.Forward(rans, point) == flow2.Forward(rans, point2));
+    CHECK(point == point2);
+}
+
+TEST_CASE("Multi-Channel Integration with FlowMapper", "[flow]") {
+    achilles::Integrand<double> integrand(test_func_diagonal);
+    achilles::Channel<double> channel;
+    channel.mapping = std::make_unique<achilles::FlowMapper<double>>(std::make_unique<UnitMapper>());
+    achilles::AdaptiveMap map(channel.mapping -> NDims(), 2);
+    channel.integrator = achilles::Vegas(map, achilles::VegasParams{});
+    integrand.AddChannel(std::move(channel));
+
+    static constexpr size_t nitn_min = 5;
+    static constexpr double rtol = 2e-2;
+    achilles::MultiChannel integrator(2, integrand.NChannels(),
+                                      achilles::MultiChannelParams{1000, nitn_min, rtol});
+    integrator.Optimize(integrand);
+    auto results = integrator.Summary();
+
+    // Integral of the diagonal gaussian over the unit square
+    static constexpr double width = 0.05;
+    const double expected = width*std::sqrt(M_PI)*std::erf(1/width)
+                          - width*width*(1 - std::exp(-1/(width*width)));
+    CHECK(std::abs(results.sum_results.Mean() - expected) < nsigma*results.sum_results.Error());
+
+    auto node = integrand.GetChannel(0).mapping -> ToYAML();
+    CHECK(node["Name"].as<std::string>() == "FlowMapper");
+    CHECK(node["Flow"]["NDims"].as<size_t>() == 2);
+}
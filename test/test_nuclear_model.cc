@@ -1,7 +1,10 @@
 #include "catch2/catch.hpp"
 
+#include "Achilles/Constants.hh"
+#include "Achilles/Hadronization.hh"
 #include "Achilles/NuclearModel.hh"
 #include "Achilles/Particle.hh"
+#include "Achilles/ParticleInfo.hh"
 #include "Achilles/Units.hh"
 
 #include "yaml-cpp/yaml.h"
@@ -279,6 +282,63 @@ NuclearModel:
         }
     }
 
+    SECTION("CalcTensors matches the spin summed currents") {
+        std::vector<achilles::FourVector> momentum = {{0.8334268643628409_GeV, 0.0841386014098756_GeV,
+                                                       0.35434104526508325_GeV, -0.25207280069997196_GeV},
+                                                      {4_GeV, 0, 0, 4_GeV},
+                                                      {3.9936896971024103_GeV, 0.8919304531816128_GeV,
+                                                       0.5832575462220676_GeV, 3.732825216669567_GeV},
+                                                      {0.8397371672604309_GeV, -0.8077918517717372_GeV,
+                                                       -0.22891650095698435_GeV, 0.01510198263046103_GeV}};
+        MockEvent e;
+        const MockEvent& event = e;
+        REQUIRE_CALL(event, Momentum())
+            .TIMES(AT_LEAST(10))
+            .LR_RETURN((momentum));
+
+        double Q2 = -(momentum[1] - momentum[3]).M2()/1.0_GeV/1.0_GeV;
+        achilles::FormFactor::Values value;
+        value.F1p = 1;
+        value.F1n = 1;
+        value.F2p = 1;
+        value.F2n = 1;
+        value.FA = 1;
+        REQUIRE_CALL(*form_factor, call_op(Q2))
+            .TIMES(2)
+            .LR_RETURN((value));
+
+        // Require to build here or else form_factor is moved before expectations are set in next test
+        REQUIRE_CALL(builder, build())
+            .TIMES(1)
+            .IN_SEQUENCE(seq)
+            .LR_RETURN(std::move(form_factor));
+        achilles::QESpectral model(config, ff, builder);
+        CHECK(model.HasTensors());
+
+        std::vector<achilles::NuclearModel::FFInfoMap> info_map(3);
+        info_map[0][achilles::PID::photon()] = {achilles::FormFactorInfo{achilles::FormFactorInfo::Type::F1p, 1},
+                                                achilles::FormFactorInfo{achilles::FormFactorInfo::Type::F2p, 1},
+                                                achilles::FormFactorInfo{achilles::FormFactorInfo::Type::FA, 1}};
+        info_map[1][achilles::PID::photon()] = {achilles::FormFactorInfo{achilles::FormFactorInfo::Type::F1n, 1},
+                                                achilles::FormFactorInfo{achilles::FormFactorInfo::Type::F2n, 1},
+                                                achilles::FormFactorInfo{achilles::FormFactorInfo::Type::FA, 1}};
+        auto currents = model.CalcCurrents(event, info_map);
+        auto tensors = model.CalcTensors(event, info_map);
+        REQUIRE(tensors.size() == currents.size());
+        for(size_t k = 0; k < currents.size(); ++k) {
+            const auto &current = currents[k][achilles::PID::photon()];
+            const auto &tensor = tensors[k][achilles::PID::photon()];
+            for(size_t mu = 0; mu < 4; ++mu) {
+                for(size_t nu = 0; nu < 4; ++nu) {
+                    std::complex<double> expected{};
+                    for(const auto &subcur : current) expected += subcur[mu]*std::conj(subcur[nu]);
+                    CHECK(tensor[4*mu+nu].real() == Approx(expected.real()).margin(1e-10));
+                    CHECK(tensor[4*mu+nu].imag() == Approx(expected.imag()).margin(1e-10));
+                }
+            }
+        }
+    }
+
     SECTION("Properly fill the event") {
         // Require to build here or else form_factor is moved before expectations are set in next test
         REQUIRE_CALL(builder, build())
@@ -303,3 +363,110 @@ NuclearModel:
         CHECK(event.Weight() == xsecs[0] + xsecs[1]);
     }
 }
+
+TEST_CASE("QESpectralSRC", "[NuclearModel]") {
+    YAML::Node config = YAML::Load(R"config(
+NuclearModel:
+  SpectralP: data/pke12_tot.data
+  SpectralN: data/pke12_tot.data
+  Ward: false
+  SRC:
+    MomentumCut: 300
+    PairRatio: 20
+)config");
+    YAML::Node ff = YAML::Load("vector: dummy\naxial: dummy\ncoherent: dummy\ndummy: dummy2");
+
+    auto form_factor = std::make_unique<MockFormFactor>();
+
+    MockFormFactorBuilder builder;
+    trompeloeil::sequence seq;
+    REQUIRE_CALL(builder, Vector(ff["vector"].as<std::string>(), ff["dummy"]))
+        .TIMES(1)
+        .IN_SEQUENCE(seq)
+        .LR_RETURN(std::ref(builder));
+    REQUIRE_CALL(builder, AxialVector(ff["axial"].as<std::string>(), ff["dummy"]))
+        .TIMES(1)
+        .IN_SEQUENCE(seq)
+        .LR_RETURN(std::ref(builder));
+    REQUIRE_CALL(builder, Coherent(ff["coherent"].as<std::string>(), ff["dummy"]))
+        .TIMES(1)
+        .IN_SEQUENCE(seq)
+        .LR_RETURN(std::ref(builder));
+    REQUIRE_CALL(builder, build())
+        .TIMES(1)
+        .IN_SEQUENCE(seq)
+        .LR_RETURN(std::move(form_factor));
+    achilles::QESpectral model(config, ff, builder);
+
+    CHECK(model.CorrelatedProbability(achilles::PID::proton(), 200, 20) == 0);
+    CHECK(model.CorrelatedProbability(achilles::PID::proton(), 400, 20) == 1);
+
+    const double struck_p = GENERATE(200.0, 400.0);
+    achilles::FourVector struck_mom{achilles::Constant::mN - 20, 0, 0, struck_p};
+    std::vector<achilles::Particle> nucleons{
+        {achilles::PID::proton(), struck_mom, {0, 0, 0}, achilles::ParticleStatus::initial_state},
+        {achilles::PID::proton(), {1000, 0, 0, 100}, {0, 0, 0}, achilles::ParticleStatus::propagating},
+        {achilles::PID::proton(), {}, {0.5, 0, 0}, achilles::ParticleStatus::background},
+        {achilles::PID::proton(), {}, {3, 0, 0}, achilles::ParticleStatus::background},
+        {achilles::PID::neutron(), {}, {0, 1, 0}, achilles::ParticleStatus::background},
+        {achilles::PID::neutron(), {}, {0, 4, 0}, achilles::ParticleStatus::background}};
+    auto nucleus = std::make_shared<MockNucleus>();
+    ALLOW_CALL(*nucleus, Nucleons())
+        .LR_RETURN((nucleons));
+    achilles::Event event;
+    event.CurrentNucleus() = nucleus;
+
+    model.FillCorrelations(event);
+
+    std::vector<size_t> partners;
+    for(size_t i = 2; i < nucleons.size(); ++i) {
+        if(nucleons[i].Status() == achilles::ParticleStatus::propagating) partners.push_back(i);
+    }
+    if(struck_p < 300) {
+        CHECK(partners.empty());
+    } else {
+        // The partner is the closest nucleon of its species, and recoils against the struck nucleon
+        REQUIRE(partners.size() == 1);
+        CHECK((partners[0] == 2 || partners[0] == 4));
+        const auto &partner = nucleons[partners[0]].Momentum();
+        CHECK(partner.Pz() == Approx(-struck_p));
+        CHECK(partner.M() == Approx(nucleons[partners[0]].Mass()));
+    }
+}
+
+TEST_CASE("InelasticSpectral", "[NuclearModel]") {
+    YAML::Node config = YAML::Load(R"config(
+NuclearModel:
+  SpectralP: data/pke12_tot.data
+  SpectralN: data/pke12_tot.data
+)config");
+    achilles::InelasticSpectral model(config);
+
+    // Electron scattering at 60 degrees off a nucleon at rest with a removal energy of 20 MeV
+    const double mN = achilles::Constant::mN;
+    const double W = GENERATE(achilles::Constant::mN + achilles::ParticleInfo(achilles::PID::pion0()).Mass() + 1,
+                              achilles::Hadronization::Threshold() + 1);
+    std::vector<achilles::FourVector> momentum = {{mN - 20, 0, 0, 0},
+                                                  {1000, 0, 0, 1000},
+                                                  {W, 0, 0, 0},
+                                                  {600, 0, 600*std::sqrt(3)/2, 300}};
+    MockEvent e;
+    const MockEvent& event = e;
+    ALLOW_CALL(event, Momentum())
+        .LR_RETURN((momentum));
+
+    std::vector<achilles::NuclearModel::FFInfoMap> info_map(2);
+    info_map[0][achilles::PID::photon()] = {};
+    info_map[1][achilles::PID::photon()] = {};
+    auto tensors = model.CalcTensors(event, info_map);
+    REQUIRE(tensors.size() == 2);
+
+    // Every hadronic system with a cross section can be hadronized, whatever its charge
+    if(W < achilles::Hadronization::Threshold()) {
+        CHECK(tensors[0].empty());
+        CHECK(tensors[1].empty());
+    } else {
+        CHECK(tensors[0].count(achilles::PID::photon()) == 1);
+        CHECK(tensors[1].count(achilles::PID::photon()) == 1);
+    }
+}
@@ -127,6 +127,56 @@ TEST_CASE("Nuclear Configuration", "[Nucleus]") {
     }
 }
 
+TEST_CASE("Resample Nuclear Configuration", "[Nucleus]") {
+    const auto fermiGas = achilles::Nucleus::FermiGasType::Global;
+    static constexpr size_t Z = 6;
+    static constexpr double kf = 250;
+
+    achilles::Particles particles;
+    for(size_t i = 0; i < Z; ++i) {
+        const auto x = static_cast<double>(i);
+        particles.emplace_back(achilles::PID::proton(), achilles::FourVector(),
+                               achilles::ThreeVector{x, 0, 0});
+        particles.emplace_back(achilles::PID::neutron(), achilles::FourVector(),
+                               achilles::ThreeVector{x, 0, 1});
+    }
+
+    auto density = std::make_unique<MockDensity>();
+    REQUIRE_CALL(*density, GetConfiguration())
+        .TIMES(3)
+        .RETURN(particles);
+
+    achilles::Nucleus nuc(Z, 2*Z, 0, kf, dFile, fermiGas, std::move(density));
+    nuc.GenerateConfig();
+
+    // Knock out a proton, and add an outgoing pion
+    auto event = nuc.Nucleons();
+    static constexpr size_t struck = 4;
+    event[struck].Status() = achilles::ParticleStatus::initial_state;
+    event[struck].SetPosition({2.1, 0, 0.1});
+    event.emplace_back(achilles::PID::pionp(), achilles::FourVector{300, 0, 0, 200},
+                       achilles::ThreeVector{2.1, 0, 0.1}, achilles::ParticleStatus::propagating);
+
+    SECTION("Struck nucleons replace the closest nucleon") {
+        nuc.ResampleConfig(event);
+        REQUIRE(nuc.Nucleons().size() == 2*Z + 1);
+        CHECK(nuc.Nucleons()[struck] == event[struck]);
+        CHECK(nuc.Nucleons().back() == event.back());
+        size_t nbackground = 0;
+        for(const auto &nucleon : nuc.Nucleons())
+            if(nucleon.Status() == achilles::ParticleStatus::background) nbackground++;
+        CHECK(nbackground == 2*Z - 1);
+        CHECK(nuc.NProtons() == Z);
+        CHECK(nuc.NNeutrons() == Z);
+    }
+
+    SECTION("Event must contain the configuration") {
+        event.resize(Z);
+        CHECK_THROWS_WITH(nuc.ResampleConfig(event),
+                          "Nucleus: Event has fewer nucleons than the nucleus");
+    }
+}
+
 TEST_CASE("Make Nucleus", "[Nucleus]") {
     const auto fermiGas = achilles::Nucleus::FermiGasType::Local;
 
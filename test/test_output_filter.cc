@@ -0,0 +1,78 @@
+#include "catch2/catch.hpp"
+
+#include "Achilles/OutputFilter.hh"
+#include "Achilles/Particle.hh"
+
+TEST_CASE("OutputFilter", "[OutputFilter]") {
+    std::vector<achilles::Particle> particles = {
+        {achilles::PID::proton(), {1000, 0, 0, 300}, {}, achilles::ParticleStatus::initial_state},
+        {achilles::PID::proton(), {1100, 0, 0, 600}, {}, achilles::ParticleStatus::final_state},
+        {achilles::PID::neutron(), {945, 0, 100, 0}, {}, achilles::ParticleStatus::escaped},
+        {achilles::PID::neutron(), {940, 0, 0, 50}, {}, achilles::ParticleStatus::background},
+        {achilles::PID::proton(), {938, 0, 0, 20}, {}, achilles::ParticleStatus::captured}};
+
+    SECTION("Default filter keeps everything") {
+        achilles::OutputFilter filter;
+        CHECK(!filter.Enabled());
+        CHECK(filter(particles) == particles);
+    }
+
+    SECTION("Select by status") {
+        achilles::OutputFilter filter({achilles::ParticleStatus::final_state,
+                                       achilles::ParticleStatus::escaped}, {}, 0, 0);
+        auto result = filter(particles);
+        // Initial state particles are always kept
+        REQUIRE(result.size() == 3);
+        CHECK(result[0] == particles[0]);
+        CHECK(result[1] == particles[1]);
+        CHECK(result[2] == particles[2]);
+    }
+
+    SECTION("Select by species") {
+        achilles::OutputFilter filter({}, {achilles::PID::neutron()}, 0, 0);
+        auto result = filter(particles);
+        REQUIRE(result.size() == 3);
+        CHECK(result[1] == particles[2]);
+        CHECK(result[2] == particles[3]);
+    }
+
+    SECTION("Select by kinematics") {
+        achilles::OutputFilter momentum({}, {}, 75, 0);
+        CHECK(momentum(particles).size() == 3);
+        achilles::OutputFilter kinetic({}, {}, 0, 100);
+        auto result = kinetic(particles);
+        REQUIRE(result.size() == 2);
+        CHECK(result[1] == particles[1]);
+    }
+
+    SECTION("Negative thresholds are invalid") {
+        CHECK_THROWS_WITH(achilles::OutputFilter({}, {}, -1, 0),
+                          "OutputFilter: Kinematic thresholds must be non-negative");
+    }
+}
+
+TEST_CASE("OutputFilter from YAML", "[OutputFilter]") {
+    SECTION("Valid filter") {
+        auto node = YAML::Load(R"node(
+Status: [final_state, escaped]
+PIDs: [2212]
+MinMomentum: 100
+)node");
+        auto filter = node.as<achilles::OutputFilter>();
+        CHECK(filter.Enabled());
+        achilles::Particle fast{achilles::PID::proton(), {1100, 0, 0, 600}, {}, achilles::ParticleStatus::final_state};
+        achilles::Particle slow{achilles::PID::proton(), {940, 0, 0, 50}, {}, achilles::ParticleStatus::escaped};
+        achilles::Particle neutron{achilles::PID::neutron(), {1100, 0, 0, 600}, {}, achilles::ParticleStatus::final_state};
+        CHECK(filter.Keep(fast));
+        CHECK(!filter.Keep(slow));
+        CHECK(!filter.Keep(neutron));
+    }
+
+    SECTION("Invalid status") {
+        auto node = YAML::Load("Status: [decayed]");
+        CHECK_THROWS_WITH(node.as<achilles::OutputFilter>(), "OutputFilter: Invalid particle status decayed");
+        // The spectators are part of the remnant when the events are written
+        node = YAML::Load("Status: [background]");
+        CHECK_THROWS_WITH(node.as<achilles::OutputFilter>(), "OutputFilter: Invalid particle status background");
+    }
+}
@@ -0,0 +1,68 @@
+#include "catch2/catch.hpp"
+
+#include "Achilles/Constants.hh"
+#include "Achilles/FourVector.hh"
+#include "Achilles/PhaseSpaceBias.hh"
+
+using achilles::PhaseSpaceBias;
+
+TEST_CASE("Phase space bias variables", "[bias]") {
+    const achilles::FourVector lep_in{1000, 0, 0, 1000}, lep_out{600, 300*std::sqrt(3), 0, 300};
+
+    CHECK(PhaseSpaceBias::Evaluate(PhaseSpaceBias::Variable::Q2, lep_in, lep_out)
+          == Approx(6e5));
+    CHECK(PhaseSpaceBias::Evaluate(PhaseSpaceBias::Variable::Omega, lep_in, lep_out)
+          == Approx(400));
+    CHECK(PhaseSpaceBias::Evaluate(PhaseSpaceBias::Variable::ThetaLepton, lep_in, lep_out)
+          == Approx(M_PI/3));
+    const double W2 = achilles::Constant::mN2 + 2*achilles::Constant::mN*400 - 6e5;
+    CHECK(PhaseSpaceBias::Evaluate(PhaseSpaceBias::Variable::W, lep_in, lep_out)
+          == Approx(std::sqrt(W2)));
+}
+
+TEST_CASE("Phase space bias function", "[bias]") {
+    const achilles::FourVector lep_in{1000, 0, 0, 1000}, lep_out{600, 300*std::sqrt(3), 0, 300};
+
+    SECTION("Disabled by default") {
+        PhaseSpaceBias bias;
+        CHECK_FALSE(bias.Enabled());
+        CHECK(bias(lep_in, lep_out) == 1);
+    }
+
+    SECTION("Product of terms") {
+        PhaseSpaceBias bias({{PhaseSpaceBias::Variable::Q2, PhaseSpaceBias::Form::Power, 2e5, 2},
+                             {PhaseSpaceBias::Variable::ThetaLepton, PhaseSpaceBias::Form::Exponential,
+                              M_PI, 3}});
+        CHECK(bias.Enabled());
+        CHECK(bias(lep_in, lep_out) == Approx(16*std::exp(1)));
+    }
+
+    SECTION("Invalid scale") {
+        CHECK_THROWS_WITH(PhaseSpaceBias({{PhaseSpaceBias::Variable::W, PhaseSpaceBias::Form::Power, 0, 1}}),
+                          "PhaseSpaceBias: Scale must be positive");
+    }
+}
+
+TEST_CASE("Phase space bias YAML", "[bias]") {
+    YAML::Node node = YAML::Load(R"node(
+    - Variable: Q2
+      Scale: 1e5
+      Exponent: 1.5
+    - Variable: Omega
+      Form: Exponential
+      Scale: 100
+    )node");
+
+    auto bias = node.as<PhaseSpaceBias>();
+    REQUIRE(bias.Terms().size() == 2);
+    CHECK(bias.Terms()[0].variable == PhaseSpaceBias::Variable::Q2);
+    CHECK(bias.Terms()[0].form == PhaseSpaceBias::Form::Power);
+    CHECK(bias.Terms()[0].scale == 1e5);
+    CHECK(bias.Terms()[0].exponent == 1.5);
+    CHECK(bias.Terms()[1].variable == PhaseSpaceBias::Variable::Omega);
+    CHECK(bias.Terms()[1].form == PhaseSpaceBias::Form::Exponential);
+    CHECK(bias.Terms()[1].exponent == 1);
+
+    node[0]["Variable"] = "Qsquared";
+    CHECK_THROWS(node.as<PhaseSpaceBias>());
+}
@@ -0,0 +1,141 @@
+#include "catch2/catch.hpp"
+
+#include "Achilles/Constants.hh"
+#include "Achilles/Event.hh"
+#include "Achilles/FourVector.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/RadiativeCorrections.hh"
+#include "Achilles/Random.hh"
+
+using achilles::RadiativeCorrections;
+
+TEST_CASE("Radiative correction factors", "[radiative]") {
+    const double Q2 = 1e5;
+    const double L = std::log(Q2/(achilles::Constant::me*achilles::Constant::me));
+    const double api = achilles::Constant::ALPHA0/M_PI;
+
+    CHECK(RadiativeCorrections::Beta(Q2) == Approx(api*(L - 1)));
+    CHECK(RadiativeCorrections::VirtualFactor(Q2) == Approx(1 + api*(13.0/6.0*L - 28.0/9.0)));
+    CHECK(RadiativeCorrections::Radiator(0) == 1);
+    CHECK(RadiativeCorrections::Radiator(1) == Approx(0.75));
+
+    // Below the electron mass scale no correction is applied
+    CHECK(RadiativeCorrections::Beta(0) == 0);
+    CHECK(RadiativeCorrections::VirtualFactor(0) == 1);
+}
+
+TEST_CASE("Radiative corrections reference values", "[radiative]") {
+    // Reference values at Q^2 = 1 GeV^2 with alpha = 1/137.035999084 and me = 0.51099895 MeV,
+    // evaluated independently to the quoted digits and checked to a relative tolerance of 1e-6
+    const double Q2 = 1e6;
+
+    // Vertex and vacuum polarization correction of Mo and Tsai, Rev. Mod. Phys. 41, 205 (1969),
+    // 1 + delta = 1 + 2 alpha/pi (13/12 ln(Q^2/me^2) - 14/9)
+    CHECK(RadiativeCorrections::VirtualFactor(Q2) == Approx(1.0690617013).epsilon(1e-6));
+    CHECK(RadiativeCorrections::Beta(Q2) == Approx(0.0328871424).epsilon(1e-6));
+
+    // Probability for the photon to carry less than half of the energy of a 1 GeV beam, from a
+    // quadrature of beta y^(beta-1) (1 - y + 3/4 y^2) over 0 < y < 1/2. The weights of the flux
+    // are integrated with the midpoint rule in the random number, which is exact to ~1e-8 here
+    RadiativeCorrections corrections(true, false, false);
+    auto flux = corrections.MakeISRFlux(1000);
+    constexpr size_t npoints = 10000;
+    double sum = 0;
+    for(size_t i = 0; i < npoints; ++i) {
+        std::vector<double> rans{(static_cast<double>(i) + 0.5)/npoints};
+        auto beam = flux -> Flux(rans, 500);
+        sum += flux -> GenerateWeight(beam, rans, 500);
+    }
+    CHECK(sum/npoints == Approx(0.9648659490).epsilon(1e-6));
+}
+
+TEST_CASE("ISR flux", "[radiative]") {
+    RadiativeCorrections corrections(true, false, false);
+    auto flux = corrections.MakeISRFlux(1000);
+    CHECK(flux -> Type() == "ISR");
+    CHECK(flux -> NVariables() == 1);
+
+    SECTION("Generated point is recovered") {
+        const double min_energy = 100;
+        // Photon energies below ~1e-12 of the beam energy are lost in the beam energy, so the
+        // random numbers start at y = 0 or well above r^(1/beta) ~ 1e-12
+        auto ran = GENERATE(0.0, 0.7, 0.9, 0.99);
+        std::vector<double> rans{ran};
+        auto beam = flux -> Flux(rans, min_energy);
+        CHECK(beam.E() <= 1000);
+        CHECK(beam.E() >= min_energy);
+        CHECK(beam.M2() == Approx(0).margin(1e-8));
+
+        std::vector<double> rans2(1);
+        const double wgt = flux -> GenerateWeight(beam, rans2, min_energy);
+        CHECK(rans2[0] == Approx(ran).margin(1e-10));
+        CHECK(wgt > 0);
+    }
+
+    SECTION("Radiator average") {
+        // The weights average to the integral of beta*y^(beta-1)*phi(y) over [0, 1]
+        const double beta = RadiativeCorrections::Beta(1000*1000);
+        const double expected = 1 - beta/(beta+1) + 0.75*beta/(beta+2);
+        constexpr size_t ntrials = 100000;
+        double sum = 0;
+        for(size_t i = 0; i < ntrials; ++i) {
+            std::vector<double> rans{achilles::Random::Instance().Uniform(0.0, 1.0)};
+            auto beam = flux -> Flux(rans, 0);
+            sum += flux -> GenerateWeight(beam, rans, 0);
+        }
+        CHECK(sum/ntrials == Approx(expected).epsilon(1e-3));
+    }
+}
+
+TEST_CASE("Radiate photons", "[radiative]") {
+    achilles::Event event;
+    event.Weight() = 1;
+    const achilles::FourVector lep_out{600, 300*std::sqrt(3), 0, 300};
+    event.Leptons().emplace_back(achilles::PID::electron(), achilles::FourVector{950, 0, 0, 950},
+                                 achilles::ThreeVector(), achilles::ParticleStatus::initial_state);
+    event.Leptons().emplace_back(achilles::PID::electron(), lep_out,
+                                 achilles::ThreeVector(), achilles::ParticleStatus::final_state);
+
+    SECTION("Final state radiation") {
+        RadiativeCorrections corrections(false, true, false);
+        corrections.Radiate(event);
+        REQUIRE(event.Leptons().size() == 3);
+        const auto &photon = event.Leptons()[2];
+        CHECK(photon.ID() == achilles::PID::photon());
+        CHECK(photon.Status() == achilles::ParticleStatus::final_state);
+        const auto total = event.Leptons()[1].Momentum() + photon.Momentum();
+        CHECK(total.E() == Approx(lep_out.E()));
+        CHECK(total.Px() == Approx(lep_out.Px()));
+        CHECK(total.Pz() == Approx(lep_out.Pz()));
+        CHECK(event.Leptons()[1].Momentum().M2() == Approx(std::pow(event.Leptons()[1].Mass(), 2)).margin(1e-6));
+    }
+
+    SECTION("Initial state radiation") {
+        RadiativeCorrections corrections(true, false, true);
+        corrections.MakeISRFlux(1000);
+        const double Q2 = -(event.Leptons()[0].Momentum() - lep_out).M2();
+        corrections.Radiate(event);
+        REQUIRE(event.Leptons().size() == 3);
+        CHECK(event.Leptons()[0].Momentum().E() == Approx(1000));
+        CHECK(event.Leptons()[2].Momentum().E() == Approx(50));
+        CHECK(event.Leptons()[2].Momentum().Pz() == Approx(50));
+
+        const double beta = RadiativeCorrections::Beta(Q2);
+        const double beta0 = RadiativeCorrections::Beta(1000*1000);
+        const double expected = RadiativeCorrections::VirtualFactor(Q2)*beta/beta0*std::pow(0.05, beta-beta0);
+        CHECK(event.Weight() == Approx(expected));
+    }
+}
+
+TEST_CASE("Radiative corrections YAML", "[radiative]") {
+    YAML::Node node = YAML::Load(R"node(
+    ISR: false
+    Virtual: true
+    )node");
+
+    auto corrections = node.as<RadiativeCorrections>();
+    CHECK(corrections.Enabled());
+    CHECK_FALSE(corrections.ISR());
+    CHECK(corrections.FSR());
+    CHECK(corrections.Virtual());
+}
@@ -0,0 +1,124 @@
+#include "catch2/catch.hpp"
+
+#include "plugins/Sherpa/Channels.hh"
+#include "plugins/Sherpa/SherpaCache.hh"
+
+#include "fmt/format.h"
+
+#include <filesystem>
+#include <fstream>
+
+using achilles::SherpaCache;
+
+namespace {
+
+std::shared_ptr<PHASIC::ChannelNode> MakeNode(long int pid, unsigned int idx) {
+    auto node = std::make_shared<PHASIC::ChannelNode>();
+    node -> m_pid = pid;
+    node -> m_idx = idx;
+    return node;
+}
+
+bool SameTopology(const std::shared_ptr<PHASIC::ChannelNode> &lhs, const std::shared_ptr<PHASIC::ChannelNode> &rhs) {
+    if(!lhs || !rhs) return !lhs && !rhs;
+    return lhs -> m_pid == rhs -> m_pid && lhs -> m_idx == rhs -> m_idx
+        && SameTopology(lhs -> m_left, rhs -> m_left) && SameTopology(lhs -> m_right, rhs -> m_right);
+}
+
+}
+
+TEST_CASE("Sherpa cache key", "[Sherpa]") {
+    // Reference values of the 64-bit FNV-1a hash, with 0xff after every input
+    CHECK(SherpaCache::Hash({}) == 0xcbf29ce484222325ull);
+    CHECK(SherpaCache::Hash({"a"}) == 0x089bc907b544c769ull);
+    CHECK(SherpaCache::Hash({"ab", "c"}) != SherpaCache::Hash({"a", "bc"}));
+    CHECK(SherpaCache::Hash({"a", ""}) != SherpaCache::Hash({"a"}));
+
+    const std::vector<std::string> inputs{"SM", "card", "11,2212,11", "EVENTS=0"};
+    // The version of the cache is the first input
+    CHECK(SherpaCache("cache", {"a"}).Key() == 0x41e96fed1fa6c315ull);
+
+    SherpaCache cache("cache", inputs);
+    std::vector<std::string> versioned{"1"};
+    versioned.insert(versioned.end(), inputs.begin(), inputs.end());
+    CHECK(cache.Key() == SherpaCache::Hash(versioned));
+    CHECK(cache.Filename() == fmt::format("cache/achilles_process_{:016x}.yml", cache.Key()));
+    CHECK(SherpaCache("cache", inputs).Filename() == cache.Filename());
+
+    // Changing the model, parameter card, process ids or arguments selects a different file
+    for(size_t i = 0; i < inputs.size(); ++i) {
+        auto changed = inputs;
+        changed[i] += "x";
+        CHECK(SherpaCache("cache", changed).Filename() != cache.Filename());
+    }
+    auto extra = inputs;
+    extra.push_back("OUTPUT=2");
+    CHECK(SherpaCache("cache", extra).Filename() != cache.Filename());
+}
+
+TEST_CASE("Sherpa cache files", "[Sherpa]") {
+    const std::string directory = (std::filesystem::temp_directory_path() / "achilles_sherpa_cache").string();
+    std::filesystem::remove_all(directory);
+    const std::vector<std::string> inputs{"SM", "card", "11,2212,11", "EVENTS=0"};
+
+    SherpaCache cache(directory, inputs);
+    cache.momentum_map = {{1, 11}, {2, 2212}, {4, 11}, {8, 2212}};
+    cache.masses = {0, 938.272};
+    auto topology = MakeNode(0, 15);
+    topology -> m_left = MakeNode(23, 12);
+    topology -> m_left -> m_left = MakeNode(11, 4);
+    topology -> m_left -> m_right = MakeNode(2212, 8);
+    topology -> m_right = MakeNode(11, 1);
+    cache.topologies = {topology, MakeNode(22, 3)};
+
+    SECTION("Missing cache") {
+        SherpaCache missing(directory, inputs);
+        CHECK_FALSE(missing.Load());
+    }
+
+    SECTION("Save and load") {
+        cache.Save();
+        REQUIRE(std::filesystem::exists(cache.Filename()));
+
+        SherpaCache loaded(directory, inputs);
+        REQUIRE(loaded.Load());
+        CHECK(loaded.momentum_map == cache.momentum_map);
+        CHECK(loaded.masses == cache.masses);
+        REQUIRE(loaded.topologies.size() == 2);
+        CHECK(SameTopology(loaded.topologies[0], cache.topologies[0]));
+        CHECK(SameTopology(loaded.topologies[1], cache.topologies[1]));
+
+        // Other inputs use another file
+        auto changed = inputs;
+        changed[1] = "other card";
+        CHECK_FALSE(SherpaCache(directory, changed).Load());
+    }
+
+    SECTION("Mismatched inputs are rejected") {
+        // A cache stored under the name of another set of inputs, as for a hash collision
+        auto changed = inputs;
+        changed[2] = "11,1000060120,11";
+        SherpaCache other(directory, changed);
+        cache.Save();
+        std::filesystem::copy_file(cache.Filename(), other.Filename());
+        CHECK_FALSE(other.Load());
+        CHECK(other.momentum_map.empty());
+        CHECK(other.topologies.empty());
+    }
+
+    SECTION("Unreadable files are rejected") {
+        std::filesystem::create_directories(directory);
+        std::ofstream out(cache.Filename());
+        out << "Inputs: [";
+        out.close();
+        CHECK_FALSE(SherpaCache(directory, inputs).Load());
+    }
+
+    SECTION("File contents") {
+        cache.Save();
+        CHECK(SherpaCache::FileContents(cache.Filename()).find("MomentumMap") != std::string::npos);
+        CHECK_THROWS(SherpaCache::FileContents(directory + "/missing.dat"));
+    }
+
+    std::filesystem::remove_all(directory);
+}
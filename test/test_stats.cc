@@ -1,5 +1,7 @@
 #include "catch2/catch.hpp"
 
+#include "Achilles/ControlVariate.hh"
+#include "Achilles/Random.hh"
 #include "Achilles/Statistics.hh"
 
 #include "catch_utils.hh"
@@ -54,6 +56,129 @@ TEST_CASE("Statistics class", "[vegas]") {
     }
 }
 
+TEST_CASE("Statistics with negative weights", "[vegas]") {
+    achilles::StatsData data1, data2;
+    auto vals = GENERATE(take(100, randomVector(100, -1, 1)));
+    double pos = 0, neg = 0;
+    size_t nneg = 0;
+    bool odd = true;
+    for(const auto &val : vals) {
+        if(odd) data1 += val;
+        else data2 += val;
+        odd = !odd;
+        if(val < 0) {
+            neg += val;
+            nneg++;
+        } else {
+            pos += val;
+        }
+    }
+    const auto nvals = static_cast<double>(vals.size());
+
+    achilles::StatsData data = data1 + data2;
+    CHECK(data.NegativeCalls() == nneg);
+    CHECK(data.PositiveCalls() == vals.size() - nneg);
+    CHECK(data.PositiveMean() == Approx(pos/nvals));
+    CHECK(data.NegativeMean() == Approx(neg/nvals));
+    CHECK(data.PositiveMean() + data.NegativeMean() == Approx(data.Mean()));
+    CHECK(data.NegativeFraction() == Approx(-neg/(pos - neg)));
+    CHECK(data.Max() == *std::max_element(vals.begin(), vals.end()));
+}
+
+TEST_CASE("Replacing the estimate of StatsData", "[vegas]") {
+    achilles::StatsData data;
+    for(const auto &val : {1.0, 2.0, 3.0, 4.0}) data += val;
+
+    data.SetError(0.1);
+    CHECK(data.Mean() == Approx(2.5));
+    CHECK(data.Error() == Approx(0.1));
+    data.SetMean(3.0);
+    CHECK(data.Mean() == Approx(3.0));
+    CHECK(data.Error() == Approx(0.1));
+    CHECK(data.Calls() == 4);
+}
+
+TEST_CASE("Control variate estimator", "[vegas]") {
+    static constexpr size_t npoints = 10000;
+
+    SECTION("Exact control variate removes the variance") {
+        achilles::ControlVariateEstimator estimator({1.0/3.0});
+        achilles::StatsData plain;
+        for(size_t i = 0; i < npoints; ++i) {
+            const double x = achilles::Random::Instance().Uniform(0.0, 1.0);
+            plain += 2*x*x + 1;
+            estimator.Add(2*x*x + 1, {x*x});
+        }
+        estimator.Solve();
+        REQUIRE(estimator.Coefficients().size() == 1);
+        CHECK(estimator.Coefficients()[0] == Approx(2.0));
+        CHECK(estimator.Mean() == Approx(5.0/3.0));
+        // Up to the rounding of the accumulated co-moments
+        CHECK(estimator.Error() < 1e-6*plain.Error());
+    }
+
+    SECTION("Approximate control variate reduces the error") {
+        achilles::ControlVariateEstimator estimator({0.5, 1.0/3.0});
+        achilles::StatsData plain;
+        for(size_t i = 0; i < npoints; ++i) {
+            const double x = achilles::Random::Instance().Uniform(0.0, 1.0);
+            const double value = std::exp(x);
+            plain += value;
+            estimator.Add(value, {x, x*x});
+        }
+        estimator.Solve();
+        CHECK(std::abs(estimator.Mean() - (std::exp(1.0) - 1)) < nsigma*estimator.Error());
+        CHECK(estimator.Error() < 0.02*plain.Error());
+    }
+
+    SECTION("Control variates without variance are ignored") {
+        achilles::ControlVariateEstimator estimator({1.0, 0.5, 1.0});
+        achilles::StatsData plain;
+        for(size_t i = 0; i < npoints; ++i) {
+            const double x = achilles::Random::Instance().Uniform(0.0, 1.0);
+            plain += x;
+            // The last control variate duplicates the first one
+            estimator.Add(x, {1.0, x, 1.0});
+        }
+        estimator.Solve();
+        CHECK(estimator.Coefficients()[0] == 0);
+        CHECK(estimator.Coefficients()[1] == Approx(1.0));
+        CHECK(estimator.Coefficients()[2] == 0);
+        CHECK(estimator.Mean() == Approx(0.5));
+    }
+
+    SECTION("Large offsets do not spoil the covariances") {
+        achilles::ControlVariateEstimator estimator({0.5});
+        for(size_t i = 0; i < npoints; ++i) {
+            const double x = achilles::Random::Instance().Uniform(0.0, 1.0);
+            estimator.Add(1e8 + x, {x});
+        }
+        estimator.Solve();
+        CHECK(estimator.Coefficients()[0] == Approx(1.0));
+        CHECK(estimator.Mean() == Approx(1e8 + 0.5));
+        CHECK(estimator.Error() < 1e-6);
+    }
+
+    SECTION("Blocks estimate the error from the spread of their means") {
+        static constexpr size_t nblocks = 20;
+        achilles::ControlVariateEstimator estimator({0.5});
+        for(size_t i = 0; i < npoints; ++i) {
+            if(i % (npoints/nblocks) == 0) estimator.NewBlock();
+            const double x = achilles::Random::Instance().Uniform(0.0, 1.0);
+            estimator.Add(std::exp(x), {x});
+        }
+        estimator.Solve();
+        CHECK(estimator.NBlocks() == nblocks);
+        CHECK(estimator.NPoints() == npoints);
+        CHECK(estimator.BlockError() == Approx(estimator.Error()).epsilon(0.5));
+    }
+
+    SECTION("Requires the values of all control variates") {
+        achilles::ControlVariateEstimator estimator({1.0});
+        CHECK_THROWS_WITH(estimator.Add(1.0, {}), "ControlVariateEstimator: Wrong number of control variates");
+    }
+}
+
 TEST_CASE("YAML encoding / decoding StatsData", "[vegas]") {
     achilles::StatsData data1, data2;
     auto vals = GENERATE(take(100, randomVector(100)));
@@ -71,4 +196,6 @@ TEST_CASE("YAML encoding / decoding StatsData", "[vegas]") {
     CHECK(data1.Mean() == data2.Mean());
     CHECK(data1.Error() == data2.Error());
     CHECK(data1.FiniteCalls() == data2.FiniteCalls());
+    CHECK(data1.NegativeCalls() == data2.NegativeCalls());
+    CHECK(data1.NegativeMean() == data2.NegativeMean());
 }
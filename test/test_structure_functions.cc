@@ -0,0 +1,161 @@
+#include "catch2/catch.hpp"
+
+#include "Achilles/Constants.hh"
+#include "Achilles/FourVector.hh"
+#include "Achilles/Hadronization.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/ParticleInfo.hh"
+#include "Achilles/StructureFunctions.hh"
+#include "Achilles/Units.hh"
+
+#include "yaml-cpp/yaml.h"
+
+using achilles::StructureFunctions;
+using achilles::operator""_GeV;
+
+namespace {
+
+// Integrate the isoscalar neutrino cross section over x and y, with a cut on the
+// hadronic invariant mass at the single pion threshold
+double InclusiveCrossSection(const StructureFunctions &sf, int boson, double energy) {
+    static constexpr size_t nbins = 200;
+    const double mN = achilles::Constant::mN;
+    const double Wmin = mN + achilles::ParticleInfo(achilles::PID::pion0()).Mass();
+    const double sign = boson == -24 ? 1 : -1;
+    double sum = 0;
+    for(size_t i = 0; i < nbins; ++i) {
+        const double x = (i + 0.5)/nbins;
+        for(size_t j = 0; j < nbins; ++j) {
+            const double y = (j + 0.5)/nbins;
+            const double Q2 = 2*mN*energy*x*y;
+            const double W2 = mN*mN + Q2*(1 - x)/x;
+            if(W2 < Wmin*Wmin) continue;
+            auto proton = sf(achilles::PID::proton(), boson, x, Q2);
+            auto neutron = sf(achilles::PID::neutron(), boson, x, Q2);
+            const double F1 = (proton.F1 + neutron.F1)/2;
+            const double F2 = (proton.F2 + neutron.F2)/2;
+            const double F3 = (proton.F3 + neutron.F3)/2;
+            sum += y*y*x*F1 + (1 - y - mN*x*y/(2*energy))*F2 + sign*y*(1 - y/2)*x*F3;
+        }
+    }
+    const double GF = achilles::Constant::GF;
+    // Convert from mb/MeV to 10^-38 cm^2/GeV
+    return GF*GF*mN/M_PI*sum/nbins/nbins*achilles::Constant::HBARC2*1e14;
+}
+
+}
+
+TEST_CASE("Structure functions", "[StructureFunctions]") {
+    StructureFunctions sf;
+
+    SECTION("Valence sum rules") {
+        // Integrate with x = t^2 to handle the integrable singularity at x = 0
+        static constexpr size_t nbins = 100000;
+        double up = 0, down = 0;
+        for(size_t i = 0; i < nbins; ++i) {
+            const double t = (i + 0.5)/nbins;
+            up += 2*t*sf.UValence(t*t)/nbins;
+            down += 2*t*sf.DValence(t*t)/nbins;
+        }
+        CHECK(up == Approx(2).epsilon(1e-3));
+        CHECK(down == Approx(1).epsilon(1e-3));
+    }
+
+    SECTION("Isospin symmetry") {
+        const double Q2 = 10.0_GeV*1.0_GeV;
+        auto proton = sf(achilles::PID::proton(), -24, 0.3, Q2);
+        auto neutron = sf(achilles::PID::neutron(), 24, 0.3, Q2);
+        CHECK(proton.F2 == Approx(neutron.F2));
+        // The strange sea only contributes to xF3 for neutrinos
+        CHECK(proton.F3 > neutron.F3);
+    }
+
+    SECTION("Vanishes at the real photon point") {
+        auto result = sf(achilles::PID::proton(), 22, 0.1, 0);
+        CHECK(result.F1 == 0);
+        CHECK(result.F2 == 0);
+        CHECK(result.F3 == 0);
+        CHECK(sf(achilles::PID::proton(), 22, 0.1, 1e-3).F2 == Approx(0).margin(1e-6));
+    }
+
+    SECTION("Matches the measured inclusive neutrino cross sections") {
+        // PDG world averages of sigma/E at 100 GeV in units of 10^-38 cm^2/GeV
+        CHECK(InclusiveCrossSection(sf, -24, 100.0_GeV) == Approx(0.677).epsilon(0.05));
+        CHECK(InclusiveCrossSection(sf, 24, 100.0_GeV) == Approx(0.334).epsilon(0.05));
+    }
+
+    SECTION("Invalid inputs") {
+        CHECK_THROWS_AS(sf(achilles::PID::electron(), 22, 0.1, 1e6), std::runtime_error);
+        CHECK_THROWS_AS(sf(achilles::PID::proton(), 23, 0.1, 1e6), std::runtime_error);
+        StructureFunctions::Parameters params;
+        params.alpha_valence = 0;
+        CHECK_THROWS_AS(StructureFunctions(params), std::runtime_error);
+    }
+
+    SECTION("YAML parameters") {
+        YAML::Node node = YAML::Load("SeaMomentum: 0.1\nR: 0.2");
+        StructureFunctions custom(node);
+        CHECK(custom.Params().sea_momentum == 0.1);
+        CHECK(custom.Params().R == 0.2);
+        CHECK(custom.Params().beta_u == sf.Params().beta_u);
+    }
+}
+
+TEST_CASE("Hadronization", "[StructureFunctions]") {
+    const achilles::FourVector momentum{2500, 300, -200, 1500};
+    const achilles::ThreeVector position{1, 2, 3};
+
+    SECTION("Phase space decay conserves momentum") {
+        std::vector<double> masses{achilles::Constant::mp, 139.57, 134.98, 139.57};
+        auto momenta = achilles::Hadronization::PhaseSpaceDecay(momentum, masses);
+        REQUIRE(momenta.size() == masses.size());
+        achilles::FourVector total;
+        for(size_t i = 0; i < momenta.size(); ++i) {
+            CHECK(momenta[i].M() == Approx(masses[i]).epsilon(1e-6));
+            total += momenta[i];
+        }
+        CHECK(total.E() == Approx(momentum.E()));
+        CHECK(total.Px() == Approx(momentum.Px()));
+        CHECK(total.Py() == Approx(momentum.Py()));
+        CHECK(total.Pz() == Approx(momentum.Pz()));
+    }
+
+    SECTION("Hadronization conserves charge and momentum") {
+        achilles::Hadronization hadronization;
+        auto charge = GENERATE(-1, 0, 1, 2);
+        auto hadrons = hadronization(momentum, charge, position);
+        REQUIRE(hadrons.size() >= 2);
+        CHECK((hadrons[0].ID() == achilles::PID::proton() || hadrons[0].ID() == achilles::PID::neutron()));
+        int total_charge = 0;
+        achilles::FourVector total;
+        for(const auto &hadron : hadrons) {
+            CHECK(hadron.Status() == achilles::ParticleStatus::propagating);
+            CHECK(hadron.Position() == position);
+            total_charge += hadron.Info().IntCharge()/3;
+            total += hadron.Momentum();
+        }
+        CHECK(total_charge == charge);
+        CHECK(total.E() == Approx(momentum.E()));
+        CHECK(total.Pz() == Approx(momentum.Pz()));
+    }
+
+    SECTION("Below threshold") {
+        achilles::Hadronization hadronization;
+        achilles::FourVector low{1000, 0, 0, 0};
+        CHECK_THROWS_AS(hadronization(low, 1, position), std::runtime_error);
+    }
+
+    SECTION("Any charge is hadronized above the threshold") {
+        achilles::Hadronization hadronization;
+        auto charge = GENERATE(-1, 0, 1, 2);
+        const double threshold = achilles::Hadronization::Threshold();
+        CHECK(hadronization({threshold + 1e-3, 0, 0, 0}, charge, position).size() == 2);
+        CHECK_THROWS_AS(hadronization({threshold - 1e-3, 0, 0, 0}, charge, position), std::runtime_error);
+    }
+
+    SECTION("Multiplicity") {
+        achilles::Hadronization hadronization(0.4, 1.4);
+        CHECK(hadronization.AverageMultiplicity(1.2_GeV) == 1);
+        CHECK(hadronization.AverageMultiplicity(10.0_GeV) == Approx(0.4 + 1.4*std::log(100)));
+    }
+}
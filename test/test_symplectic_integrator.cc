@@ -6,8 +6,10 @@
 #include "spdlog/spdlog.h"
 #include "Achilles/Potential.hh"
 
-#include <fstream>
+#include <algorithm>
 #include <complex>
+#include <fstream>
+#include <numeric>
 
 double Rho(double r) {
     static constexpr double a = 0.09320982;
@@ -177,3 +179,90 @@ TEMPLATE_TEST_CASE("Symplectic Integrator", "[Symplectic]", achilles::CooperPote
         out.close();
     }
 }
+
+namespace {
+
+// Particle in an attractive scalar field, which gives a non-separable Hamiltonian
+constexpr double scalar_depth = 300;
+constexpr double scalar_radius = 2.5;
+
+double EffectiveMass(const achilles::ThreeVector &q) {
+    return achilles::Constant::mN - scalar_depth*exp(-q.P2()/pow(scalar_radius, 2));
+}
+
+double ScalarHamiltonian(const achilles::ThreeVector &q, const achilles::ThreeVector &p) {
+    return sqrt(p.P2() + pow(EffectiveMass(q), 2));
+}
+
+achilles::ThreeVector dScalar_dr(const achilles::ThreeVector &q, const achilles::ThreeVector &p,
+                                 std::shared_ptr<achilles::Potential>) {
+    const double dmass = 2*scalar_depth/pow(scalar_radius, 2)*exp(-q.P2()/pow(scalar_radius, 2));
+    return EffectiveMass(q)*dmass/ScalarHamiltonian(q, p)*q;
+}
+
+achilles::ThreeVector dScalar_dp(const achilles::ThreeVector &q, const achilles::ThreeVector &p,
+                                 std::shared_ptr<achilles::Potential>) {
+    return p/ScalarHamiltonian(q, p);
+}
+
+// Maximum energy violation over a fixed propagation time
+template<size_t order=0>
+double EnergyViolation(achilles::SymplecticIntegrator::Scheme scheme, double step_size) {
+    constexpr double time = 50;
+    constexpr double omega = 20;
+    const achilles::ThreeVector q{1, 0, 0}, p{0, 200, 50};
+    achilles::SymplecticIntegrator si(q, p, nullptr, dScalar_dr, dScalar_dp, omega, scheme);
+    const double E0 = ScalarHamiltonian(q, p);
+    const auto nsteps = static_cast<size_t>(std::round(time/step_size));
+    double violation = 0;
+    for(size_t i = 0; i < nsteps; ++i) {
+        if constexpr(order == 0) si.Step(step_size);
+        else si.Step<order>(step_size);
+        violation = std::max(violation, std::abs(ScalarHamiltonian(si.Q(), si.P()) - E0));
+    }
+    return violation;
+}
+
+}
+
+TEST_CASE("Symplectic Integrator Schemes", "[Symplectic]") {
+    using Scheme = achilles::SymplecticIntegrator::Scheme;
+
+    SECTION("Stages are consistent") {
+        auto scheme = GENERATE(Scheme::Order2, Scheme::ForestRuth, Scheme::Suzuki, Scheme::Yoshida6);
+        const auto &stages = achilles::SymplecticIntegrator::Stages(scheme);
+        CHECK(std::accumulate(stages.begin(), stages.end(), 0.0) == Approx(1));
+        CHECK(std::equal(stages.begin(), stages.end(), stages.rbegin()));
+    }
+
+    SECTION("Energy violation scales with the order") {
+        auto scheme = GENERATE(Scheme::Order2, Scheme::ForestRuth, Scheme::Suzuki, Scheme::Yoshida6);
+        const double ratio = EnergyViolation(scheme, 0.01)/EnergyViolation(scheme, 0.005);
+        const double expected = pow(2, achilles::SymplecticIntegrator::Order(scheme));
+        CHECK(ratio > expected/2);
+        CHECK(ratio < expected*2);
+    }
+
+    SECTION("Triple jump composition is fourth order") {
+        const double ratio = EnergyViolation<4>(Scheme::Order2, 0.01)/EnergyViolation<4>(Scheme::Order2, 0.005);
+        CHECK(ratio > 8);
+        CHECK(EnergyViolation<4>(Scheme::Order2, 0.01) == EnergyViolation(Scheme::ForestRuth, 0.01));
+    }
+
+    SECTION("Higher orders are more accurate at equal cost") {
+        // The cost of each scheme is given by the number of stages, and
+        // each comparison is made at the same or lower cost for the higher order scheme
+        const double order2 = EnergyViolation(Scheme::Order2, 0.001);
+        CHECK(EnergyViolation(Scheme::Suzuki, 0.005) < order2/10);
+        CHECK(EnergyViolation(Scheme::Yoshida6, 0.01) < order2);
+
+        // At equal accuracy the step size can be an order of magnitude larger
+        CHECK(EnergyViolation(Scheme::Suzuki, 0.01) < order2);
+    }
+
+    SECTION("Scheme from YAML") {
+        CHECK(YAML::Load("Suzuki").as<Scheme>() == Scheme::Suzuki);
+        CHECK(YAML::Load("Yoshida6").as<Scheme>() == Scheme::Yoshida6);
+        CHECK_THROWS(YAML::Load("Unknown").as<Scheme>());
+    }
+}
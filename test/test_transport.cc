@@ -0,0 +1,121 @@
+#include "catch2/catch.hpp"
+
+#include "Achilles/Random.hh"
+#include "Achilles/Transport.hh"
+
+#include <cmath>
+
+std::vector<achilles::ThreeVector> UniformSphere(size_t npoints, double radius) {
+    std::vector<achilles::ThreeVector> positions;
+    while(positions.size() < npoints) {
+        achilles::ThreeVector position{achilles::Random::Instance().Uniform(-radius, radius),
+                                       achilles::Random::Instance().Uniform(-radius, radius),
+                                       achilles::Random::Instance().Uniform(-radius, radius)};
+        if(position.Magnitude2() < radius*radius) positions.push_back(position);
+    }
+    return positions;
+}
+
+TEST_CASE("Density lattice", "[Transport]") {
+    static constexpr double spacing = 1, size = 10;
+    achilles::DensityLattice lattice(spacing, size);
+    CHECK(lattice.NPoints() == 21);
+    CHECK_THROWS(achilles::DensityLattice(1, 1));
+
+    SECTION("Particles are shared with the neighbouring points") {
+        lattice.Deposit({{0, 0, 0}, {0.5, 0, 0}}, 0.5);
+        CHECK(lattice.Density({0, 0, 0}) == Approx(0.75));
+        CHECK(lattice.Density({1, 0, 0}) == Approx(0.25));
+        CHECK(lattice.Density({0.5, 0, 0}) == Approx(0.5));
+        CHECK(lattice.Density({0, 1, 0}) == 0);
+        // Outside of the lattice
+        CHECK(lattice.Density({0, 0, 20}) == 0);
+    }
+
+    SECTION("The number of nucleons is conserved") {
+        static constexpr size_t npoints = 10000;
+        static constexpr double radius = 5, weight = 0.01;
+        const auto positions = UniformSphere(npoints, radius);
+        lattice.Deposit(positions, weight);
+
+        double sum = 0;
+        for(double x = -size; x <= size; x += spacing)
+            for(double y = -size; y <= size; y += spacing)
+                for(double z = -size; z <= size; z += spacing)
+                    sum += lattice.Density({x, y, z})*std::pow(spacing, 3);
+        CHECK(sum == Approx(npoints*weight));
+
+        const double density = npoints*weight/(4.0/3*M_PI*std::pow(radius, 3));
+        CHECK(lattice.Density({0, 0, 0}) == Approx(density).epsilon(0.3));
+    }
+
+    SECTION("Threads give the same density and forces") {
+        const auto positions = UniformSphere(1000, 5);
+        achilles::DensityLattice threaded(spacing, size, 4);
+        lattice.Deposit(positions, 0.1);
+        threaded.Deposit(positions, 0.1);
+
+        achilles::TransportParams params;
+        auto potential = [&](double rho) { return params.Potential(rho); };
+        lattice.ComputeForces(potential);
+        threaded.ComputeForces(potential);
+        const auto forces = lattice.Forces(positions);
+        const auto threaded_forces = threaded.Forces(positions);
+        for(size_t i = 0; i < positions.size(); ++i) {
+            CHECK(threaded.Density(positions[i]) == Approx(lattice.Density(positions[i])));
+            CHECK((threaded_forces[i] - forces[i]).Magnitude() == Approx(0).margin(1e-10));
+        }
+    }
+
+    SECTION("Each step replaces the density of the previous one") {
+        const auto first = UniformSphere(1000, 5), second = UniformSphere(500, 3);
+        achilles::DensityLattice threaded(spacing, size, 4), fresh(spacing, size);
+        threaded.Deposit(first, 0.1);
+        threaded.Deposit(second, 0.2);
+        fresh.Deposit(second, 0.2);
+
+        // The threads and buffers move with the lattice
+        lattice = std::move(threaded);
+        for(const auto &position : first)
+            CHECK(lattice.Density(position) == Approx(fresh.Density(position)).margin(1e-12));
+        lattice.Deposit(first, 0.1);
+        fresh.Deposit(first, 0.1);
+        for(const auto &position : second)
+            CHECK(lattice.Density(position) == Approx(fresh.Density(position)).margin(1e-12));
+    }
+
+    SECTION("Force from central differences") {
+        static constexpr double weight = 0.5;
+        lattice.Deposit({{0, 0, 0}}, weight);
+        lattice.ComputeForces([](double rho) { return rho; });
+        const auto forces = lattice.Forces({{spacing, 0, 0}, {0, -spacing, 0}, {0, 0, 0}});
+        const double expected = weight/std::pow(spacing, 3)/(2*spacing);
+        CHECK(forces[0][0] == Approx(expected));
+        CHECK(forces[1][1] == Approx(-expected));
+        CHECK(forces[2].Magnitude() == Approx(0).margin(1e-12));
+    }
+}
+
+TEST_CASE("Transport settings", "[Transport]") {
+    YAML::Node node = YAML::Load(R"node(
+    Ensembles: 20
+    Threads: 2
+    Spacing: 0.5
+    Size: 8
+    )node");
+
+    auto params = node.as<achilles::TransportParams>();
+    CHECK(params.Enabled());
+    CHECK(params.ensembles == 20);
+    CHECK(params.threads == 2);
+    CHECK(params.spacing == 0.5);
+    CHECK(params.size == 8);
+    // The mean field is attractive at the saturation density
+    CHECK(params.Potential(0) == 0);
+    CHECK(params.Potential(params.rho0) == Approx(params.alpha + params.beta));
+    CHECK(params.Potential(params.rho0) < 0);
+
+    node["Ensembles"] = 0;
+    CHECK_THROWS(node.as<achilles::TransportParams>());
+    CHECK_FALSE(achilles::TransportParams{}.Enabled());
+}
@@ -0,0 +1,220 @@
+#include "catch2/catch.hpp"
+#include "mock_classes.hh"
+
+#include "Achilles/Unweighter.hh"
+#include "Achilles/Event.hh"
+#include "Achilles/EventWriter.hh"
+#include "Achilles/Particle.hh"
+#include "Achilles/Random.hh"
+
+#include <array>
+#include <sstream>
+
+TEST_CASE("NoUnweighter", "[Unweighter]") {
+    achilles::NoUnweighter unweighter(YAML::Node{});
+    MockEvent event;
+
+    std::vector<double> wgts{1.5, -0.5, 2.0, -1.0};
+    for(auto &wgt : wgts) {
+        REQUIRE_CALL(event, Weight())
+            .LR_RETURN((wgt));
+        CHECK(unweighter.AcceptEvent(event));
+    }
+
+    CHECK(unweighter.Accepted() == 4);
+    CHECK(unweighter.AcceptedNegative() == 2);
+    CHECK(unweighter.Efficiency() == 1.0);
+    CHECK(unweighter.NegativeFraction() == 0.5);
+    CHECK(unweighter.EffectiveEfficiency() == 0.0);
+}
+
+TEST_CASE("PercentileUnweighter", "[Unweighter]") {
+    YAML::Node node = YAML::Load("percentile: 100");
+    achilles::PercentileUnweighter unweighter(node);
+    MockEvent event;
+    const MockEvent &cevent = event;
+
+    // The maximum weight is determined from the absolute value of the weights
+    std::vector<double> train{2.0, -4.0, 1.0};
+    for(const auto &wgt : train) {
+        REQUIRE_CALL(cevent, Weight())
+            .LR_RETURN((wgt));
+        unweighter.AddEvent(event);
+    }
+
+    SECTION("Events keep their sign") {
+        double wgt = GENERATE(-4.0, 4.0);
+        const double expected = wgt;
+        ALLOW_CALL(event, Weight())
+            .LR_RETURN((wgt));
+
+        CHECK(unweighter.AcceptEvent(event));
+        CHECK(wgt == expected);
+        CHECK(unweighter.AcceptedNegative() == (expected < 0 ? 1 : 0));
+    }
+
+    SECTION("Events above the maximum keep their weight") {
+        double wgt = -8.0;
+        ALLOW_CALL(event, Weight())
+            .LR_RETURN((wgt));
+
+        CHECK(unweighter.AcceptEvent(event));
+        CHECK(wgt == -8.0);
+    }
+
+    SECTION("Negative events are accepted with probability |w|/max") {
+        static constexpr size_t ntrials = 10000;
+        size_t naccepted = 0;
+        for(size_t i = 0; i < ntrials; ++i) {
+            double wgt = -1.0;
+            ALLOW_CALL(event, Weight())
+                .LR_RETURN((wgt));
+            if(unweighter.AcceptEvent(event)) {
+                naccepted++;
+                CHECK(wgt == -4.0);
+            } else {
+                CHECK(wgt == 0.0);
+            }
+        }
+        CHECK(unweighter.AcceptedNegative() == naccepted);
+        CHECK(unweighter.Efficiency() == Approx(0.25).margin(0.02));
+    }
+}
+
+TEST_CASE("ExactUnweighter", "[Unweighter]") {
+    achilles::ExactUnweighter unweighter(YAML::Node{});
+    CHECK(unweighter.Deferred());
+
+    auto nucleus = std::make_shared<MockNucleus>();
+    achilles::Particles nucleons;
+    ALLOW_CALL(*nucleus, Nucleons())
+        .LR_RETURN((nucleons));
+
+    auto spill = [&](double wgt, double bias) {
+        achilles::Event event;
+        event.CurrentNucleus() = nucleus;
+        event.Leptons() = {achilles::Particle{achilles::PID::electron(), {1000, 0, 0, 1000}}};
+        event.Weight() = wgt*bias;
+        // Events failing the cuts are never passed to the unweighter
+        if(wgt != 0) unweighter.AcceptEvent(event);
+        event.Weight() = wgt;
+        unweighter.Spill(event, bias);
+    };
+
+    SECTION("Events are written with the exact maximum weight") {
+        std::vector<double> wgts{1.0, -2.0, 0.0, 4.0};
+        for(const auto &wgt : wgts) spill(wgt, 1);
+        CHECK(unweighter.MaxWeight() == 4.0);
+        CHECK(unweighter.Spilled() == wgts.size());
+
+        achilles::BufferWriter writer;
+        unweighter.Flush(writer);
+        CHECK(writer.Trials() == wgts.size());
+        for(const auto &event : writer.Events()) CHECK(std::abs(event.weight) == 4.0);
+        // The event with the maximum weight is always kept
+        CHECK(writer.Events().back().weight == 4.0);
+        CHECK(writer.Particles().back().pid == achilles::PID::electron().AsInt());
+        CHECK(unweighter.Accepted() == writer.Events().size());
+        CHECK(unweighter.Spilled() == 0);
+    }
+
+    SECTION("Events keep their cascade flag") {
+        achilles::Event event;
+        event.CurrentNucleus() = nucleus;
+        event.Leptons() = {achilles::Particle{achilles::PID::electron(), {1000, 0, 0, 1000}}};
+        event.Weight() = 1;
+        event.CascadeFlag() = 3;
+        unweighter.AcceptEvent(event);
+        unweighter.Spill(event, 1);
+
+        std::stringstream ss;
+        achilles::AchillesWriter writer(&ss);
+        unweighter.Flush(writer);
+        CHECK(ss.str().find("CascadeFlag: 3\n") != std::string::npos);
+    }
+
+    SECTION("Unweighting preserves the normalization") {
+        static constexpr size_t ntrials = 100000;
+        double sum{};
+        for(size_t i = 0; i < ntrials; ++i) {
+            const double wgt = achilles::Random::Instance().Uniform(-1.0, 3.0);
+            const double bias = i % 2 == 0 ? 1.0 : 2.0;
+            spill(wgt, bias);
+            sum += wgt;
+        }
+
+        achilles::BufferWriter writer;
+        unweighter.Flush(writer);
+        double unweighted_sum{};
+        for(const auto &event : writer.Events()) unweighted_sum += event.weight;
+        CHECK(writer.Trials() == ntrials);
+        CHECK(unweighted_sum == Approx(sum).epsilon(0.1));
+    }
+
+    SECTION("Realizations of an event are unweighted together") {
+        static constexpr size_t nprimaries = 20000, nrealizations = 4;
+        double sum{};
+        for(size_t i = 0; i < nprimaries; ++i) {
+            const double wgt = achilles::Random::Instance().Uniform(0.0, 2.0);
+            achilles::Event event;
+            event.CurrentNucleus() = nucleus;
+            event.Leptons() = {achilles::Particle{achilles::PID::electron(), {1000, 0, 0, 1000}}};
+            event.Weight() = wgt;
+            unweighter.AcceptEvent(event);
+            for(size_t j = 0; j < nrealizations; ++j) {
+                // The last realization has an aborted cascade
+                event.Weight() = j + 1 == nrealizations ? 0 : wgt/nrealizations;
+                event.SetRealization(i, j, nrealizations);
+                unweighter.Spill(event, 1);
+                sum += event.Weight();
+            }
+        }
+
+        achilles::BufferWriter writer;
+        unweighter.Flush(writer);
+        double unweighted_sum{};
+        for(const auto &event : writer.Events()) {
+            // The accepted weight is shared by the realizations that survived the cascade
+            CHECK(event.weight == Approx(unweighter.MaxWeight()/(nrealizations - 1)));
+            unweighted_sum += event.weight;
+        }
+        CHECK(writer.Trials() == nprimaries);
+        CHECK(writer.Events().size() == (nrealizations - 1)*unweighter.Accepted());
+        CHECK(unweighted_sum == Approx(sum).epsilon(0.1));
+    }
+
+    SECTION("Realizations with different weights keep their distribution") {
+        static constexpr size_t nprimaries = 20000, nrealizations = 2;
+        std::array<double, nrealizations> sum{}, unweighted_sum{};
+        for(size_t i = 0; i < nprimaries; ++i) {
+            const double wgt = achilles::Random::Instance().Uniform(0.0, 2.0);
+            const double bias = i % 2 == 0 ? 1.0 : 2.0;
+            achilles::Event event;
+            event.CurrentNucleus() = nucleus;
+            event.Leptons() = {achilles::Particle{achilles::PID::electron(), {1000, 0, 0, 1000}}};
+            event.Weight() = wgt*bias;
+            unweighter.AcceptEvent(event);
+            // The first realization carries a quarter of the weight of the primary event, and
+            // the realizations are told apart by the energy of the lepton
+            for(size_t j = 0; j < nrealizations; ++j) {
+                const double energy = 1000 + static_cast<double>(j);
+                event.Leptons() = {achilles::Particle{achilles::PID::electron(), {energy, 0, 0, energy}}};
+                event.Weight() = (j == 0 ? 0.25 : 0.75)*wgt;
+                event.SetRealization(i, j, nrealizations);
+                unweighter.Spill(event, bias);
+                sum[j] += event.Weight();
+            }
+        }
+
+        achilles::BufferWriter writer;
+        unweighter.Flush(writer);
+        REQUIRE(writer.Particles().size() == writer.Events().size());
+        for(size_t k = 0; k < writer.Events().size(); ++k) {
+            const auto j = static_cast<size_t>(writer.Particles()[k].E - 1000);
+            unweighted_sum[j] += writer.Events()[k].weight;
+        }
+        CHECK(writer.Trials() == nprimaries);
+        for(size_t j = 0; j < nrealizations; ++j)
+            CHECK(unweighted_sum[j] == Approx(sum[j]).epsilon(0.1));
+    }
+}
@@ -69,6 +69,63 @@ TEST_CASE("Vegas Integration", "[vegas]") {
     }
 }
 
+TEST_CASE("Quasi-random points", "[vegas]") {
+    SECTION("Each replica is stratified in every dimension") {
+        static constexpr size_t dims = 40, npoints = 1024, nreplicas = 2;
+        achilles::QuasiRandom sampling(achilles::QuasiRandom::Type::Sobol, nreplicas);
+        sampling.Start(dims, npoints*nreplicas);
+        CHECK(sampling.Calls() == npoints*nreplicas);
+
+        std::vector<double> point(dims);
+        for(size_t replica = 0; replica < nreplicas; ++replica) {
+            std::vector<std::vector<size_t>> counts(dims, std::vector<size_t>(npoints));
+            for(size_t i = 0; i < npoints; ++i) {
+                sampling.Generate(point);
+                for(size_t j = 0; j < dims; ++j) {
+                    REQUIRE(point[j] > 0);
+                    REQUIRE(point[j] < 1);
+                    counts[j][static_cast<size_t>(point[j]*npoints)]++;
+                }
+            }
+            // Dimensions beyond the direction numbers are pseudo-random
+            for(size_t j = 0; j < achilles::QuasiRandom::MaxDimension(); ++j)
+                CHECK(*std::max_element(counts[j].begin(), counts[j].end()) == 1);
+        }
+    }
+
+    SECTION("Requires replicas for the error estimate") {
+        CHECK_THROWS_WITH(achilles::QuasiRandom(achilles::QuasiRandom::Type::Sobol, 1),
+                          "QuasiRandom: At least two replicas are needed to estimate the error");
+    }
+
+    SECTION("YAML decoding") {
+        auto node = YAML::Load("Points: Sobol\nReplicas: 16");
+        auto sampling = node.as<achilles::QuasiRandom>();
+        CHECK(sampling.GetType() == achilles::QuasiRandom::Type::Sobol);
+        CHECK(sampling.Replicas() == 16);
+        CHECK_THROWS(YAML::Load("Points: Halton").as<achilles::QuasiRandom>());
+    }
+
+    SECTION("Converges faster than pseudo-random points") {
+        static constexpr size_t ncalls = 16384;
+        auto integrate = [](const achilles::QuasiRandom &sampling, const achilles::Func<double> &func) {
+            achilles::AdaptiveMap map(2, 100);
+            achilles::Vegas vegas(map, achilles::VegasParams{ncalls, 20, 1e-4, 1e-4, 1.5, 1});
+            vegas.SetSampling(sampling);
+            vegas.SetVerbosity(0);
+            vegas(func);
+            return vegas.Summary().Result();
+        };
+
+        for(const auto &func : {achilles::Func<double>(test_func), achilles::Func<double>(test_func2)}) {
+            const auto pseudo = integrate(achilles::QuasiRandom(), func);
+            const auto sobol = integrate(achilles::QuasiRandom(achilles::QuasiRandom::Type::Sobol), func);
+            CHECK(std::abs(sobol.Mean() - 1.0) < nsigma*sobol.Error());
+            CHECK(sobol.Error() < 0.05*pseudo.Error());
+        }
+    }
+}
+
 TEST_CASE("YAML encoding / decoding Vegas", "[vegas]") {
     static constexpr size_t nitn_min = 2;
     static constexpr double rtol = 1, atol = 1;